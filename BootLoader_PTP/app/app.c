@@ -26,9 +26,9 @@ static App_state_t g_state = DEFAULT;
 void app_init(void)
 {
     /*
-        * Configure the baud rate here!
+        * Configure the baud rate here! (APP_BAUDRATE)
         */
-    MID_SetDataTransferRate(115200U);
+    MID_SetDataTransferRate(APP_BAUDRATE);
     /* Initialize the S-record parser layer */
     MID_Init();
 
@@ -41,6 +41,8 @@ void app_init(void)
         MID_InitUserApplicationSpace(USER_APPLICATION01_ADDRESS,
                                         USER_APPLICATION01_SIZE_SPACE);
         g_state = CHECK_QUEUE;
+        /* Wait for the host's sync character if the baud rate is measured */
+        (void)MID_DetectDataTransferRate();
         /* Notify the users that the boost loader process is ready.
             * Users can start uploading their files */
         UI_informStarting();
@@ -50,7 +52,7 @@ void app_init(void)
     {
         MID_DeInit();
         /* If the switch isn't pressed, immediately jump to user's application */
-        MID_jumpApplication(USER_APPLICATION01_ADDRESS);
+        MID_jumpApplication(USER_APPLICATION01_ADDRESS, 0U);
     }
 }
 
@@ -61,11 +63,14 @@ void app_process_action(void)
     static uint8_t       checkEmpty         = FALSE;
     static uint8_t       checkOverLoad      = FALSE;
     static uint8_t       isTerminationExist = FALSE;
-    static uint8_t       *p_LineSrec        = NULL;
+    static const Srec_Record_t *p_Record    = NULL;
+    uint32_t             entryPoint         = 0U;
 
     switch (g_state)
     {
         case CHECK_QUEUE:
+            /* Bring in what a polled transport has received */
+            MID_PollData();
             /* Check if there is data in the Queue */
             checkEmpty = MID_QueueIsEmpty();
             if (FALSE == checkEmpty)
@@ -91,11 +96,11 @@ void app_process_action(void)
 
         case PASER_RECORD:
             /* Retrieve the next record from the queue (not remove it from queue) */
-            p_LineSrec = (uint8_t*)MID_peekQueue();
-            /* Parse the retrieved record */
-            statusRecord = MID_Parse_Record(p_LineSrec);
-            /* Check if the termination record exists */
-            isTerminationExist = SREC_TerminationIsExist();
+            p_Record = MID_peekQueue();
+            /* The record was validated and decoded while it was being received */
+            statusRecord = MID_Parse_Record(p_Record);
+            /* Check if the record is the termination record */
+            isTerminationExist = SREC_IsTermination(p_Record);
             /* If the record has no errors and is a data record, proceed to write
                 * the content to the corresponding address in flash memory */
             if ((SREC_OK == statusRecord) && (FALSE == isTerminationExist))
@@ -104,7 +109,7 @@ void app_process_action(void)
             }
             /* If a terminal record indicating the end of the file is encountered,
                 * proceed to jump to the user's application */
-            else if (TRUE == isTerminationExist)
+            else if ((SREC_OK == statusRecord) && (TRUE == isTerminationExist))
             {
                 g_state = JUMP_USER_APP;
             }
@@ -117,31 +122,51 @@ void app_process_action(void)
 
         case WRITE_FLASH:
             /* Write the content to the corresponding address in flash memory */
-            MID_Write_dataRecord(p_LineSrec);
-            /* Remove the record that was just written to flash from the circular queue */
-            MID_deQueue();
-            /* Continue checking the queue */
-            g_state = CHECK_QUEUE;
+            if (0U == MID_Write_dataRecord(p_Record))
+            {
+                /* Give the slot of the record that was just written to flash back to the receiver */
+                MID_deQueue();
+                /* Continue checking the queue */
+                g_state = CHECK_QUEUE;
+            }
+            /* If the record falls outside of the application space or overwrites data of the image,
+                * proceed to error notification and terminate the boost process */
+            else
+            {
+                g_state = ERROR;
+            }
             break;
 
         case JUMP_USER_APP:
-            /* De-initialize the S-record parse layer */
-            MID_DeInit();
             /* Inform the boost process is successful */
             UI_informSucess();
-            while(MID_switchIsPressed())
+            while((MID_switchIsPressed()) && (FALSE == MID_jumpRequested()))
             {
-                /* Wait for the user to press the switch to enter the user's application */
+                /* Wait for the user to press the switch, or the host to send the jump command,
+                 * to enter the user's application */
             }
-            /* Jump to the user's application */
-            MID_jumpApplication(USER_APPLICATION01_ADDRESS);
+            /* De-initialize the S-record parse layer, once the message has been sent */
+            MID_DeInit();
+            /* Jump to the user's application, at the start address given by its Termination record
+             * when that address lies inside the application space */
+            entryPoint = MID_getEntryPoint();
+            if ((entryPoint < USER_APPLICATION01_ADDRESS)
+                    || (entryPoint >= (USER_APPLICATION01_ADDRESS + (USER_APPLICATION01_SIZE_SPACE * 1024U))))
+            {
+                entryPoint = 0U;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            MID_jumpApplication(USER_APPLICATION01_ADDRESS, entryPoint);
             break;
 
         case ERROR:
-            /* De-initialize the S-record parse layer */
-            MID_DeInit();
             /* Send "Error" message */
             UI_informError();
+            /* De-initialize the S-record parse layer, once the message has been sent */
+            MID_DeInit();
             while(MID_switchIsPressed())
             {
                 /* Wait for the user to press the switch to enter the previous user's application */
@@ -23,6 +23,10 @@
 #define BACKUP_APPLICATION_ADDRESS       0xC000U
 #define USER_APPLICATION01_SIZE_SPACE    4U       /* 4kB */
 
+#ifndef APP_BAUDRATE
+#define APP_BAUDRATE                     115200U  /* Fixed baud rate, MID_BAUDRATE_AUTO to measure it on the host's sync character */
+#endif
+
 /*******************************************************************************
  * Typedef enums
  ******************************************************************************/
@@ -0,0 +1,106 @@
+/*
+ * dri_lpi2c.c
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_lpi2c.h"
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Base pointer and PCC clock of every LPI2C, indexed by instance */
+static LPI2C_Type *const s_lpi2cBases[] = LPI2C_BASE_PTRS;
+static const uint32_t    s_lpi2cClocks[] = { PCC_LPI2C0_INDEX };
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Get the instance number of an LPI2C
+ */
+uint32_t DRI_LPI2C_GetInstance(const LPI2C_Type *const LPI2Cx)
+{
+    uint32_t instance = 0U;
+
+    while ((instance < FSL_FEATURE_SOC_LPI2C_COUNT) && (s_lpi2cBases[instance] != LPI2Cx))
+    {
+        instance++;
+    }
+
+    return instance;
+}
+
+
+/*
+ * @brief: Initialize an LPI2C peripheral as a slave
+ */
+void DRI_LPI2C_SlaveInit(LPI2C_Type *const LPI2Cx, const LPI2C_SlaveInitTypeDef *const LPI2C_Init)
+{
+    uint32_t instance = DRI_LPI2C_GetInstance(LPI2Cx);
+
+    if (instance < FSL_FEATURE_SOC_LPI2C_COUNT)
+    {
+        /* Select clock source for the LPI2C: FIRCDIV2_CLK */
+        DRI_CLOCK_SelectSource(s_lpi2cClocks[instance], CLOCK_SrcFircAsync);
+        /* Enable the interface clock for the LPI2C peripheral */
+        DRI_CLOCK_EnableClock(s_lpi2cClocks[instance]);
+
+        /* Start from the reset values of the slave */
+        LPI2C_SlaveReset(LPI2Cx);
+
+        /* 7-bit address match on ADDR0 */
+        LPI2Cx->SAMR = LPI2C_SAMR_ADDR0(LPI2C_Init->Address);
+
+        /* Configure clock stretching, TDF only asserts during a slave-transmit transfer */
+        LPI2Cx->SCFGR1 = LPI2C_SCFGR1_ADRSTALL(LPI2C_Init->AddressStall ? 1U : 0U)
+                | LPI2C_SCFGR1_RXSTALL(LPI2C_Init->ReceiveStall ? 1U : 0U)
+                | LPI2C_SCFGR1_TXDSTALL(LPI2C_Init->TransmitStall ? 1U : 0U)
+                | LPI2C_SCFGR1_ADDRCFG(0U);
+
+        /* Configure timing and glitch filters */
+        LPI2Cx->SCFGR2 = LPI2C_SCFGR2_CLKHOLD(LPI2C_Init->ClockHold)
+                | LPI2C_SCFGR2_DATAVD(LPI2C_Init->DataValidDelay)
+                | LPI2C_SCFGR2_FILTSCL(LPI2C_Init->GlitchFilter)
+                | LPI2C_SCFGR2_FILTSDA(LPI2C_Init->GlitchFilter);
+
+        /* Enable the filters and the slave */
+        LPI2Cx->SCR = LPI2C_SCR_FILTEN_MASK;
+        LPI2C_SlaveEnable(LPI2Cx, TRUE);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Stop an LPI2C slave and gate its clock
+ */
+void DRI_LPI2C_SlaveDeInit(LPI2C_Type *const LPI2Cx)
+{
+    uint32_t instance = DRI_LPI2C_GetInstance(LPI2Cx);
+
+    if (instance < FSL_FEATURE_SOC_LPI2C_COUNT)
+    {
+        LPI2Cx->SIER = 0U;
+        LPI2C_SlaveReset(LPI2Cx);
+        DRI_CLOCK_DisableClock(s_lpi2cClocks[instance]);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,69 @@
+/*
+ * dri_lpi2c.h
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_LPI2C_H_
+#define _INC_DRI_LPI2C_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "fsl_device_registers.h"
+#include "lpi2c.h"
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief LPI2C slave Init Structure definition
+ */
+typedef struct
+{
+    uint8_t  Address;          /* 7-bit address the slave answers to */
+    uint8_t  AddressStall;     /* TRUE to hold SCL low after the address until it is read */
+    uint8_t  ReceiveStall;     /* TRUE to hold SCL low while a received byte is not read */
+    uint8_t  TransmitStall;    /* TRUE to hold SCL low while no byte to send is written */
+    uint8_t  ClockHold;        /* Minimum SCL low time after a stall, in functional clock cycles */
+    uint8_t  DataValidDelay;   /* SDA set-up after the SCL falling edge, in functional clock cycles */
+    uint8_t  GlitchFilter;     /* Glitches on SCL and SDA up to this many functional clock cycles are ignored */
+} LPI2C_SlaveInitTypeDef;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Get the instance number of an LPI2C, the index of its interrupt handler and clock
+ * @param[in] LPI2Cx: LPI2C base pointer
+ * @return: 0 for LPI2C0, FSL_FEATURE_SOC_LPI2C_COUNT if LPI2Cx is not an LPI2C
+ */
+uint32_t DRI_LPI2C_GetInstance(const LPI2C_Type *const LPI2Cx);
+
+
+/*
+ * @brief: Initialize an LPI2C peripheral as a slave with the provided configuration.
+ *         Its functional clock is FIRCDIV2_CLK, the pins are muxed by the caller
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @param[in]  LPI2C_Init: Pointer to a structure containing the initialization parameters
+ * @return: None
+ * @note: The interrupts are left disabled
+ */
+void DRI_LPI2C_SlaveInit(LPI2C_Type *const LPI2Cx, const LPI2C_SlaveInitTypeDef *const LPI2C_Init);
+
+
+/*
+ * @brief: Stop an LPI2C slave and gate its clock
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @return: None
+ */
+void DRI_LPI2C_SlaveDeInit(LPI2C_Type *const LPI2Cx);
+
+#endif /* _INC_DRI_LPI2C_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
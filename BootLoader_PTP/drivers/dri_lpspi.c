@@ -0,0 +1,105 @@
+/*
+ * dri_lpspi.c
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_lpspi.h"
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Base pointer and PCC clock of every LPSPI, indexed by instance */
+static LPSPI_Type *const s_lpspiBases[] = LPSPI_BASE_PTRS;
+static const uint32_t    s_lpspiClocks[] = { PCC_LPSPI0_INDEX };
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Get the instance number of an LPSPI
+ */
+uint32_t DRI_LPSPI_GetInstance(const LPSPI_Type *const LPSPIx)
+{
+    uint32_t instance = 0U;
+
+    while ((instance < FSL_FEATURE_SOC_LPSPI_COUNT) && (s_lpspiBases[instance] != LPSPIx))
+    {
+        instance++;
+    }
+
+    return instance;
+}
+
+
+/*
+ * @brief: Initialize an LPSPI peripheral as a slave
+ */
+void DRI_LPSPI_SlaveInit(LPSPI_Type *const LPSPIx, const LPSPI_SlaveInitTypeDef *const LPSPI_Init)
+{
+    uint32_t instance = DRI_LPSPI_GetInstance(LPSPIx);
+
+    if (instance < FSL_FEATURE_SOC_LPSPI_COUNT)
+    {
+        /* Select clock source for the LPSPI: FIRCDIV2_CLK */
+        DRI_CLOCK_SelectSource(s_lpspiClocks[instance], CLOCK_SrcFircAsync);
+        /* Enable the interface clock for the LPSPI peripheral */
+        DRI_CLOCK_EnableClock(s_lpspiClocks[instance]);
+
+        /* Start from the reset values, with both FIFOs empty */
+        LPSPI_SoftwareReset(LPSPIx);
+
+        /* Slave mode, active low PCS, SIN is the input and SOUT the output */
+        LPSPIx->CFGR1 = LPSPI_CFGR1_MASTER(0U) | LPSPI_CFGR1_PCSPOL(0U) | LPSPI_CFGR1_PINCFG(0U);
+
+        /* Configure receive and transmit FIFO watermarks */
+        LPSPI_SetWatermarks(LPSPIx, LPSPI_Init->RxWatermark, LPSPI_Init->TxWatermark);
+
+        /* Configure the frame: clock polarity and phase, bit order, size and chip select */
+        LPSPIx->TCR = LPSPI_TCR_CPOL(LPSPI_Init->ClockPolarity)
+                | LPSPI_TCR_CPHA(LPSPI_Init->ClockPhase)
+                | LPSPI_TCR_LSBF(LPSPI_Init->LSBFirst ? 1U : 0U)
+                | LPSPI_TCR_PCS(LPSPI_Init->ChipSelect)
+                | LPSPI_TCR_FRAMESZ((uint32_t)LPSPI_Init->FrameSize - 1U);
+
+        /* Clear the flags left from before and enable the module */
+        LPSPI_ClearStatusFlags(LPSPIx, LPSPI_SR_WCF_MASK | LPSPI_SR_FCF_MASK | LPSPI_SR_TCF_MASK
+                | LPSPI_SR_TEF_MASK | LPSPI_SR_REF_MASK | LPSPI_SR_DMF_MASK);
+        LPSPI_Enable(LPSPIx, TRUE);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Stop an LPSPI peripheral and gate its clock
+ */
+void DRI_LPSPI_DeInit(LPSPI_Type *const LPSPIx)
+{
+    uint32_t instance = DRI_LPSPI_GetInstance(LPSPIx);
+
+    if (instance < FSL_FEATURE_SOC_LPSPI_COUNT)
+    {
+        LPSPIx->IER = 0U;
+        LPSPI_SoftwareReset(LPSPIx);
+        DRI_CLOCK_DisableClock(s_lpspiClocks[instance]);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
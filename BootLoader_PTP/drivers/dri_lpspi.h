@@ -0,0 +1,69 @@
+/*
+ * dri_lpspi.h
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_LPSPI_H_
+#define _INC_DRI_LPSPI_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "fsl_device_registers.h"
+#include "lpspi.h"
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief LPSPI slave Init Structure definition
+ */
+typedef struct
+{
+    LPSPI_Clock_Polarity_t ClockPolarity;
+    LPSPI_Clock_Phase_t    ClockPhase;
+    uint8_t                FrameSize;      /* Bits in a frame, 8 to 4096 */
+    uint8_t                ChipSelect;     /* PCS input the master selects the slave with */
+    uint8_t                LSBFirst;
+    uint8_t                RxWatermark;    /* RDF is set when the receive FIFO holds more words */
+    uint8_t                TxWatermark;    /* TDF is set when the transmit FIFO holds this many words or less */
+} LPSPI_SlaveInitTypeDef;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Get the instance number of an LPSPI, the index of its interrupt handler and clock
+ * @param[in] LPSPIx: LPSPI base pointer
+ * @return: 0 for LPSPI0, FSL_FEATURE_SOC_LPSPI_COUNT if LPSPIx is not an LPSPI
+ */
+uint32_t DRI_LPSPI_GetInstance(const LPSPI_Type *const LPSPIx);
+
+
+/*
+ * @brief: Initialize an LPSPI peripheral as a slave with the provided configuration.
+ *         Its functional clock is FIRCDIV2_CLK, the pins are muxed by the caller
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  LPSPI_Init: Pointer to a structure containing the initialization parameters
+ * @return: None
+ * @note: The FIFOs are flushed, the interrupts are left disabled
+ */
+void DRI_LPSPI_SlaveInit(LPSPI_Type *const LPSPIx, const LPSPI_SlaveInitTypeDef *const LPSPI_Init);
+
+
+/*
+ * @brief: Stop an LPSPI peripheral and gate its clock
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @return: None
+ */
+void DRI_LPSPI_DeInit(LPSPI_Type *const LPSPIx);
+
+#endif /* _INC_DRI_LPSPI_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
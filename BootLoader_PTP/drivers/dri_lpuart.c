@@ -11,6 +11,50 @@
  ******************************************************************************/
 #include "dri_lpuart.h"
 
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DRI_LPUART_OSR_MIN       4U      /* Smallest OSR field value searched (ratio of 5) */
+#define DRI_LPUART_OSR_MAX       32U     /* Largest OSR field value searched */
+#define DRI_LPUART_SBR_MAX       8191U   /* Largest value of the 13-bit SBR field */
+#define DRI_LPUART_TABLE_CLOCK   48000000U  /* FIRCDIV2_CLK the baud rate table was computed for */
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Precomputed divisors of a baud rate
+ */
+typedef struct
+{
+    uint32_t baudrate;
+    uint8_t  osr;
+    uint16_t sbr;
+} DRI_LPUART_Baud_t;
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Base pointer and PCC clock of every LPUART, indexed by instance */
+static LPUART_Type *const s_lpuartBases[] = LPUART_BASE_PTRS;
+static const uint32_t     s_lpuartClocks[] = { PCC_LPUART0_INDEX, PCC_LPUART1_INDEX, PCC_LPUART2_INDEX };
+
+/* Result of DRI_LPUART_Calculate_OSR_SBR for the common baud rates at DRI_LPUART_TABLE_CLOCK */
+static const DRI_LPUART_Baud_t s_baudTable[] =
+{
+    {   9600U,  4U, 1000U},
+    {  19200U,  4U,  500U},
+    {  38400U,  4U,  250U},
+    {  57600U,  6U,  119U},
+    { 115200U,  7U,   52U},
+    { 230400U,  7U,   26U},
+    { 460800U,  7U,   13U},
+    { 921600U, 12U,    4U},
+    {1000000U,  5U,    8U},
+};
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -53,7 +97,7 @@ void DRI_LPUART_SetBaudRate(LPUART_Type *const LPUARTx, const uint32_t desiredBa
         }
         else
         {
-            /* Do Nothing */
+            LPUART_DisableBothEdgeSampling(LPUARTx);
         }
         LPUART_SetOversamplingRatio(LPUARTx, BAUD_OSR);
         LPUART_SetBaudRateDivisor(LPUARTx, BAUD_SBN);
@@ -66,41 +110,138 @@ void DRI_LPUART_SetBaudRate(LPUART_Type *const LPUARTx, const uint32_t desiredBa
 
 
 /*
- * @brief: Initialize the LPUART0 peripheral with the provided configuration
+ * @brief: Get the instance number of an LPUART
  */
-void DRI_LPUART0_Init(const LPUART_InitTypeDef *const LPUART_Init)
+uint32_t DRI_LPUART_GetInstance(const LPUART_Type *const LPUARTx)
 {
-    /* Select clock source for LPUART0: FIRCDIV2_CLK */
-    DRI_CLOCK_SelectSource(PCC_LPUART0_INDEX, CLOCK_SrcFircAsync);
-    /* Enable the interface clock for the LPUART0 peripheral */
-    DRI_CLOCK_EnableClock(PCC_LPUART0_INDEX);
+    uint32_t instance = 0U;
 
-    /* Disable LPUART TX RX before setting */
-    LPUART_Transmit_Enable(LPUART0, FALSE);
-    LPUART_Receive_Enable(LPUART0, FALSE);
+    while ((instance < FSL_FEATURE_SOC_LPUART_COUNT) && (s_lpuartBases[instance] != LPUARTx))
+    {
+        instance++;
+    }
+
+    return instance;
+}
 
-    /* Configure number of bits data */
-    LPUART_SetBitMode(LPUART0, LPUART_Init->Mode);
 
-    /* Configure Parity and Parity type */
-    LPUART_SetParity(LPUART0, LPUART_Init->Parity);
+/*
+ * @brief: Initialize an LPUART peripheral with the provided configuration
+ */
+void DRI_LPUART_Init(LPUART_Type *const LPUARTx, const LPUART_InitTypeDef *const LPUART_Init)
+{
+    uint32_t instance = DRI_LPUART_GetInstance(LPUARTx);
+
+    if (instance < FSL_FEATURE_SOC_LPUART_COUNT)
+    {
+        /* Select clock source for the LPUART: FIRCDIV2_CLK */
+        DRI_CLOCK_SelectSource(s_lpuartClocks[instance], CLOCK_SrcFircAsync);
+        /* Enable the interface clock for the LPUART peripheral */
+        DRI_CLOCK_EnableClock(s_lpuartClocks[instance]);
+
+        /* Disable LPUART TX RX before setting */
+        LPUART_Transmit_Enable(LPUARTx, FALSE);
+        LPUART_Receive_Enable(LPUARTx, FALSE);
 
-    /* Configure transmit LSB or MSB first */
-    LPUART_SetMSBfirst(LPUART0, LPUART_Init->MSBFirst);
+        /* Configure number of bits data */
+        LPUART_SetBitMode(LPUARTx, LPUART_Init->Mode);
 
-    /* Configure Data Inversion */
-    LPUART_SetReceiveDataInvert(LPUART0, LPUART_Init->ReceiveInverted);
-    LPUART_SetTranmitDataInvert(LPUART0, LPUART_Init->TransmitInverted);
+        /* Configure Parity and Parity type */
+        LPUART_SetParity(LPUARTx, LPUART_Init->Parity);
 
-    /* Configure stop bit */
-    LPUART_SetStopBit(LPUART0, LPUART_Init->StopBit);
+        /* Configure transmit LSB or MSB first */
+        LPUART_SetMSBfirst(LPUARTx, LPUART_Init->MSBFirst);
 
-    /* Configure BaudRate */
-    DRI_LPUART_SetBaudRate(LPUART0, LPUART_Init->BaudRate);
+        /* Configure Data Inversion */
+        LPUART_SetReceiveDataInvert(LPUARTx, LPUART_Init->ReceiveInverted);
+        LPUART_SetTranmitDataInvert(LPUARTx, LPUART_Init->TransmitInverted);
 
-    /* Enable the Receiver and Transmitter */
-    LPUART_Transmit_Enable(LPUART0, TRUE);
-    LPUART_Receive_Enable(LPUART0, TRUE);
+        /* Configure stop bit */
+        LPUART_SetStopBit(LPUARTx, LPUART_Init->StopBit);
+
+        /* Configure RTS/CTS */
+        LPUART_SetHardwareFlowControl(LPUARTx, LPUART_Init->HardwareFlowControl, LPUART_Init->RTSWatermark);
+
+        /* Configure receive FIFO, watermark and idle line detection */
+        LPUART_SetReceiveFifo(LPUARTx, LPUART_Init->ReceiveFifo);
+        LPUART_SetReceiveWatermark(LPUARTx, LPUART_Init->RxWatermark);
+        LPUART_SetIdleConfig(LPUARTx, LPUART_Init->IdleConfig);
+
+        /* Configure transmit FIFO and watermark */
+        LPUART_SetTransmitFifo(LPUARTx, LPUART_Init->TransmitFifo);
+        LPUART_SetTransmitWatermark(LPUARTx, LPUART_Init->TxWatermark);
+
+        /* Configure BaudRate */
+        DRI_LPUART_SetBaudRate(LPUARTx, LPUART_Init->BaudRate);
+
+        /* Enable the Receiver and Transmitter */
+        LPUART_Transmit_Enable(LPUARTx, TRUE);
+        LPUART_Receive_Enable(LPUARTx, TRUE);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Get the baud rate the LPUART actually runs at for a desired baud rate
+ */
+uint32_t DRI_LPUART_GetBaudRate(const uint32_t desiredBaudRate)
+{
+    uint8_t  BAUD_OSR  = 0U;
+    uint32_t BAUD_SBN  = 0U;
+    uint32_t frequency = DRI_CLOCK_SYS_Get_FIRCDIV2_CLK();
+    uint32_t baudrate  = 0U;
+
+    if (0U != desiredBaudRate)
+    {
+        DRI_LPUART_Calculate_OSR_SBR(desiredBaudRate, frequency, &BAUD_OSR, &BAUD_SBN);
+        if (0U != BAUD_SBN)
+        {
+            baudrate = frequency / ((BAUD_OSR + 1U) * BAUD_SBN);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return baudrate;
+}
+
+
+/*
+ * @brief: Change the baud rate of an LPUART that is already running
+ */
+void DRI_LPUART_ChangeBaudRate(LPUART_Type *const LPUARTx, const uint32_t desiredBaudRate)
+{
+    if (LPUARTx != NULL)
+    {
+        /* BAUD may only be written while the transmitter and receiver are disabled */
+        LPUART_Transmit_Enable(LPUARTx, FALSE);
+        LPUART_Receive_Enable(LPUARTx, FALSE);
+
+        DRI_LPUART_SetBaudRate(LPUARTx, desiredBaudRate);
+
+        /* Drop whatever was received at the previous baud rate */
+        LPUART_SetReceiveFifo(LPUARTx, (0U != (LPUARTx->FIFO & LPUART_FIFO_RXFE_MASK)) ? TRUE : FALSE);
+        LPUART_ClearStatusFlags(LPUARTx, LPUART_STAT_IDLE_MASK | LPUART_STAT_OR_MASK
+                                         | LPUART_STAT_NF_MASK | LPUART_STAT_FE_MASK
+                                         | LPUART_STAT_PF_MASK);
+
+        LPUART_Transmit_Enable(LPUARTx, TRUE);
+        LPUART_Receive_Enable(LPUARTx, TRUE);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
 }
 
 
@@ -129,43 +270,273 @@ void DRI_LPUART_TranmitData(LPUART_Type *const LPUARTx,
 }
 
 
+/*
+ * @brief: Enable and disable LPUART interrupts from any context
+ */
+void DRI_LPUART_SetInterrupts(LPUART_Type *const LPUARTx,
+        const uint32_t enableMask, const uint32_t disableMask)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    LPUARTx->CTRL = (LPUARTx->CTRL & ~disableMask) | enableMask;
+    __set_PRIMASK(primask);
+}
+
+
+/*
+ * @brief: Copy data into the transmit ring and start the transmit interrupt, without waiting
+ */
+uint32_t DRI_LPUART_TransmitAsync(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring,
+        const uint8_t *const Data, const uint32_t size)
+{
+    uint32_t index = 0U;
+    uint16_t head  = 0U;
+
+    if ((LPUARTx != NULL) && (ring != NULL) && (Data != NULL))
+    {
+        head = ring->head;
+        while ((index < size) && ((uint16_t)(head - ring->tail) <= ring->mask))
+        {
+            ring->buffer[head & ring->mask] = Data[index];
+            ++head;
+            ++index;
+        }
+
+        if (0U != index)
+        {
+            /* Make the characters visible before the interrupt can see the new head */
+            __DMB();
+            ring->head = head;
+            DRI_LPUART_SetInterrupts(LPUARTx, LPUART_CTRL_TIE_MASK, 0U);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return index;
+}
+
+
+/*
+ * @brief: Get the number of characters the transmit ring can still take
+ */
+uint32_t DRI_LPUART_TransmitFree(const LPUART_TxRing_t *const ring)
+{
+    return (uint32_t)ring->mask + 1U - (uint16_t)(ring->head - ring->tail);
+}
+
+
+/*
+ * @brief: Send a character ahead of everything waiting in the transmit ring
+ */
+void DRI_LPUART_TransmitPriority(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring,
+        const uint8_t character)
+{
+    if ((LPUARTx != NULL) && (ring != NULL))
+    {
+        ring->priority = character;
+        DRI_LPUART_SetInterrupts(LPUARTx, LPUART_CTRL_TIE_MASK, 0U);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Check if characters are still waiting or being shifted out
+ */
+uint8_t DRI_LPUART_TransmitBusy(const LPUART_Type *const LPUARTx, const LPUART_TxRing_t *const ring)
+{
+    uint8_t busy = FALSE;
+
+    if ((ring->head != ring->tail) || (0U != ring->priority)
+            || (0U == (LPUARTx->STAT & LPUART_STAT_TC_MASK)))
+    {
+        busy = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return busy;
+}
+
+
+/*
+ * @brief: Transmit part of the LPUART interrupt handler
+ */
+void DRI_LPUART_TransmitIRQHandler(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring)
+{
+    uint32_t ctrl = LPUARTx->CTRL;
+    uint16_t tail = ring->tail;
+
+    if ((0U != (ctrl & LPUART_CTRL_TIE_MASK)) && (0U != (LPUARTx->STAT & LPUART_STAT_TDRE_MASK)))
+    {
+        /* Fill every free entry of the FIFO, the XON/XOFF character first */
+        while ((LPUART_GetTransmitCount(LPUARTx) < DRI_LPUART_FIFO_SIZE)
+                && ((0U != ring->priority) || (tail != ring->head)))
+        {
+            if (0U != ring->priority)
+            {
+                LPUART_TransmitByte(LPUARTx, ring->priority);
+                ring->priority = 0U;
+            }
+            else
+            {
+                LPUART_TransmitByte(LPUARTx, ring->buffer[tail & ring->mask]);
+                ++tail;
+            }
+        }
+        ring->tail = tail;
+
+        /* Everything is in the FIFO: wait for the last character to leave the line */
+        if ((tail == ring->head) && (0U == ring->priority))
+        {
+            LPUARTx->CTRL = (LPUARTx->CTRL & ~LPUART_CTRL_TIE_MASK) | LPUART_CTRL_TCIE_MASK;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else if ((0U != (ctrl & LPUART_CTRL_TCIE_MASK)) && (0U != (LPUARTx->STAT & LPUART_STAT_TC_MASK)))
+    {
+        LPUART_DisableInterrupts(LPUARTx, LPUART_CTRL_TCIE_MASK);
+        if (NULL != ring->callback)
+        {
+            ring->callback();
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
 /*
  * @brief: Calculate the optimal over-sampling ratio (OSR) and sampling bit rate (SBR)
- *         for a given baud rate and clock frequency
+ *         for a given baud rate and clock frequency.
+ *         For each OSR, the divided clock q = clock / (OSR + 1) gives the baud rate
+ *         q / SBR, which decreases as SBR grows. s0 = q / baudrate is the largest SBR
+ *         not below the target and s0 + 1 the first one below it, so these two are the
+ *         only candidates. The result is the same as an exhaustive search of every
+ *         (OSR, SBR) pair, keeping the first smallest error
  */
 static void DRI_LPUART_Calculate_OSR_SBR(const uint32_t baudrate,
         const uint32_t clock, uint8_t *const osr, uint32_t *const sbr)
 {
+    uint32_t index               = 0U;
     uint32_t osr_candidate       = 0U;
     uint32_t sbr_candidate       = 0U;
+    uint32_t divided_clock       = 0U;
     uint32_t calculated_baudrate = 0U;
     uint32_t error               = 0U;
     uint32_t min_error           = 0U;
+    uint8_t  found               = FALSE;
+
+    if (DRI_LPUART_TABLE_CLOCK == clock)
+    {
+        for (index = 0U; index < (sizeof(s_baudTable) / sizeof(s_baudTable[0U])); ++index)
+        {
+            if (s_baudTable[index].baudrate == baudrate)
+            {
+                *osr  = s_baudTable[index].osr;
+                *sbr  = s_baudTable[index].sbr;
+                found = TRUE;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
 
     min_error = baudrate; /* Set min_error greater than baud rate to ensure finding the exact result */
 
-    for (osr_candidate = 4U; osr_candidate <= 32U; ++osr_candidate)
+    for (osr_candidate = DRI_LPUART_OSR_MIN;
+            (FALSE == found) && (osr_candidate <= DRI_LPUART_OSR_MAX); ++osr_candidate)
     {
-        for (sbr_candidate = 1U; sbr_candidate <= 8191U; ++sbr_candidate)
+        divided_clock = clock / (osr_candidate + 1U);
+        sbr_candidate = divided_clock / baudrate;
+        if (sbr_candidate > DRI_LPUART_SBR_MAX)
         {
-            calculated_baudrate = clock / ((osr_candidate + 1U) * sbr_candidate);
-            error = baudrate - calculated_baudrate;
+            sbr_candidate = DRI_LPUART_SBR_MAX;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
 
-            if (error == 0U)
+        /* Closest baud rate at or above the target */
+        if (0U != sbr_candidate)
+        {
+            calculated_baudrate = divided_clock / sbr_candidate;
+            error = calculated_baudrate - baudrate;
+            if (error < min_error)
             {
-                /* If a pair (OSR, SBR) is exactly 100%, return immediately */
+                min_error = error;
                 *osr = osr_candidate;
-                *sbr = sbr_candidate;
-                return;
+                /* Smaller SBR values may give the same baud rate, the smallest one is kept */
+                if ((sbr_candidate > 1U)
+                        && (divided_clock < ((calculated_baudrate + 1U) * (sbr_candidate - 1U))))
+                {
+                    *sbr = (divided_clock / (calculated_baudrate + 1U)) + 1U;
+                }
+                else
+                {
+                    *sbr = sbr_candidate;
+                }
+                /* If a pair (OSR, SBR) is exactly 100%, stop immediately */
+                found = (0U == error) ? TRUE : FALSE;
+            }
+            else
+            {
+                /* Do Nothing */
             }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
 
-            /* If this error is less than the previous error update the result */
-            if (abs(error) < min_error)
+        /* Closest baud rate below the target */
+        if ((FALSE == found) && (sbr_candidate < DRI_LPUART_SBR_MAX))
+        {
+            calculated_baudrate = divided_clock / (sbr_candidate + 1U);
+            error = baudrate - calculated_baudrate;
+            if (error < min_error)
             {
-                min_error = abs(error);
+                min_error = error;
                 *osr = osr_candidate;
-                *sbr = sbr_candidate;
+                *sbr = sbr_candidate + 1U;
             }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
         }
     }
 }
@@ -12,8 +12,19 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include "fsl_device_registers.h"
 #include "lpuart.h"
 
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DRI_LPUART_FIFO_SIZE   FSL_FEATURE_LPUART_FIFO_SIZEn(LPUART0)  /* Entries of the receive and transmit FIFOs */
+
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef void (*LPUART_TxCallback_t)(void);
+
 /*******************************************************************************
  * Typedef structs
  ******************************************************************************/
@@ -31,8 +42,30 @@ typedef struct
     uint8_t            MSBFirst;
     uint8_t            ReceiveInverted;
     uint8_t            TransmitInverted;
+    uint8_t            HardwareFlowControl;  /* TRUE to drive RTS from the receiver and gate the transmitter with CTS */
+    uint8_t            RTSWatermark;         /* RTS is negated when the receive FIFO holds more characters */
+    uint8_t            ReceiveFifo;          /* TRUE to buffer received characters in the FIFO */
+    uint8_t            RxWatermark;          /* RDRF is set when the receive FIFO holds more characters */
+    uint8_t            IdleConfig;           /* IDLE is set after 2^IdleConfig idle characters */
+    uint8_t            TransmitFifo;         /* TRUE to queue characters to send in the FIFO */
+    uint8_t            TxWatermark;          /* TDRE is set when the transmit FIFO holds this many characters or less */
 } LPUART_InitTypeDef;
 
+
+/*
+ * @brief Ring of characters waiting to be sent by the transmit interrupt.
+ *        The caller only moves head and the interrupt only moves tail
+ */
+typedef struct
+{
+    uint8_t             *buffer;    /* Storage of the ring, its size is a power of two */
+    uint16_t            mask;       /* Size of the storage - 1 */
+    volatile uint16_t   head;       /* Free-running index of the next character written by the caller */
+    volatile uint16_t   tail;       /* Free-running index of the next character sent by the interrupt */
+    volatile uint8_t    priority;   /* Character sent ahead of the ring (XON/XOFF), 0 if none */
+    LPUART_TxCallback_t callback;   /* Called from the interrupt once the last character has left the line */
+} LPUART_TxRing_t;
+
 /*******************************************************************************
  * APIs
  ******************************************************************************/
@@ -47,11 +80,41 @@ void DRI_LPUART_SetBaudRate(LPUART_Type *LPUARTx, const uint32_t desiredBaudRate
 
 
 /*
- * @brief: Initialize the LPUART0 peripheral with the provided configuration
- * @param[in] LPUART_Init: Pointer to a structure containing the initialization parameters
+ * @brief: Get the instance number of an LPUART, the index of its interrupt handler and clock
+ * @param[in] LPUARTx: LPUART base pointer
+ * @return: 0 for LPUART0 and so on, FSL_FEATURE_SOC_LPUART_COUNT if LPUARTx is not an LPUART
+ */
+uint32_t DRI_LPUART_GetInstance(const LPUART_Type *const LPUARTx);
+
+
+/*
+ * @brief: Initialize an LPUART peripheral with the provided configuration.
+ *         Its functional clock is FIRCDIV2_CLK, the pins are muxed by the caller
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  LPUART_Init: Pointer to a structure containing the initialization parameters
  * @return: None
  */
-void DRI_LPUART0_Init(const LPUART_InitTypeDef* const LPUART_Init);
+void DRI_LPUART_Init(LPUART_Type *const LPUARTx, const LPUART_InitTypeDef* const LPUART_Init);
+
+
+/*
+ * @brief: Get the baud rate the LPUART actually runs at for a desired baud rate,
+ *         with the OSR and SBR values DRI_LPUART_SetBaudRate would program
+ * @param[in] desiredBaudRate: The desired baud rate
+ * @return: The actual baud rate, 0 if the desired one cannot be reached
+ */
+uint32_t DRI_LPUART_GetBaudRate(const uint32_t desiredBaudRate);
+
+
+/*
+ * @brief: Change the baud rate of an LPUART that is already running.
+ *         The characters waiting in the receive FIFO are dropped
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  desiredBaudRate: The new baud rate
+ * @return: None
+ * @note: Characters still being sent are cut, the caller waits for the transmitter first
+ */
+void DRI_LPUART_ChangeBaudRate(LPUART_Type *const LPUARTx, const uint32_t desiredBaudRate);
 
 
 /*
@@ -63,6 +126,71 @@ void DRI_LPUART0_Init(const LPUART_InitTypeDef* const LPUART_Init);
 void DRI_LPUART_TranmitData(LPUART_Type *const LPUARTx,
         const uint8_t *const Data, const uint32_t size);
 
+
+/*
+ * @brief: Enable and disable LPUART interrupts from any context.
+ *         CTRL is read-modified-written with interrupts masked, so that an interrupt
+ *         handler changing other enable bits in between is not undone
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  enableMask: The interrupts to enable
+ * @param[in]  disableMask: The interrupts to disable
+ * @return: None
+ */
+void DRI_LPUART_SetInterrupts(LPUART_Type *const LPUARTx,
+        const uint32_t enableMask, const uint32_t disableMask);
+
+
+/*
+ * @brief: Copy data into the transmit ring and start the transmit interrupt, without waiting
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[out] ring: The transmit ring of the LPUART
+ * @param[in]  Data: Pointer to the data buffer to be transmitted
+ * @param[in]  size: Size of the data buffer to be transmitted
+ * @return: The number of characters accepted, less than size when the ring is full
+ * @note: Only one context may write to a ring
+ */
+uint32_t DRI_LPUART_TransmitAsync(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring,
+        const uint8_t *const Data, const uint32_t size);
+
+
+/*
+ * @brief: Get the number of characters the transmit ring can still take
+ * @param[in] ring: The transmit ring of the LPUART
+ * @return: The free room of the ring, more may be freed by the interrupt meanwhile
+ */
+uint32_t DRI_LPUART_TransmitFree(const LPUART_TxRing_t *const ring);
+
+
+/*
+ * @brief: Send a character ahead of everything waiting in the transmit ring
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[out] ring: The transmit ring of the LPUART
+ * @param[in]  character: The character to be sent, a previous one not sent yet is replaced
+ * @return: None
+ */
+void DRI_LPUART_TransmitPriority(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring,
+        const uint8_t character);
+
+
+/*
+ * @brief: Check if characters are still waiting or being shifted out
+ * @param[in] LPUARTx: LPUART base pointer
+ * @param[in] ring: The transmit ring of the LPUART
+ * @return: TRUE while the transmission is in progress, FALSE once the line is idle
+ */
+uint8_t DRI_LPUART_TransmitBusy(const LPUART_Type *const LPUARTx, const LPUART_TxRing_t *const ring);
+
+
+/*
+ * @brief: Transmit part of the LPUART interrupt handler.
+ *         Tops the transmit FIFO up from the ring on TDRE, then waits for TC to
+ *         call the completion callback of the ring
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[out] ring: The transmit ring of the LPUART
+ * @return: None
+ */
+void DRI_LPUART_TransmitIRQHandler(LPUART_Type *const LPUARTx, LPUART_TxRing_t *const ring);
+
 #endif /* _INC_DRI_LPUART_H_ */
 /*******************************************************************************
  * EOF
@@ -0,0 +1,144 @@
+/*
+ * dri_mscan.c
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_mscan.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DRI_MSCAN_IDAM_32BIT     0U      /* Two 32-bit acceptance filters */
+#define DRI_MSCAN_ID_DONT_CARE   0x07U   /* Unused bits of IDAR1 for a standard frame */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Initialize the MSCAN
+ */
+void DRI_MSCAN_Init(MSCAN_Type *const MSCANx, const MSCAN_InitTypeDef *const MSCAN_Init)
+{
+    uint8_t index = 0U;
+
+    /* Enable the interface clock for the MSCAN peripheral */
+    DRI_CLOCK_EnableClock(PCC_MSCAN0_INDEX);
+
+    /* Enable the module on the bus clock, then configure it in initialization mode */
+    MSCAN_SetInitMode(MSCANx, TRUE);
+    MSCANx->CANCTL1 = MSCAN_CANCTL1_CANE_MASK | MSCAN_CANCTL1_CLKSRC_MASK
+            | (MSCAN_Init->Loopback ? MSCAN_CANCTL1_LOOPB_MASK : 0U);
+
+    /* Configure bit timing, sampled once per bit */
+    MSCANx->CANBTR0 = MSCAN_CANBTR0_SJW(MSCAN_Init->SyncJumpWidth - 1U)
+            | MSCAN_CANBTR0_BRP(MSCAN_Init->Prescaler - 1U);
+    MSCANx->CANBTR1 = MSCAN_CANBTR1_TSEG1(MSCAN_Init->TimeSegment1 - 1U)
+            | MSCAN_CANBTR1_TSEG2(MSCAN_Init->TimeSegment2 - 1U);
+
+    /* Both 32-bit filters accept the standard data frames of FilterId only */
+    MSCANx->CANIDAC = MSCAN_CANIDAC_IDAM(DRI_MSCAN_IDAM_32BIT);
+    for (index = 0U; index < 4U; ++index)
+    {
+        MSCANx->CANIDAR_BANK_1[index] = 0U;
+        MSCANx->CANIDMR_BANK_1[index] = 0xFFU;
+    }
+    MSCANx->CANIDAR_BANK_1[0] = (uint8_t)(MSCAN_Init->FilterId >> 3U);
+    MSCANx->CANIDAR_BANK_1[1] = (uint8_t)((MSCAN_Init->FilterId & 0x07U) << 5U);
+    MSCANx->CANIDMR_BANK_1[0] = 0U;
+    MSCANx->CANIDMR_BANK_1[1] = DRI_MSCAN_ID_DONT_CARE;
+    for (index = 0U; index < 4U; ++index)
+    {
+        MSCANx->CANIDAR_BANK_2[index] = MSCANx->CANIDAR_BANK_1[index];
+        MSCANx->CANIDMR_BANK_2[index] = MSCANx->CANIDMR_BANK_1[index];
+    }
+
+    MSCAN_SetInitMode(MSCANx, FALSE);
+}
+
+
+/*
+ * @brief: Stop the MSCAN and gate its clock
+ */
+void DRI_MSCAN_DeInit(MSCAN_Type *const MSCANx)
+{
+    MSCANx->CANRIER = 0U;
+    MSCANx->CANTIER = 0U;
+    MSCAN_SetInitMode(MSCANx, TRUE);
+    MSCANx->CANCTL1 &= (uint8_t)~MSCAN_CANCTL1_CANE_MASK;
+    DRI_CLOCK_DisableClock(PCC_MSCAN0_INDEX);
+}
+
+
+/*
+ * @brief: Read the frame of the receive foreground buffer and release the buffer
+ */
+void DRI_MSCAN_ReadFrame(MSCAN_Type *const MSCANx, MSCAN_Frame_t *const frame)
+{
+    uint8_t index = 0U;
+
+    frame->id     = (uint16_t)(((uint16_t)MSCANx->RSIDR0 << 3U) | ((uint16_t)MSCANx->RSIDR1 >> 5U));
+    frame->length = MSCANx->RDLR & MSCAN_RDLR_RDLC_MASK;
+    if (frame->length > DRI_MSCAN_MAX_DATA)
+    {
+        frame->length = DRI_MSCAN_MAX_DATA;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+    for (index = 0U; index < frame->length; ++index)
+    {
+        frame->data[index] = MSCANx->REDSR[index];
+    }
+
+    MSCAN_ReleaseReceive(MSCANx);
+}
+
+
+/*
+ * @brief: Send a frame from an empty transmit buffer
+ */
+DRI_StatusTypeDef DRI_MSCAN_WriteFrame(MSCAN_Type *const MSCANx, const MSCAN_Frame_t *const frame,
+        const uint8_t priority)
+{
+    DRI_StatusTypeDef status = DRIVER_ERROR_BUSY;
+    uint8_t           buffer = MSCAN_GetEmptyTransmit(MSCANx);
+    uint8_t           index  = 0U;
+
+    if (0U != buffer)
+    {
+        /* Select the lowest empty buffer, it is mapped at the transmit registers */
+        MSCANx->CANTBSEL = buffer;
+        buffer           = MSCANx->CANTBSEL;
+
+        MSCANx->TSIDR0 = (uint8_t)(frame->id >> 3U);
+        MSCANx->TSIDR1 = (uint8_t)((frame->id & 0x07U) << 5U);
+        for (index = 0U; index < frame->length; ++index)
+        {
+            MSCANx->TEDSR[index] = frame->data[index];
+        }
+        MSCANx->TDLR = frame->length;
+        MSCANx->TBPR = priority;
+
+        /* Clearing TXE hands the buffer over for transmission */
+        MSCANx->CANTFLG = buffer;
+        status = DRIVER_OK;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
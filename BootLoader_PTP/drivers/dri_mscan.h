@@ -0,0 +1,98 @@
+/*
+ * dri_mscan.h
+ *
+ *  Created on: May 5, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_MSCAN_H_
+#define _INC_DRI_MSCAN_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "fsl_device_registers.h"
+#include "mscan.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DRI_MSCAN_MAX_DATA       8U      /* Data bytes of a classic CAN frame */
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief MSCAN Init Structure definition
+ */
+typedef struct
+{
+    uint8_t  Prescaler;        /* Bus clock cycles per time quantum, 1 to 64 */
+    uint8_t  SyncJumpWidth;    /* Time quanta, 1 to 4 */
+    uint8_t  TimeSegment1;     /* Time quanta before the sample point, sync excluded, 4 to 16 */
+    uint8_t  TimeSegment2;     /* Time quanta after the sample point, 2 to 8 */
+    uint16_t FilterId;         /* Only standard frames with this identifier are received */
+    uint8_t  Loopback;         /* TRUE to receive the frames sent, without the bus */
+} MSCAN_InitTypeDef;
+
+
+/*
+ * @brief Standard data frame
+ */
+typedef struct
+{
+    uint16_t id;                       /* 11-bit identifier */
+    uint8_t  length;                   /* Number of valid bytes in data */
+    uint8_t  data[DRI_MSCAN_MAX_DATA];
+} MSCAN_Frame_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Initialize the MSCAN on the bus clock with the provided configuration.
+ *         The pins are muxed by the caller
+ * @param[out] MSCANx: MSCAN base pointer
+ * @param[in]  MSCAN_Init: Pointer to a structure containing the initialization parameters
+ * @return: None
+ * @note: The interrupts are left disabled
+ */
+void DRI_MSCAN_Init(MSCAN_Type *const MSCANx, const MSCAN_InitTypeDef *const MSCAN_Init);
+
+
+/*
+ * @brief: Stop the MSCAN and gate its clock
+ * @param[out] MSCANx: MSCAN base pointer
+ * @return: None
+ */
+void DRI_MSCAN_DeInit(MSCAN_Type *const MSCANx);
+
+
+/*
+ * @brief: Read the frame of the receive foreground buffer and release the buffer
+ * @param[out] MSCANx: MSCAN base pointer
+ * @param[out] frame: The received frame
+ * @return: None
+ * @note: Only called while MSCAN_ReceiveFull is TRUE
+ */
+void DRI_MSCAN_ReadFrame(MSCAN_Type *const MSCANx, MSCAN_Frame_t *const frame);
+
+
+/*
+ * @brief: Send a frame from an empty transmit buffer
+ * @param[out] MSCANx: MSCAN base pointer
+ * @param[in]  frame: The frame to send
+ * @param[in]  priority: Local priority of the buffer, the lowest value is sent first
+ * @return: DRIVER_OK if the frame is queued, DRIVER_ERROR_BUSY if no buffer is empty
+ * @note: Only one context may send frames, the buffer selection is not atomic
+ */
+DRI_StatusTypeDef DRI_MSCAN_WriteFrame(MSCAN_Type *const MSCANx, const MSCAN_Frame_t *const frame,
+        const uint8_t priority);
+
+#endif /* _INC_DRI_MSCAN_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
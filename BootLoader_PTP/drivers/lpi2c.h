@@ -0,0 +1,103 @@
+/*
+ * lpi2c.h
+ *
+ *  Created on: May 07, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_LPI2C_H_
+#define _INC_LPI2C_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:     Enable/Disable the LPI2C slave
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @param[in]  enable: Enable or disable the slave
+ */
+static inline void LPI2C_SlaveEnable(LPI2C_Type *const LPI2Cx, const uint8_t enable)
+{
+    LPI2Cx->SCR = (LPI2Cx->SCR & ~LPI2C_SCR_SEN_MASK) | LPI2C_SCR_SEN(enable ? 1U : 0U);
+}
+
+
+/*
+ * @brief:     Reset every slave register of the LPI2C module
+ * @param[out] LPI2Cx: LPI2C base pointer
+ */
+static inline void LPI2C_SlaveReset(LPI2C_Type *const LPI2Cx)
+{
+    LPI2Cx->SCR = LPI2C_SCR_RST_MASK | LPI2C_SCR_RTF_MASK | LPI2C_SCR_RRF_MASK;
+    LPI2Cx->SCR = 0U;
+}
+
+
+/*
+ * @brief:     Enable/Disable LPI2C slave interrupts
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @param[in]  enableMask: Bits of SIER to set
+ * @param[in]  disableMask: Bits of SIER to clear
+ */
+static inline void LPI2C_SlaveSetInterrupts(LPI2C_Type *const LPI2Cx,
+        const uint32_t enableMask, const uint32_t disableMask)
+{
+    LPI2Cx->SIER = (LPI2Cx->SIER & ~disableMask) | enableMask;
+}
+
+
+/*
+ * @brief:     Clear LPI2C slave status flags
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @param[in]  mask: The w1c flags of SSR to clear
+ */
+static inline void LPI2C_SlaveClearStatusFlags(LPI2C_Type *const LPI2Cx, const uint32_t mask)
+{
+    LPI2Cx->SSR = mask;
+}
+
+
+/*
+ * @brief:    Reads the address the slave was selected with, which releases an address stall
+ * @param[in] LPI2Cx: LPI2C base pointer
+ * @return:   The received address, bit 0 is set for a read transfer
+ */
+static inline uint32_t LPI2C_SlaveReadAddress(const LPI2C_Type *const LPI2Cx)
+{
+    return (LPI2Cx->SASR & LPI2C_SASR_RADDR_MASK) >> LPI2C_SASR_RADDR_SHIFT;
+}
+
+
+/*
+ * @brief:    Reads a received byte, which releases a receive stall
+ * @param[in] LPI2Cx: LPI2C base pointer
+ * @return:   The received byte
+ */
+static inline uint8_t LPI2C_SlaveReceiveByte(const LPI2C_Type *const LPI2Cx)
+{
+    return (uint8_t)(LPI2Cx->SRDR & LPI2C_SRDR_DATA_MASK);
+}
+
+
+/*
+ * @brief:     Writes the byte sent on the next read cycle, which releases a transmit stall
+ * @param[out] LPI2Cx: LPI2C base pointer
+ * @param[in]  data: The byte to send
+ */
+static inline void LPI2C_SlaveTransmitByte(LPI2C_Type *const LPI2Cx, const uint8_t data)
+{
+    LPI2Cx->STDR = data;
+}
+
+#endif /* _INC_LPI2C_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
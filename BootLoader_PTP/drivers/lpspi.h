@@ -0,0 +1,137 @@
+/*
+ * lpspi.h
+ *
+ *  Created on: May 07, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_LPSPI_H_
+#define _INC_LPSPI_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+
+/*
+ * @brief: LPSPI clock polarity, level of SCK between frames
+ */
+typedef enum
+{
+    LPSPI_CLOCK_IDLE_LOW  = 0U,
+    LPSPI_CLOCK_IDLE_HIGH = 1U
+} LPSPI_Clock_Polarity_t;
+
+
+/*
+ * @brief: LPSPI clock phase, edge of SCK the data is captured on
+ */
+typedef enum
+{
+    LPSPI_CAPTURE_LEADING  = 0U,  /* Captured on the leading edge, changed on the following edge */
+    LPSPI_CAPTURE_TRAILING = 1U   /* Changed on the leading edge, captured on the following edge */
+} LPSPI_Clock_Phase_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:     Enable/Disable the LPSPI module
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  enable: Enable or disable the module
+ */
+static inline void LPSPI_Enable(LPSPI_Type *const LPSPIx, const uint8_t enable)
+{
+    LPSPIx->CR = (LPSPIx->CR & ~LPSPI_CR_MEN_MASK) | LPSPI_CR_MEN(enable ? 1U : 0U);
+}
+
+
+/*
+ * @brief:     Reset every register of the LPSPI module and flush its FIFOs
+ * @param[out] LPSPIx: LPSPI base pointer
+ */
+static inline void LPSPI_SoftwareReset(LPSPI_Type *const LPSPIx)
+{
+    LPSPIx->CR = LPSPI_CR_RST_MASK | LPSPI_CR_RTF_MASK | LPSPI_CR_RRF_MASK;
+    LPSPIx->CR = 0U;
+}
+
+
+/*
+ * @brief:     Set the receive and transmit FIFO watermarks
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  rxWatermark: RDF is set when the receive FIFO holds more words
+ * @param[in]  txWatermark: TDF is set when the transmit FIFO holds this many words or less
+ */
+static inline void LPSPI_SetWatermarks(LPSPI_Type *const LPSPIx,
+        const uint8_t rxWatermark, const uint8_t txWatermark)
+{
+    LPSPIx->FCR = LPSPI_FCR_RXWATER(rxWatermark) | LPSPI_FCR_TXWATER(txWatermark);
+}
+
+
+/*
+ * @brief:     Enable LPSPI interrupts
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  mask: Bits of IER to set
+ */
+static inline void LPSPI_EnableInterrupts(LPSPI_Type *const LPSPIx, const uint32_t mask)
+{
+    LPSPIx->IER |= mask;
+}
+
+
+/*
+ * @brief:     Clear LPSPI status flags
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  mask: The w1c flags of SR to clear
+ */
+static inline void LPSPI_ClearStatusFlags(LPSPI_Type *const LPSPIx, const uint32_t mask)
+{
+    LPSPIx->SR = mask;
+}
+
+
+/*
+ * @brief:    Check if the receive FIFO is empty
+ * @param[in] LPSPIx: LPSPI base pointer
+ * @return:   TRUE if there is no word to read, FALSE otherwise
+ */
+static inline uint8_t LPSPI_ReceiveEmpty(const LPSPI_Type *const LPSPIx)
+{
+    return (0U != (LPSPIx->RSR & LPSPI_RSR_RXEMPTY_MASK)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief:    Reads a word from the receive FIFO
+ * @param[in] LPSPIx: LPSPI base pointer
+ * @return:   The received word
+ */
+static inline uint32_t LPSPI_ReceiveWord(const LPSPI_Type *const LPSPIx)
+{
+    return LPSPIx->RDR;
+}
+
+
+/*
+ * @brief:     Writes a word to the transmit FIFO
+ * @param[out] LPSPIx: LPSPI base pointer
+ * @param[in]  data: The word shifted out on the next frame
+ */
+static inline void LPSPI_TransmitWord(LPSPI_Type *const LPSPIx, const uint32_t data)
+{
+    LPSPIx->TDR = data;
+}
+
+#endif /* _INC_LPSPI_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -149,6 +149,132 @@ static inline void LPUART_SetTranmitDataInvert(LPUART_Type *const LPUARTx,
 }
 
 
+/*
+ * @brief:     Sets the hardware flow control of the LPUART (active low RTS and CTS)
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  enable:  Enable or disable RTS driven by the receiver and CTS gating the transmitter
+ * @param[in]  watermark: RTS is negated when the receive FIFO holds more than this many characters
+ */
+static inline void LPUART_SetHardwareFlowControl(LPUART_Type *const LPUARTx,
+        const uint8_t enable, const uint8_t watermark)
+{
+    LPUARTx->MODIR = (LPUARTx->MODIR & ~(LPUART_MODIR_RXRTSE_MASK | LPUART_MODIR_TXCTSE_MASK
+                                         | LPUART_MODIR_TXRTSPOL_MASK | LPUART_MODIR_RTSWATER_MASK))
+            | LPUART_MODIR_RXRTSE(enable ? 1U : 0U)
+            | LPUART_MODIR_TXCTSE(enable ? 1U : 0U)
+            | LPUART_MODIR_RTSWATER(watermark);
+}
+
+
+/*
+ * @brief:     Enable/Disable the LPUART receive FIFO and flush its content
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  enable:  Enable or disable the receive FIFO
+ * @note:      The receiver must be disabled while the FIFO is enabled or disabled
+ */
+static inline void LPUART_SetReceiveFifo(LPUART_Type *const LPUARTx,
+        const uint8_t enable)
+{
+    LPUARTx->FIFO = (LPUARTx->FIFO & ~(LPUART_FIFO_RXFE_MASK | LPUART_FIFO_RXUF_MASK | LPUART_FIFO_TXOF_MASK))
+            | LPUART_FIFO_RXFE(enable ? 1U : 0U)
+            | LPUART_FIFO_RXFLUSH_MASK;
+}
+
+
+/*
+ * @brief:     Sets the receive watermark
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  watermark: RDRF is set when the receive FIFO holds more than this many characters
+ */
+static inline void LPUART_SetReceiveWatermark(LPUART_Type *const LPUARTx,
+        const uint8_t watermark)
+{
+    LPUARTx->WATER = (LPUARTx->WATER & ~LPUART_WATER_RXWATER_MASK)
+            | LPUART_WATER_RXWATER(watermark);
+}
+
+
+/*
+ * @brief:     Enable/Disable the LPUART transmit FIFO and flush its content
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  enable:  Enable or disable the transmit FIFO
+ * @note:      The transmitter must be disabled while the FIFO is enabled or disabled
+ */
+static inline void LPUART_SetTransmitFifo(LPUART_Type *const LPUARTx,
+        const uint8_t enable)
+{
+    LPUARTx->FIFO = (LPUARTx->FIFO & ~(LPUART_FIFO_TXFE_MASK | LPUART_FIFO_RXUF_MASK | LPUART_FIFO_TXOF_MASK))
+            | LPUART_FIFO_TXFE(enable ? 1U : 0U)
+            | LPUART_FIFO_TXFLUSH_MASK;
+}
+
+
+/*
+ * @brief:     Sets the transmit watermark
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  watermark: TDRE is set when the transmit FIFO holds this many characters or less
+ */
+static inline void LPUART_SetTransmitWatermark(LPUART_Type *const LPUARTx,
+        const uint8_t watermark)
+{
+    LPUARTx->WATER = (LPUARTx->WATER & ~LPUART_WATER_TXWATER_MASK)
+            | LPUART_WATER_TXWATER(watermark);
+}
+
+
+/*
+ * @brief:     Gets the number of characters waiting in the transmit FIFO
+ * @param[in]  LPUARTx: LPUART base pointer
+ * @return:    The number of characters in the transmit FIFO
+ */
+static inline uint8_t LPUART_GetTransmitCount(const LPUART_Type *const LPUARTx)
+{
+    return (uint8_t)((LPUARTx->WATER & LPUART_WATER_TXCOUNT_MASK) >> LPUART_WATER_TXCOUNT_SHIFT);
+}
+
+
+/*
+ * @brief:     Sets the idle line detection, counted from the stop bit of the last character
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  idleConfig: IDLE is set after 2^idleConfig idle characters
+ */
+static inline void LPUART_SetIdleConfig(LPUART_Type *const LPUARTx,
+        const uint8_t idleConfig)
+{
+    LPUARTx->CTRL = (LPUARTx->CTRL & ~(LPUART_CTRL_ILT_MASK | LPUART_CTRL_IDLECFG_MASK))
+            | LPUART_CTRL_ILT(1U)
+            | LPUART_CTRL_IDLECFG(idleConfig);
+}
+
+
+/*
+ * @brief:     Check if the receive buffer/FIFO is empty
+ * @param[in]  LPUARTx: LPUART base pointer
+ * @return:    TRUE if no received character is waiting, FALSE otherwise
+ */
+static inline uint8_t LPUART_IsReceiveEmpty(const LPUART_Type *const LPUARTx)
+{
+    return (0U != (LPUARTx->FIFO & LPUART_FIFO_RXEMPT_MASK)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief:     Clears the write-1-to-clear status flags given by a mask
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  mask: The flags to clear (IDLE, OR, NF, FE, PF, ...)
+ * @note:      The other flags are written with 0 so that they are left pending
+ */
+static inline void LPUART_ClearStatusFlags(LPUART_Type *const LPUARTx, const uint32_t mask)
+{
+    LPUARTx->STAT = (LPUARTx->STAT & ~(LPUART_STAT_LBKDIF_MASK | LPUART_STAT_RXEDGIF_MASK
+                                       | LPUART_STAT_IDLE_MASK | LPUART_STAT_OR_MASK
+                                       | LPUART_STAT_NF_MASK | LPUART_STAT_FE_MASK
+                                       | LPUART_STAT_PF_MASK | LPUART_STAT_MA1F_MASK
+                                       | LPUART_STAT_MA2F_MASK))
+            | mask;
+}
+
+
 /*
  * @brief:     Sets the Stop Bit Number
  * @param[out] LPUARTx: LPUART base pointer
@@ -173,6 +299,17 @@ static inline void LPUART_EnableInterrupts(LPUART_Type *LPUARTx, const uint32_t
 }
 
 
+/*
+ * @brief:     Disables LPUART interrupts according to a provided mask.
+ * @param[out] LPUARTx: LPUART base pointer
+ * @param[in]  mask: The interrupts to disable
+ */
+static inline void LPUART_DisableInterrupts(LPUART_Type *LPUARTx, const uint32_t mask)
+{
+    LPUARTx->CTRL &= ~mask;
+}
+
+
 /*
  * @brief:     Enables sampling of the received data on both edges of the baud rate clock
  * @param[out] LPUARTx: LPUART base pointer
@@ -183,6 +320,16 @@ static inline void LPUART_EnableBothEdgeSampling(LPUART_Type *const LPUARTx)
 }
 
 
+/*
+ * @brief:     Disables sampling of the received data on both edges of the baud rate clock
+ * @param[out] LPUARTx: LPUART base pointer
+ */
+static inline void LPUART_DisableBothEdgeSampling(LPUART_Type *const LPUARTx)
+{
+    LPUARTx->BAUD &= ~LPUART_BAUD_BOTHEDGE_MASK;
+}
+
+
 /*
  * @brief: Configures the number of bits per char in LPUART controller
  */
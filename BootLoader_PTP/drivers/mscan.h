@@ -0,0 +1,99 @@
+/*
+ * mscan.h
+ *
+ *  Created on: May 07, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_MSCAN_H_
+#define _INC_MSCAN_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define MSCAN_TX_BUFFERS_MASK    0x07U   /* TXE bits of the three transmit buffers */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:     Enter or leave the initialization mode, waiting for the acknowledge
+ * @param[out] MSCANx: MSCAN base pointer
+ * @param[in]  enable: TRUE to enter the initialization mode, FALSE to leave it
+ * @note:      The receive and transmit interrupt enables are cleared on entering it
+ */
+static inline void MSCAN_SetInitMode(MSCAN_Type *const MSCANx, const uint8_t enable)
+{
+    if (enable)
+    {
+        MSCANx->CANCTL0 |= MSCAN_CANCTL0_INITRQ_MASK;
+        while (0U == (MSCANx->CANCTL1 & MSCAN_CANCTL1_INITAK_MASK))
+        {
+            /* Wait for the initialization mode */
+        }
+    }
+    else
+    {
+        MSCANx->CANCTL0 &= (uint8_t)~MSCAN_CANCTL0_INITRQ_MASK;
+        while (0U != (MSCANx->CANCTL1 & MSCAN_CANCTL1_INITAK_MASK))
+        {
+            /* Wait for the normal mode */
+        }
+    }
+}
+
+
+/*
+ * @brief:    Check if a frame is waiting in the receive foreground buffer
+ * @param[in] MSCANx: MSCAN base pointer
+ * @return:   TRUE if a frame can be read, FALSE otherwise
+ */
+static inline uint8_t MSCAN_ReceiveFull(const MSCAN_Type *const MSCANx)
+{
+    return (0U != (MSCANx->CANRFLG & MSCAN_CANRFLG_RXF_MASK)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief:     Release the receive foreground buffer to the next frame
+ * @param[out] MSCANx: MSCAN base pointer
+ */
+static inline void MSCAN_ReleaseReceive(MSCAN_Type *const MSCANx)
+{
+    MSCANx->CANRFLG = MSCAN_CANRFLG_RXF_MASK;
+}
+
+
+/*
+ * @brief:    Gets the transmit buffers that are empty
+ * @param[in] MSCANx: MSCAN base pointer
+ * @return:   One TXE bit per empty buffer
+ */
+static inline uint8_t MSCAN_GetEmptyTransmit(const MSCAN_Type *const MSCANx)
+{
+    return MSCANx->CANTFLG & MSCAN_TX_BUFFERS_MASK;
+}
+
+
+/*
+ * @brief:     Set the transmit buffers whose emptying raises an interrupt
+ * @param[out] MSCANx: MSCAN base pointer
+ * @param[in]  mask: One TXEIE bit per buffer, the others are disabled
+ */
+static inline void MSCAN_SetTransmitInterrupts(MSCAN_Type *const MSCANx, const uint8_t mask)
+{
+    MSCANx->CANTIER = mask & MSCAN_TX_BUFFERS_MASK;
+}
+
+#endif /* _INC_MSCAN_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
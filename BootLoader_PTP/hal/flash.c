@@ -18,7 +18,7 @@
  ******************************************************************************/
 
 /* Program Address and Data (32bit) into Flash Memory */
-void Program_LongWord(uint32_t Addr, uint8_t *Data)
+void Program_LongWord(uint32_t Addr, const uint8_t *const Data)
 {
     __disable_irq();
 
@@ -76,7 +76,8 @@ uint8_t  Erase_Sector(const uint32_t Addr)
     /* Wait CMD finish */
     while (FTFA->FSTAT == 0x00U);
 
-    return 0U;
+    /* Access error, protected sector or failed erase verify */
+    return (0U != (FTFA->FSTAT & (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK | FTFA_FSTAT_MGSTAT0_MASK))) ? 1U : 0U;
 }
 
 
@@ -84,11 +85,12 @@ uint8_t  Erase_Sector(const uint32_t Addr)
 uint8_t  Erase_Multi_Sector(const uint32_t Addr, const uint32_t Size)
 {
     uint8_t index;
+    uint8_t status = 0U;
 
     for(index = 0U; index < Size; index++)
     {
-        Erase_Sector(Addr + index * 1024U);
+        status |= Erase_Sector(Addr + index * 1024U);
     }
 
-    return 0U;
+    return status;
 }
@@ -30,7 +30,7 @@
  * @param *Data: input data need to flash data into flash
  * @return: None
  */
-void Program_LongWord(uint32_t Addr, uint8_t *Data);
+void Program_LongWord(uint32_t Addr, const uint8_t *const Data);
 
 
 /*
@@ -38,7 +38,7 @@ void Program_LongWord(uint32_t Addr, uint8_t *Data);
  * erase a sector in flash
  * @param Addr: address to erase
  * @return
- * return 1: if success
+ * return 0: if success, 1: if the erase failed or the sector is protected
  */
 uint8_t Erase_Sector(const uint32_t Addr);
 
@@ -47,7 +47,7 @@ uint8_t Erase_Sector(const uint32_t Addr);
  * erase multi sectors in flash
  * @param Addr: address to erase
  * @return
- * return 1: if success
+ * return 0: if success, 1: if any sector failed to erase
  */
 uint8_t Erase_Multi_Sector(const uint32_t Addr, const uint32_t Size);
 
@@ -9,33 +9,13 @@
  * Includes
  ******************************************************************************/
 #include "hal.h"
-
-/*******************************************************************************
- * Defines
- ******************************************************************************/
-#define HAL_LPUART0_IRQHandler    LPUART0_IRQHandler
+#include "hal_transport.h"
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-static uint8_t   g_pushFailed;
-static uint32_t  g_baudrate;
-static funcMid   Push_Data_Func;  /* Used to save the function' address
-                                          which push received data into queue */
-
-/*******************************************************************************
- * Prototypes
- ******************************************************************************/
-
-/*
- * @brief: LPUART0 interrupt handler
- */
-void HAL_LPUART0_IRQHandler(void)
-{
-    /* Push received character into Queue */
-    g_pushFailed = Push_Data_Func((uint8_t)(LPUART0->DATA));
-}
-
+static uint32_t  g_timeoutStart;  /* SysTick value when the timeout was started */
+static uint32_t  g_timeoutTicks;  /* Length of the timeout in core clock cycles */
 
 /*
  * @brief: Initialize the hardware abstraction layer (HAL)
@@ -45,7 +25,7 @@ void HAL_Init(void)
     /* Port initialization structure */
     PORT_InitTypeDef PORT_InitStruct =
     {
-        .Mux  = PORT_MUX_ALT2,
+        .Mux  = PORT_MUX_GPIO,
         .Pull = PORT_PULL_UP,
     };
 
@@ -55,18 +35,6 @@ void HAL_Init(void)
         .Direction = GPIO_INPUT,
     };
 
-    /* LPUART initialization structure */
-    LPUART_InitTypeDef LPUART_InitStruct =
-    {
-        .BaudRate         = g_baudrate,
-        .Parity           = LPUART_NO_PARITY,
-        .Mode             = LPUART_8_BITS_MODE,
-        .StopBit          = LPUART_ONE_STOP_BIT,
-        .MSBFirst         = FALSE,
-        .ReceiveInverted  = FALSE,
-        .TransmitInverted = FALSE
-    };
-
     /* Fast clock initialization structure */
     SCG_FIRC_Config_t FIRC_InitStruct =
     {
@@ -75,27 +43,15 @@ void HAL_Init(void)
     };
 
     /* Configure clocks */
-    DRI_CLOCK_EnableClock(PCC_PORTB_INDEX);          /* Enable clock for LPUART0_SDA PORT */
     DRI_CLOCK_EnableClock(PCC_PORTD_INDEX);          /* Enable clock for PORTD */
-    DRI_CLOCK_InitFirc(&FIRC_InitStruct);            /* Configure the fast clock source for use with LPUART */
-
-    /* Configure Pins for LPUART function */
-    DRI_PORT_Pin_Init(LPUART0_SDA_RX_PORT, LPUART0_SDA_RX_PIN,
-                                                &PORT_InitStruct);        /* PORTB-PIN0: RX Pin */
-    DRI_PORT_Pin_Init(LPUART0_SDA_TX_PORT, LPUART0_SDA_TX_PIN,
-                                                &PORT_InitStruct);        /* PORTB-PIN1: TX Pin */
+    DRI_CLOCK_InitFirc(&FIRC_InitStruct);            /* Configure the fast clock source for use with the transport */
 
     /* Configure GPIO function for PORTD_Pin2 (SW3) */
-    PORT_InitStruct.Mux = PORT_MUX_GPIO;
     DRI_PORT_Pin_Init(BUTTON03_PORT, BUTTON03_PIN, &PORT_InitStruct);  /* Select GPIO function for PORTD Pin2 */
     DRI_GPIO_Init(BUTTON03_GPIO, BUTTON03_PIN, &GPIO_InitStruct);      /* Select input mode for Pin2 */
 
-    /* Initialize LPUART0 module */
-    DRI_LPUART0_Init(&LPUART_InitStruct);
-
-    /* Enable interrupt for LPUART0 */
-    LPUART_EnableInterrupts(LPUART0, LPUART_CTRL_RIE_MASK);
-    NVIC_EnableIRQ(LPUART0_IRQn);
+    /* Start listening on the transport */
+    HAL_transportInit();
 }
 
 
@@ -104,47 +60,46 @@ void HAL_Init(void)
  */
 void HAL_DeInit(void)
 {
+    HAL_transportDeInit();
     DRI_CLOCK_DeinitFirc();                  /* De-initializes the SCG fast IRC */
-    DRI_CLOCK_DisableClock(PCC_PORTB_INDEX); /* Disable clock for LPUART0_SDA PORT */
-    NVIC_DisableIRQ(LPUART0_IRQn);           /* Disable interrupt */
-}
-
-
-/*
- * @brief: Set the baud rate used for communication in the HAL layer
- */
-void HAL_SetBaudrate(const uint32_t baudrate)
-{
-    g_baudrate = baudrate;
 }
 
 
 /*
- * @brief: Transmit data via the LPUART0 peripheral
+ * @brief: Starts a timeout measured with SysTick on the core clock
  */
-void HAL_TransmitData(const uint8_t *const data, const uint32_t size)
+void HAL_timeoutStart(const uint32_t microseconds)
 {
-    DRI_LPUART_TranmitData(LPUART0, data, size);
-}
-
-
-/*
- * @brief: Sets the address of a function from a higher layer in the system
- */
-uint8_t HAL_getFuncAddress(const void *const funcAddress)
-{
-    DRI_StatusTypeDef status = 0U;
+    if (0U == (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk))
+    {
+        /* Free-running SysTick on the core clock, without interrupt */
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL  = 0U;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
 
-    if (funcAddress != NULL)
+    if (microseconds > (SysTick_LOAD_RELOAD_Msk / (SystemCoreClock / 1000000U)))
     {
-        Push_Data_Func = funcAddress;
+        g_timeoutTicks = SysTick_LOAD_RELOAD_Msk;
     }
     else
     {
-        status = 1U;
+        g_timeoutTicks = microseconds * (SystemCoreClock / 1000000U);
     }
+    g_timeoutStart = SysTick->VAL;
+}
 
-    return status;
+
+/*
+ * @brief: Checks if the timeout started by HAL_timeoutStart has expired
+ */
+uint8_t HAL_timeoutExpired(void)
+{
+    return (((g_timeoutStart - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk) >= g_timeoutTicks) ? TRUE : FALSE;
 }
 
 
@@ -166,19 +121,10 @@ uint8_t HAL_switchIsPressed(void)
 }
 
 
-/*
- * @brief: Returns the status of the data push operation to the queue
- */
-uint8_t HAL_pushDataFailed(void)
-{
-    return g_pushFailed;
-}
-
-
 /*
  * @brief:  Jumps to the application code located at the specified address
  */
-void HAL_jumpApplication(const uint32_t appAddress)
+void HAL_jumpApplication(const uint32_t appAddress, const uint32_t entryPoint)
 {
     __disable_irq();
     /* Clear pending interrupt request */
@@ -191,8 +137,9 @@ void HAL_jumpApplication(const uint32_t appAddress)
     /* Set main stack pointer */
     __set_MSP(*(uint32_t *)appAddress);
 
-    /* Jump to user's application */
-    uint32_t app_start_address = *((volatile uint32_t *)(appAddress + 4));
+    /* Jump to user's application, through its reset vector unless an entry point is given */
+    uint32_t app_start_address = (0U != entryPoint) ? (entryPoint | 1U) /* Thumb state */
+                                                    : *((volatile uint32_t *)(appAddress + 4));
     void (*app_entry_point)(void) = (void (*)(void))app_start_address;
     app_entry_point();
 }
@@ -210,7 +157,7 @@ void HAL_backupApplication(const uint32_t appAddress,
     for (index = 0U; index < numberWords; ++index)
     {
         Program_LongWord(backupAddress + (index * 4U),
-                            (uint8_t*) (appAddress + (index * 4U)));
+                            (const uint8_t*) (appAddress + (index * 4U)));
     }
 }
 
@@ -227,9 +174,10 @@ void HAL_restoreApplication(const uint32_t restoreAddress,
     for (index = 0U; index < numberWords; ++index)
     {
         Program_LongWord(restoreAddress + (index * 4U),
-                            (uint8_t*) (backupAddress + (index * 4U)));
+                            (const uint8_t*) (backupAddress + (index * 4U)));
     }
 }
+
 /*******************************************************************************
  * EOF
  ******************************************************************************/
@@ -12,10 +12,16 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include "fsl_device_registers.h"
 #include "dri_gpio.h"
 #include "dri_lpuart.h"
+#include "dri_lpspi.h"
+#include "dri_lpi2c.h"
+#include "dri_mscan.h"
 #include "flash.h"
+#include "hal_def.h"
 #include <math.h>
+#include <string.h>
 
 /*******************************************************************************
  * Defines
@@ -25,104 +31,129 @@
 #define BUTTON03_PIN          2U
 
 #define LPUART0_SDA_RX_PORT   PORTB
+#define LPUART0_SDA_RX_GPIO   GPIOB
 #define LPUART0_SDA_RX_PIN    0U
 
 #define LPUART0_SDA_TX_PORT   PORTB
 #define LPUART0_SDA_TX_PIN    1U
 
-#define SWITCH_PRESSED        0U
-/*******************************************************************************
- * Typedefs
- ******************************************************************************/
-typedef int8_t (*funcMid)(const uint8_t);
+#define LPUART1_RX_PORT       PORTC
+#define LPUART1_RX_GPIO       GPIOC
+#define LPUART1_RX_PIN        6U
+#define LPUART1_TX_PORT       PORTC
+#define LPUART1_TX_PIN        7U
+
+#define LPUART2_RX_PORT       PORTD
+#define LPUART2_RX_GPIO       GPIOD
+#define LPUART2_RX_PIN        6U
+#define LPUART2_TX_PORT       PORTD
+#define LPUART2_TX_PIN        7U
+
+
+#define LPSPI0_SCK_PORT       PORTB
+#define LPSPI0_SCK_PIN        2U
+#define LPSPI0_SIN_PORT       PORTB
+#define LPSPI0_SIN_PIN        3U
+#define LPSPI0_SOUT_PORT      PORTB
+#define LPSPI0_SOUT_PIN       4U
+#define LPSPI0_PCS_PORT       PORTB
+#define LPSPI0_PCS_PIN        5U
+#define LPSPI0_PCS            1U      /* PTB5 is PCS1 */
+#define LPSPI0_MUX            PORT_MUX_ALT3
+
+#define LPSPI0_BUSY_PORT      PORTD
+#define LPSPI0_BUSY_GPIO      GPIOD
+#define LPSPI0_BUSY_PIN       5U      /* Driven high while the master must not send */
+
+#define HAL_SPI_IDLE_BYTE     0xFFU   /* Shifted out on MISO while no reply is waiting */
+
+#define LPI2C0_SDA_PORT       PORTA
+#define LPI2C0_SDA_PIN        2U
+#define LPI2C0_SCL_PORT       PORTA
+#define LPI2C0_SCL_PIN        3U
+#define LPI2C0_MUX            PORT_MUX_ALT3
+
+#ifndef HAL_I2C_ADDRESS
+#define HAL_I2C_ADDRESS       0x50U   /* 7-bit address of the bootloader on the bus */
+#endif
+
+#define HAL_I2C_REG_BLOCK     0x10U   /* Write: the bytes that follow are part of the image */
+#define HAL_I2C_REG_STATUS    0x20U   /* Read: HAL_I2C_STATUS_* flags, then the number of reply bytes waiting */
+#define HAL_I2C_REG_REPLY     0x21U   /* Read: the reply bytes, HAL_I2C_IDLE_BYTE once there is none */
+#define HAL_I2C_REG_JUMP      0x30U   /* Write HAL_I2C_JUMP_KEY: start the application once it is loaded */
+#define HAL_I2C_JUMP_KEY      0xA5U
+#define HAL_I2C_IDLE_BYTE     0xFFU
+
+#define HAL_I2C_STATUS_BUSY   0x01U   /* Block writes are stretched until the flash catches up */
+#define HAL_I2C_STATUS_ERROR  0x02U   /* Bytes were lost on the bus since the bootloader started */
+#define HAL_I2C_STATUS_REPLY  0x04U   /* Reply bytes are waiting to be read */
+#define HAL_I2C_STATUS_JUMP   0x08U   /* The jump command has been received */
+
+#define MSCAN_RX_PORT         PORTE
+#define MSCAN_RX_PIN          4U
+#define MSCAN_TX_PORT         PORTE
+#define MSCAN_TX_PIN          5U
+#define MSCAN_MUX             PORT_MUX_ALT5
+
+#ifndef HAL_CAN_BITRATE
+#define HAL_CAN_BITRATE       500000U /* Bits per second on the bus */
+#endif
+#ifndef HAL_CAN_RX_ID
+#define HAL_CAN_RX_ID         0x7E0U  /* Identifier of the frames sent by the host */
+#endif
+#ifndef HAL_CAN_TX_ID
+#define HAL_CAN_TX_ID         0x7E8U  /* Identifier of the frames sent by the bootloader */
+#endif
+#define HAL_CAN_BLOCK_SIZE    8U      /* Consecutive frames the host sends per flow control, 0 for all */
+#define HAL_CAN_STMIN         0U      /* Minimum separation time between consecutive frames, in ms */
+#define HAL_CAN_PADDING       0xCCU   /* Unused bytes of the frames sent */
+
+#if (HAL_TRANSPORT_LPUART == HAL_TRANSPORT) && (HAL_PORT_COUNT != FSL_FEATURE_SOC_LPUART_COUNT)
+#error "HAL_PORT_COUNT must match the number of LPUARTs of the device"
+#endif
+
+#define LPUART0_CTS_PORT      PORTC
+#define LPUART0_CTS_PIN       8U
+#define LPUART0_RTS_PORT      PORTC
+#define LPUART0_RTS_PIN       9U
+#define LPUART0_RTS_CTS_MUX   PORT_MUX_ALT6
+
+#ifndef HAL_HARDWARE_FLOW_CONTROL
+#define HAL_HARDWARE_FLOW_CONTROL  FALSE  /* TRUE when the RTS/CTS lines of LPUART0 are wired to the host */
+#endif
+
+#if ((HAL_PORT_MASK & 0x01U) == 0U) && (TRUE == HAL_HARDWARE_FLOW_CONTROL)
+#error "HAL_HARDWARE_FLOW_CONTROL needs LPUART0 in HAL_PORT_MASK"
+#endif
+
+#define HAL_RX_FIFO_SIZE      FSL_FEATURE_LPUART_FIFO_SIZEn(LPUART0)
+#define HAL_RX_WATERMARK      (HAL_RX_FIFO_SIZE - 2U)  /* Interrupt with one free entry left for the interrupt latency */
+#define HAL_RTS_WATERMARK     (HAL_RX_FIFO_SIZE - 1U)  /* Characters held in the receive FIFO before RTS is negated */
+#define HAL_IDLE_CONFIG       0U      /* The end of a burst is one idle character */
+#define HAL_TX_WATERMARK      1U      /* Refill the transmit FIFO before its last character is shifted out */
+#define HAL_RX_INTERRUPTS     (LPUART_CTRL_RIE_MASK | LPUART_CTRL_ILIE_MASK | LPUART_CTRL_ORIE_MASK)
+#define HAL_RX_ERROR_FLAGS    (LPUART_STAT_OR_MASK | LPUART_STAT_NF_MASK | LPUART_STAT_FE_MASK | LPUART_STAT_PF_MASK)
 
 /*******************************************************************************
- * APIs
+ * Typedef structs
  ******************************************************************************/
 
 /*
- * @brief:  Initializes the hardware abstraction layer (HAL)
- * @param:  None
- * @return: None
- */
-void HAL_Init(void);
-
-
-/*
- * @brief:  De-initializes the hardware abstraction layer (HAL)
- * @param:  None
- * @return: None
- */
-void HAL_DeInit(void);
-
-
-/*
- * @brief:    Sets the address of a function from a higher layer in the system
- * @param[in] funcAddress The address of the function to be set
- * @return:   0 if the function address is successfully set, 1 if the input address is NULL
- */
-uint8_t HAL_getFuncAddress(const void *const funcAddress);
-
-
-/*
- * @brief:    Transmits data via the LPUART0 peripheral
- * @param[in] data: Pointer to the data buffer to be transmitted
- * @param[in] size: Size of the data buffer to be transmitted
- * @return:   None
- */
-void HAL_TransmitData(const uint8_t *const data, const uint32_t size);
-
-
-/*
- * @brief:    Sets the baud rate used for communication in the HAL layer
- * @param[in] baud rate: The baud rate to be set
- * @return:   None
- */
-void HAL_SetBaudrate(const uint32_t baudrate);
-
-
-/*
- * @brief:
- * @param[in] startAddress: The starting address in flash memory for the erase operation
- * @param[in] size: The number of sector to be erased
- * @return:   0 for success, non-zero for error
- */
-uint8_t HAL_eraseFlash(const uint32_t startAddress, const uint32_t size);
-
-
-/*
- * @brief:  Checks the state of the specified button
- * @param:  None
- * @return: 0 if the button is pressed, 1 if it is not pressed
+ * @brief: Board wiring of one LPUART the bootloader listens on
  */
-uint8_t HAL_switchIsPressed(void);
-
-
-/*
- * @brief:  Returns the status of the data push operation to the queue
- * @return: 1 if the data push to the queue failed, 0 if it succeeded
- */
-uint8_t HAL_pushDataFailed(void);
-
-
-/*
- * @brief:  Jumps to the application code located at the specified address
- * @detail: This function disables interrupts, clears pending interrupt requests, sets the vector table offset,
- *          sets the main stack pointer, and jumps to the entry point of the user's application code
- * @param[in] appAddress: The starting address of the application code
- * @return: None
- */
-void HAL_jumpApplication(const uint32_t appAddress);
-
-
-void HAL_backupApplication(const uint32_t appAddress,
-                           const uint32_t backupAddress,
-                           const uint32_t appSize);
-
-
-void HAL_restoreApplication(const uint32_t restoreAddress,
-                            const uint32_t backupAddress,
-                            const uint32_t appSize);
+typedef struct
+{
+    LPUART_Type *base;           /* LPUART base pointer */
+    IRQn_Type   irq;             /* Its interrupt */
+    uint32_t    portClock;       /* PCC index of the PORT of its pins */
+    PORT_Type   *rxPort;
+    GPIO_Type   *rxGpio;         /* Used to poll the RX pin while the baud rate is measured */
+    uint8_t     rxPin;
+    PORT_Type   *txPort;
+    uint8_t     txPin;
+    Port_Mux_t  mux;             /* LPUART function of the RX and TX pins */
+    uint8_t     flowControl;     /* TRUE when the RTS/CTS lines are wired to the host */
+} HAL_Port_t;
 
 #endif /* _INC_HAL_H_ */
 /*******************************************************************************
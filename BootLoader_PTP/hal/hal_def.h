@@ -0,0 +1,424 @@
+/*
+ * hal_def.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_HAL_DEF_H_
+#define _INC_HAL_DEF_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "dri_def.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_TRANSPORT_LPUART  0U      /* The host talks to the LPUARTs of HAL_PORT_MASK */
+#define HAL_TRANSPORT_LPSPI   1U      /* The host is an SPI master talking to LPSPI0 */
+#define HAL_TRANSPORT_LPI2C   2U      /* The host is an I2C master talking to LPI2C0 */
+#define HAL_TRANSPORT_MSCAN   3U      /* The host sends ISO-TP style messages over MSCAN */
+#define HAL_TRANSPORT_LOOPBACK  4U    /* The host is a program exchanging memory buffers with HAL_loopbackWrite/Read */
+#ifndef HAL_TRANSPORT
+#define HAL_TRANSPORT         HAL_TRANSPORT_LPUART
+#endif
+
+#if (HAL_TRANSPORT_LPUART == HAL_TRANSPORT)
+#define HAL_PORT_COUNT        3U      /* Entries of the port table, one per LPUART, checked in hal.h */
+#else
+#define HAL_PORT_COUNT        1U      /* LPSPI0, LPI2C0, MSCAN or the loopback is the only port */
+#endif
+#define HAL_PORT_NONE         0xFFU   /* No port has been locked onto yet */
+#ifndef HAL_PORT_MASK
+#define HAL_PORT_MASK         0x07U   /* Bit n set to listen on LPUARTn */
+#endif
+
+#ifndef HAL_TX_BUFFER_SIZE
+#define HAL_TX_BUFFER_SIZE    128U    /* Characters waiting for the transmit interrupt, a power of two */
+#endif
+
+#if ((HAL_TX_BUFFER_SIZE & (HAL_TX_BUFFER_SIZE - 1U)) != 0U) || (HAL_TX_BUFFER_SIZE > 32768U)
+#error "HAL_TX_BUFFER_SIZE must be a power of two, 32768 at most"
+#endif
+
+#ifndef HAL_LOOPBACK_BUFFER_SIZE
+#define HAL_LOOPBACK_BUFFER_SIZE  256U  /* Characters of each loopback ring, a power of two */
+#endif
+
+#if ((HAL_LOOPBACK_BUFFER_SIZE & (HAL_LOOPBACK_BUFFER_SIZE - 1U)) != 0U) || (HAL_LOOPBACK_BUFFER_SIZE > 32768U)
+#error "HAL_LOOPBACK_BUFFER_SIZE must be a power of two, 32768 at most"
+#endif
+
+#define HAL_POLL_BURST        32U     /* Characters HAL_poll reads from the transport at once */
+
+#define SWITCH_PRESSED        0U
+
+#define HAL_XON               0x11U   /* DC1: the host may resume sending */
+#define HAL_XOFF              0x13U   /* DC3: the host must pause sending */
+
+#define HAL_BAUDRATE_AUTO     0U      /* Baud rate measured on the sync character sent by the host */
+#define HAL_AUTOBAUD_SYNC     0x55U   /* 'U': a falling edge every two bit times */
+#define HAL_AUTOBAUD_DEFAULT  115200U /* Baud rate of the LPUART until it is measured, and if it cannot be */
+#define HAL_AUTOBAUD_TIMEOUT  2000U   /* Milliseconds given to the host to send its sync character */
+#define HAL_AUTOBAUD_BITS     8U      /* Bit times from the start bit to the last falling edge of the sync */
+#define HAL_AUTOBAUD_IDLE     12U     /* Bit times of idle line awaited before the receiver is enabled */
+#define HAL_BAUDRATE_TOLERANCE  32U   /* A baud rate is supported within 1/32 (about 3%) of the request */
+
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef int8_t (*funcMid)(const uint8_t port, const uint8_t data);
+typedef int8_t (*funcMidError)(const uint8_t port);
+typedef int8_t (*funcMidBurst)(const uint8_t port, const uint8_t *const data, const uint32_t count);
+typedef void (*funcTxDone)(void);
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Receive errors of one port since HAL_Init
+ */
+typedef struct
+{
+    uint32_t overrun;    /* Receive FIFO overruns, characters were lost */
+    uint32_t framing;    /* Characters without their stop bit, dropped */
+    uint32_t noise;      /* Characters sampled with noise, kept */
+    uint32_t parity;     /* Characters with a parity error, dropped */
+} HAL_RxErrors_t;
+
+
+/*
+ * @brief: Operations of a transport, called by the HAL on behalf of the middle layer.
+ *         A transport either pushes the received characters from its interrupt with
+ *         HAL_receiveData, or leaves rxAvailable and readBurst for HAL_poll to pull them
+ */
+typedef struct
+{
+    void     (*init)(void);                   /* Starts listening, called by HAL_Init */
+    void     (*deInit)(void);                 /* Stops once the data waiting to be sent has been sent */
+    void     (*lock)(const uint8_t port);     /* Stops listening on every port but one */
+    uint32_t (*rxAvailable)(const uint8_t port);  /* Characters readBurst can return, NULL if pushed */
+    uint32_t (*readBurst)(const uint8_t port, uint8_t *const data, const uint32_t size);
+    uint32_t (*writeAsync)(const uint8_t *const data, const uint32_t size);  /* Bytes accepted */
+    uint8_t  (*txBusy)(void);                 /* TRUE while data is waiting or being sent */
+    void     (*setTxCallback)(const funcTxDone funcAddress);
+    void     (*flowControl)(const uint8_t pause);
+    const HAL_RxErrors_t* (*rxErrors)(const uint8_t port);
+    uint8_t  (*isBaudrateSupported)(const uint32_t baudrate);  /* NULL when the transport has no baud rate */
+    void     (*changeBaudrate)(const uint32_t baudrate);
+    uint32_t (*detectBaudrate)(void);         /* NULL when there is nothing to measure */
+} HAL_Transport_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Only the transport selected by HAL_TRANSPORT is built */
+extern const HAL_Transport_t g_lpuartTransport;
+extern const HAL_Transport_t g_lpspiTransport;
+extern const HAL_Transport_t g_lpi2cTransport;
+extern const HAL_Transport_t g_mscanTransport;
+extern const HAL_Transport_t g_loopbackTransport;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:    Replaces the transport selected by HAL_TRANSPORT, such as a host-side implementation
+ *            used to run the bootloader off target
+ * @param[in] transport: The operations of the transport, NULL keeps the current one
+ * @return:   None
+ * @note:     Must be called before HAL_Init
+ */
+void HAL_setTransport(const HAL_Transport_t *const transport);
+
+
+/*
+ * @brief:  Initializes the hardware abstraction layer (HAL).
+ *          Every LPUART of HAL_PORT_MASK is started and listened on at once,
+ *          or LPSPI0 / LPI2C0 as a slave, or MSCAN, when HAL_TRANSPORT selects it
+ * @param:  None
+ * @return: None
+ * @note:   The functions of the middle layer are set before, as the receive interrupts
+ *          may run as soon as they are enabled
+ */
+void HAL_Init(void);
+
+
+/*
+ * @brief:  De-initializes the hardware abstraction layer (HAL)
+ * @param:  None
+ * @return: None
+ * @note:   Waits for the data still in the transmit ring to be sent first
+ */
+void HAL_DeInit(void);
+
+
+/*
+ * @brief:  Hands the characters a polled transport has received over to the middle layer,
+ *          as HAL_receiveData does from the interrupt of the other transports
+ * @return: None
+ * @note:   Returns at once when the transport pushes its characters from its interrupt.
+ *          Stops early when the transport is paused by HAL_requestFlowControl
+ */
+void HAL_poll(void);
+
+
+/*
+ * @brief:    Sets the address of a function from a higher layer in the system.
+ *            It is called from the transport interrupt, or from HAL_poll, with the port each character came from
+ * @param[in] funcAddress The address of the function to be set
+ * @return:   0 if the function address is successfully set, 1 if the input address is NULL
+ * @note:     With LPSPI0, every byte the master clocks in is passed on, the port is always 0
+ */
+uint8_t HAL_getFuncAddress(const void *const funcAddress);
+
+
+/*
+ * @brief:    Sets the function called from the LPUART interrupts when received characters are
+ *            lost (overrun) or dropped (framing or parity error), so that the record being
+ *            received can be given up
+ * @param[in] funcAddress The address of the function to be set
+ * @return:   0 if the function address is successfully set, 1 if the input address is NULL
+ */
+uint8_t HAL_getErrorFuncAddress(const void *const funcAddress);
+
+
+/*
+ * @brief:    Sets the function called with the characters received together, from HAL_poll or
+ *            the MSCAN interrupt. Without it, they are passed on one by one to the function set
+ *            with HAL_getFuncAddress
+ * @param[in] funcAddress The address of the function to be set
+ * @return:   0 if the function address is successfully set, 1 if the input address is NULL
+ */
+uint8_t HAL_getBurstFuncAddress(const void *const funcAddress);
+
+
+/*
+ * @brief:    Gets the receive error counters of a port, to tune the baud rate
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+const HAL_RxErrors_t* HAL_getRxErrors(const uint8_t port);
+
+
+/*
+ * @brief:    Keeps listening on one port only, once it has delivered a valid record.
+ *            The receive interrupts of the other ports are turned off, and from now on
+ *            data is only sent on this port
+ * @param[in] port: Index of the port, the LPUART instance
+ * @return:   None
+ */
+void HAL_lockPort(const uint8_t port);
+
+
+/*
+ * @brief:  Gets the port the bootloader is locked onto
+ * @return: Index of the port, HAL_PORT_NONE while every port is listened on
+ */
+uint8_t HAL_getLockedPort(void);
+
+
+/*
+ * @brief:    Transmits data on the locked port, or on every port until one is locked.
+ *            The data is copied into the transmit ring and sent by the transport interrupt
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes queued, size unless some were dropped
+ * @note:     Returns as soon as the data is in the ring, it only waits while the ring is full.
+ *            A polled transport (the loopback) has no interrupt to empty its ring while this
+ *            waits, so what does not fit is dropped instead
+ */
+uint32_t HAL_TransmitData(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:    Queues data for the locked port, or every port until one is locked, without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted, less than size when the transmit ring is full
+ * @note:     Until a port is locked, the data is only accepted if it fits every ring, so 0 or size
+ */
+uint32_t HAL_TransmitDataAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Check if the transmission is still in progress on any port data is sent on
+ * @return: TRUE while characters are waiting or being sent, FALSE once the line is idle
+ */
+uint8_t HAL_TransmitBusy(void);
+
+
+/*
+ * @brief:    Sets the function called from the LPUART interrupt once all queued data has been sent.
+ *            Until a port is locked, it is called once for each port
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+void HAL_setTransmitCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Ask the host to pause or resume sending.
+ *            With HAL_HARDWARE_FLOW_CONTROL, the receive interrupt is turned off so that the
+ *            receiver fills up and negates RTS. Otherwise XOFF/XON is written by the LPUART
+ *            interrupt as soon as the transmitter is free. Either way the caller never waits
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ * @note:     Only the last XON/XOFF is sent if several come before the transmitter is free.
+ *            With LPSPI0, the busy pin is driven high instead and the master waits for it to fall.
+ *            With LPI2C0, received bytes are left unread so that SCL is stretched.
+ *            With MSCAN, the next flow control frame is a wait instead of clear to send.
+ *            With the loopback, HAL_loopbackWrite refuses characters and HAL_poll leaves the rest unread
+ */
+void HAL_requestFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:    Sets the baud rate used for communication in the HAL layer
+ * @param[in] baud rate: The baud rate to be set, HAL_BAUDRATE_AUTO to measure it with HAL_detectBaudrate
+ * @return:   None
+ */
+void HAL_SetBaudrate(const uint32_t baudrate);
+
+
+/*
+ * @brief:  Gets the baud rate in use
+ * @return: The baud rate, HAL_BAUDRATE_AUTO until it has been measured
+ */
+uint32_t HAL_getBaudrate(void);
+
+
+/*
+ * @brief:    Checks if the LPUARTs can run at a baud rate, within HAL_BAUDRATE_TOLERANCE
+ * @param[in] baudrate: The baud rate to be checked
+ * @return:   TRUE if the baud rate is supported, FALSE otherwise. Always FALSE with LPSPI0,
+ *            or LPI2C0, whose clock is given by the master, and with MSCAN or the loopback
+ */
+uint8_t HAL_isBaudrateSupported(const uint32_t baudrate);
+
+
+/*
+ * @brief:    Switches the locked port, or every port until one is locked, to another baud rate once the data being sent has left the line.
+ *            The characters received but not yet read are dropped
+ * @param[in] baudrate: The new baud rate, checked with HAL_isBaudrateSupported
+ * @return:   None
+ */
+void HAL_changeBaudrate(const uint32_t baudrate);
+
+
+/*
+ * @brief:    Starts a timeout measured with SysTick on the core clock
+ * @param[in] microseconds: Length of the timeout, up to 2^24 core clock cycles
+ * @return:   None
+ * @note:     SysTick is left free-running, as MID_PROFILE uses it
+ */
+void HAL_timeoutStart(const uint32_t microseconds);
+
+
+/*
+ * @brief:  Checks if the timeout started by HAL_timeoutStart has expired
+ * @return: TRUE once the timeout has expired, FALSE before
+ * @note:   Must be called at least once per SysTick period (2^24 cycles)
+ */
+uint8_t HAL_timeoutExpired(void);
+
+
+/*
+ * @brief:  Measures the baud rate of the host on its sync character (HAL_AUTOBAUD_SYNC) and
+ *          programs every port with it. The RX pins are polled as a GPIO and its falling edges are
+ *          timed with SysTick, from the start bit to the start of bit 7 (8 bit times).
+ *          The port whose RX line falls first is measured, and the receivers are enabled again
+ *          once its line has been idle for HAL_AUTOBAUD_IDLE bits
+ * @return: The baud rate in use
+ * @note:   Returns at once if a fixed baud rate was set. Otherwise waits up to HAL_AUTOBAUD_TIMEOUT
+ *          for the host to send a sync character, so the host repeats it, with a pause, until it
+ *          gets an answer. Without a valid sync in time, HAL_AUTOBAUD_DEFAULT is kept.
+ *          SysTick is borrowed and restored, its counter starts over
+ */
+uint32_t HAL_detectBaudrate(void);
+
+
+/*
+ * @brief:
+ * @param[in] startAddress: The starting address in flash memory for the erase operation
+ * @param[in] size: The number of sector to be erased
+ * @return:   0 for success, non-zero for error
+ */
+uint8_t HAL_eraseFlash(const uint32_t startAddress, const uint32_t size);
+
+
+/*
+ * @brief:  Checks the state of the specified button
+ * @param:  None
+ * @return: 0 if the button is pressed, 1 if it is not pressed
+ */
+uint8_t HAL_switchIsPressed(void);
+
+
+/*
+ * @brief:  Checks if the host has asked to start the application (HAL_I2C_REG_JUMP)
+ * @return: TRUE once the jump command has been received, FALSE otherwise.
+ *          Always FALSE on transports without such a command
+ */
+uint8_t HAL_jumpRequested(void);
+
+
+/*
+ * @brief:  Returns the status of the data push operation to the queue, for the locked port
+ *          or for any port until one is locked
+ * @return: 1 if the data push to the queue failed, 0 if it succeeded
+ */
+uint8_t HAL_pushDataFailed(void);
+
+
+/*
+ * @brief:    Hands characters sent by the host over to the loopback transport
+ * @param[in] data: Pointer to the characters
+ * @param[in] size: Number of characters
+ * @return:   The number of characters accepted, less than size when the ring is full,
+ *            0 while the bootloader has paused the host
+ */
+uint32_t HAL_loopbackWrite(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:    Takes the replies of the bootloader out of the loopback transport
+ * @param[in] data: Pointer to the buffer to fill
+ * @param[in] size: Size of the buffer
+ * @return:   The number of characters copied
+ */
+uint32_t HAL_loopbackRead(uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Jumps to the application code located at the specified address
+ * @detail: This function disables interrupts, clears pending interrupt requests, sets the vector table offset,
+ *          sets the main stack pointer, and jumps to the entry point of the user's application code
+ * @param[in] appAddress: The starting address of the application code (its vector table)
+ * @param[in] entryPoint: The address to branch to, 0 to use the reset vector of the application
+ * @return: None
+ */
+void HAL_jumpApplication(const uint32_t appAddress, const uint32_t entryPoint);
+
+
+void HAL_backupApplication(const uint32_t appAddress,
+                           const uint32_t backupAddress,
+                           const uint32_t appSize);
+
+
+void HAL_restoreApplication(const uint32_t restoreAddress,
+                            const uint32_t backupAddress,
+                            const uint32_t appSize);
+
+#endif /* _INC_HAL_DEF_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
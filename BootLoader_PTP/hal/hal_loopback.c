@@ -0,0 +1,335 @@
+/*
+ * hal_loopback.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal_transport.h"
+
+#if (HAL_TRANSPORT_LOOPBACK == HAL_TRANSPORT)
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_LOOPBACK_PORT         0U       /* Index given to the loopback in the middle layer */
+#define HAL_LOOPBACK_MASK         (HAL_LOOPBACK_BUFFER_SIZE - 1U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t           g_rxBuffer[HAL_LOOPBACK_BUFFER_SIZE];  /* Characters sent by the host, not read yet */
+static volatile uint16_t g_rxHead;      /* Free-running index of the next character written by the host */
+static volatile uint16_t g_rxTail;      /* Free-running index of the next character read by HAL_poll */
+static uint8_t           g_txBuffer[HAL_LOOPBACK_BUFFER_SIZE];  /* Replies waiting to be read by the host */
+static volatile uint16_t g_txHead;      /* Free-running index of the next character written by the caller */
+static volatile uint16_t g_txTail;      /* Free-running index of the next character read by the host */
+static funcTxDone        g_txCallback;
+static HAL_RxErrors_t    g_rxErrors;    /* Stays zero, memory loses nothing */
+static volatile uint8_t  g_paused;      /* TRUE while the host must not send */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Empties both rings, called by HAL_Init
+ * @return: None
+ */
+static void HAL_loopbackInit(void);
+
+
+/*
+ * @brief:  Nothing to stop, the replies stay in memory for the host
+ * @return: None
+ */
+static void HAL_loopbackDeInit(void);
+
+
+/*
+ * @brief:    The loopback is the only port, there is nothing else to stop
+ * @param[in] port: Index of the port locked onto
+ * @return:   None
+ */
+static void HAL_loopbackLock(const uint8_t port);
+
+
+/*
+ * @brief:    Gets the number of characters HAL_loopbackReadBurst can return
+ * @param[in] port: Index of the port
+ * @return:   The characters waiting, 0 while the host is paused
+ */
+static uint32_t HAL_loopbackRxAvailable(const uint8_t port);
+
+
+/*
+ * @brief:     Takes the characters sent by the host out of the receive ring
+ * @param[in]  port: Index of the port
+ * @param[out] data: Pointer to the buffer to fill
+ * @param[in]  size: Size of the buffer
+ * @return:    The number of characters copied, 0 while the host is paused
+ */
+static uint32_t HAL_loopbackReadBurst(const uint8_t port, uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:    Queues replies for the host without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted, less than size when the host has not read enough
+ */
+static uint32_t HAL_loopbackWriteAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  The replies are handed over as soon as they are in the ring
+ * @return: FALSE
+ */
+static uint8_t HAL_loopbackTxBusy(void);
+
+
+/*
+ * @brief:    Sets the function called once the host has read every reply
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+static void HAL_loopbackSetTxCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Pauses or resumes the host, HAL_loopbackWrite refuses characters while paused
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ */
+static void HAL_loopbackFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:    Gets the receive error counters of the loopback
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+static const HAL_RxErrors_t* HAL_loopbackRxErrors(const uint8_t port);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Operations of the loopback, whose characters are pulled by HAL_poll as there is no interrupt */
+const HAL_Transport_t g_loopbackTransport =
+{
+    .init                = HAL_loopbackInit,
+    .deInit              = HAL_loopbackDeInit,
+    .lock                = HAL_loopbackLock,
+    .rxAvailable         = HAL_loopbackRxAvailable,
+    .readBurst           = HAL_loopbackReadBurst,
+    .writeAsync          = HAL_loopbackWriteAsync,
+    .txBusy              = HAL_loopbackTxBusy,
+    .setTxCallback       = HAL_loopbackSetTxCallback,
+    .flowControl         = HAL_loopbackFlowControl,
+    .rxErrors            = HAL_loopbackRxErrors,
+    .isBaudrateSupported = NULL,
+    .changeBaudrate      = NULL,
+    .detectBaudrate      = NULL,
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Hands characters sent by the host over to the loopback transport
+ */
+uint32_t HAL_loopbackWrite(const uint8_t *const data, const uint32_t size)
+{
+    uint16_t head     = g_rxHead;
+    uint32_t room     = HAL_LOOPBACK_BUFFER_SIZE - (uint16_t)(head - g_rxTail);
+    uint32_t accepted = (size < room) ? size : room;
+    uint32_t index    = 0U;
+
+    /* A paused host holds its characters, as it would on a wire */
+    if (TRUE == g_paused)
+    {
+        accepted = 0U;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    for (index = 0U; index < accepted; ++index)
+    {
+        g_rxBuffer[(uint16_t)(head + index) & HAL_LOOPBACK_MASK] = data[index];
+    }
+    /* Published once the characters are in the ring */
+    g_rxHead = (uint16_t)(head + accepted);
+
+    return accepted;
+}
+
+
+/*
+ * @brief: Takes the replies of the bootloader out of the loopback transport
+ */
+uint32_t HAL_loopbackRead(uint8_t *const data, const uint32_t size)
+{
+    uint16_t tail   = g_txTail;
+    uint32_t queued = (uint16_t)(g_txHead - tail);
+    uint32_t copied = (size < queued) ? size : queued;
+    uint32_t index  = 0U;
+
+    for (index = 0U; index < copied; ++index)
+    {
+        data[index] = g_txBuffer[(uint16_t)(tail + index) & HAL_LOOPBACK_MASK];
+    }
+    g_txTail = (uint16_t)(tail + copied);
+
+    /* The host has read the last reply */
+    if ((0U != copied) && (copied == queued) && (NULL != g_txCallback))
+    {
+        g_txCallback();
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return copied;
+}
+
+
+/*
+ * @brief: Empties both rings
+ */
+static void HAL_loopbackInit(void)
+{
+    g_rxHead = 0U;
+    g_rxTail = 0U;
+    g_txHead = 0U;
+    g_txTail = 0U;
+    g_paused = FALSE;
+    (void)memset(&g_rxErrors, 0, sizeof(g_rxErrors));
+}
+
+
+/*
+ * @brief: Nothing to stop
+ */
+static void HAL_loopbackDeInit(void)
+{
+    /* Do Nothing */
+}
+
+
+/*
+ * @brief: The loopback is the only port, there is nothing else to stop
+ */
+static void HAL_loopbackLock(const uint8_t port)
+{
+    (void)port;
+}
+
+
+/*
+ * @brief: Gets the number of characters waiting in the receive ring
+ */
+static uint32_t HAL_loopbackRxAvailable(const uint8_t port)
+{
+    uint32_t available = 0U;
+
+    if ((HAL_LOOPBACK_PORT == port) && (FALSE == g_paused))
+    {
+        available = (uint16_t)(g_rxHead - g_rxTail);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return available;
+}
+
+
+/*
+ * @brief: Takes the characters sent by the host out of the receive ring
+ */
+static uint32_t HAL_loopbackReadBurst(const uint8_t port, uint8_t *const data, const uint32_t size)
+{
+    uint16_t tail     = g_rxTail;
+    uint32_t waiting  = HAL_loopbackRxAvailable(port);
+    uint32_t copied   = (size < waiting) ? size : waiting;
+    uint32_t index    = 0U;
+
+    for (index = 0U; index < copied; ++index)
+    {
+        data[index] = g_rxBuffer[(uint16_t)(tail + index) & HAL_LOOPBACK_MASK];
+    }
+    g_rxTail = (uint16_t)(tail + copied);
+
+    return copied;
+}
+
+
+/*
+ * @brief: Queues replies for the host without ever waiting
+ */
+static uint32_t HAL_loopbackWriteAsync(const uint8_t *const data, const uint32_t size)
+{
+    uint16_t head     = g_txHead;
+    uint32_t room     = HAL_LOOPBACK_BUFFER_SIZE - (uint16_t)(head - g_txTail);
+    uint32_t accepted = (size < room) ? size : room;
+    uint32_t index    = 0U;
+
+    for (index = 0U; index < accepted; ++index)
+    {
+        g_txBuffer[(uint16_t)(head + index) & HAL_LOOPBACK_MASK] = data[index];
+    }
+    /* Published once the characters are in the ring */
+    g_txHead = (uint16_t)(head + accepted);
+
+    return accepted;
+}
+
+
+/*
+ * @brief: The replies are handed over as soon as they are in the ring
+ */
+static uint8_t HAL_loopbackTxBusy(void)
+{
+    return FALSE;
+}
+
+
+/*
+ * @brief: Sets the function called once the host has read every reply
+ */
+static void HAL_loopbackSetTxCallback(const funcTxDone funcAddress)
+{
+    g_txCallback = funcAddress;
+}
+
+
+/*
+ * @brief: Pauses or resumes the host
+ */
+static void HAL_loopbackFlowControl(const uint8_t pause)
+{
+    g_paused = pause;
+}
+
+
+/*
+ * @brief: Gets the receive error counters of the loopback
+ */
+static const HAL_RxErrors_t* HAL_loopbackRxErrors(const uint8_t port)
+{
+    return (port < HAL_PORT_COUNT) ? &g_rxErrors : NULL;
+}
+
+#endif /* HAL_TRANSPORT */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
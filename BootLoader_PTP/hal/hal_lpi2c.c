@@ -0,0 +1,434 @@
+/*
+ * hal_lpi2c.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal.h"
+#include "hal_transport.h"
+
+#if (HAL_TRANSPORT_LPI2C == HAL_TRANSPORT)
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_LPI2C0_IRQHandler     LPI2C0_IRQHandler
+
+#define HAL_I2C_PORT              0U       /* Index given to LPI2C0 in the middle layer */
+#define HAL_I2C_INTERRUPTS        (LPI2C_SIER_AVIE_MASK | LPI2C_SIER_RDIE_MASK | LPI2C_SIER_TDIE_MASK \
+                                   | LPI2C_SIER_SDIE_MASK | LPI2C_SIER_FEIE_MASK)
+#define HAL_I2C_CLEAR_FLAGS       (LPI2C_SSR_RSF_MASK | LPI2C_SSR_SDF_MASK | LPI2C_SSR_BEF_MASK | LPI2C_SSR_FEF_MASK)
+#define HAL_I2C_CLOCK_HOLD        2U       /* SCL low time after a stall, about 40 ns at 48 MHz */
+#define HAL_I2C_DATA_VALID        2U       /* SDA set-up after SCL falls, about 40 ns at 48 MHz */
+#define HAL_I2C_GLITCH_FILTER     2U       /* Up to 50 ns spikes are ignored, as Fast-mode Plus requires */
+#define HAL_I2C_DRAIN_TIMEOUT     100000U  /* Microseconds the master is given to read the last replies */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t           g_txBuffer[HAL_TX_BUFFER_SIZE];  /* Replies waiting to be read by the master */
+static volatile uint16_t g_txHead;      /* Free-running index of the next character written by the caller */
+static volatile uint16_t g_txTail;      /* Free-running index of the next character read by the master */
+static funcTxDone        g_txCallback;
+static HAL_RxErrors_t    g_rxErrors;
+static uint8_t           g_register;    /* Register of the current transfer */
+static uint8_t           g_registerNext;  /* TRUE when the next byte written selects the register */
+static uint8_t           g_readIndex;   /* Bytes of the register read so far in the current transfer */
+static volatile uint8_t  g_paused;      /* TRUE while image bytes must be left unread */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Starts LPI2C0, called by HAL_Init
+ * @return: None
+ */
+static void HAL_lpi2cInit(void);
+
+
+/*
+ * @brief:  Stops LPI2C0 once the replies have been sent, or the host has given up
+ * @return: None
+ */
+static void HAL_lpi2cDeInit(void);
+
+
+/*
+ * @brief:    LPI2C0 is the only port, there is nothing to stop
+ * @param[in] port: Index of the port locked onto
+ * @return:   None
+ */
+static void HAL_lpi2cLock(const uint8_t port);
+
+
+/*
+ * @brief:    Leaves image bytes unread while paused, so that SCL is stretched
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ */
+static void HAL_lpi2cFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:    Queues replies in the transmit ring without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted
+ */
+static uint32_t HAL_lpi2cWriteAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Checks if replies are waiting or being sent
+ * @return: TRUE while replies are in flight, FALSE otherwise
+ */
+static uint8_t HAL_lpi2cTxBusy(void);
+
+
+/*
+ * @brief:    Sets the function called once all queued replies have been sent
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+static void HAL_lpi2cSetTxCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Gets the receive error counters of LPI2C0
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+static const HAL_RxErrors_t* HAL_lpi2cRxErrors(const uint8_t port);
+
+
+/*
+ * @brief:    Hands a byte written by the master to the register selected by the transfer
+ * @param[in] data: The received byte
+ * @return:   None
+ */
+static void HAL_writeRegister(const uint8_t data);
+
+
+/*
+ * @brief:  Gets the next byte of the register read by the master
+ * @return: The byte to send
+ */
+static uint8_t HAL_readRegister(void);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Operations of LPI2C0, the register writes are pushed from its interrupt */
+const HAL_Transport_t g_lpi2cTransport =
+{
+    .init                = HAL_lpi2cInit,
+    .deInit              = HAL_lpi2cDeInit,
+    .lock                = HAL_lpi2cLock,
+    .rxAvailable         = NULL,
+    .readBurst           = NULL,
+    .writeAsync          = HAL_lpi2cWriteAsync,
+    .txBusy              = HAL_lpi2cTxBusy,
+    .setTxCallback       = HAL_lpi2cSetTxCallback,
+    .flowControl         = HAL_lpi2cFlowControl,
+    .rxErrors            = HAL_lpi2cRxErrors,
+    .isBaudrateSupported = NULL,
+    .changeBaudrate      = NULL,
+    .detectBaudrate      = NULL,
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: LPI2C0 interrupt handler.
+ *         The slave stalls SCL at every step until it has been served here, so the bus
+ *         runs at the master's speed whenever the pipeline keeps up
+ */
+void HAL_LPI2C0_IRQHandler(void)
+{
+    uint32_t status  = LPI2C0->SSR;
+    uint32_t address = 0U;
+
+    /* A transfer starts: a write begins with the register, a read sends it from its first byte */
+    if (0U != (status & LPI2C_SSR_AVF_MASK))
+    {
+        address = LPI2C_SlaveReadAddress(LPI2C0);
+        if (0U == (address & 0x01U))
+        {
+            g_registerNext = TRUE;
+        }
+        else
+        {
+            g_readIndex = 0U;
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (0U != (status & LPI2C_SSR_RDF_MASK))
+    {
+        if ((FALSE == g_registerNext) && (HAL_I2C_REG_BLOCK == g_register) && (TRUE == g_paused))
+        {
+            /* The byte is left unread, so SCL is stretched until HAL_requestFlowControl resumes */
+            LPI2C_SlaveSetInterrupts(LPI2C0, 0U, LPI2C_SIER_RDIE_MASK);
+        }
+        else
+        {
+            HAL_writeRegister(LPI2C_SlaveReceiveByte(LPI2C0));
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (0U != (status & LPI2C_SSR_TDF_MASK))
+    {
+        LPI2C_SlaveTransmitByte(LPI2C0, HAL_readRegister());
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* Only raised if a stall could not hold the bus: a received byte was lost */
+    if (0U != (status & LPI2C_SSR_FEF_MASK))
+    {
+        g_rxErrors.overrun++;
+        HAL_receiveError(HAL_I2C_PORT);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    LPI2C_SlaveClearStatusFlags(LPI2C0, status & HAL_I2C_CLEAR_FLAGS);
+}
+
+
+/*
+ * @brief: Start LPI2C0 as a slave at HAL_I2C_ADDRESS
+ */
+static void HAL_lpi2cInit(void)
+{
+    /* Port initialization structure */
+    PORT_InitTypeDef PORT_InitStruct =
+    {
+        .Mux  = LPI2C0_MUX,
+        .Pull = PORT_PULL_UP,
+    };
+
+    /* LPI2C initialization structure */
+    LPI2C_SlaveInitTypeDef LPI2C_InitStruct =
+    {
+        .Address        = HAL_I2C_ADDRESS,
+        .AddressStall   = TRUE,
+        .ReceiveStall   = TRUE,
+        .TransmitStall  = TRUE,
+        .ClockHold      = HAL_I2C_CLOCK_HOLD,
+        .DataValidDelay = HAL_I2C_DATA_VALID,
+        .GlitchFilter   = HAL_I2C_GLITCH_FILTER
+    };
+
+    /* Configure Pins for LPI2C function */
+    DRI_CLOCK_EnableClock(PCC_PORTA_INDEX);
+    DRI_PORT_Pin_Init(LPI2C0_SDA_PORT, LPI2C0_SDA_PIN, &PORT_InitStruct);
+    DRI_PORT_Pin_Init(LPI2C0_SCL_PORT, LPI2C0_SCL_PIN, &PORT_InitStruct);
+
+    g_txHead       = 0U;
+    g_txTail       = 0U;
+    g_register     = 0U;
+    g_registerNext = FALSE;
+    g_readIndex    = 0U;
+    g_paused       = FALSE;
+    (void)memset(&g_rxErrors, 0, sizeof(g_rxErrors));
+
+    /* Initialize the LPI2C module and enable its interrupt */
+    DRI_LPI2C_SlaveInit(LPI2C0, &LPI2C_InitStruct);
+    LPI2C_SlaveSetInterrupts(LPI2C0, HAL_I2C_INTERRUPTS, 0U);
+    NVIC_EnableIRQ(LPI2C0_IRQn);
+}
+
+
+/*
+ * @brief: Stop LPI2C0 once the master has read the replies, or has given up
+ */
+static void HAL_lpi2cDeInit(void)
+{
+    HAL_timeoutStart(HAL_I2C_DRAIN_TIMEOUT);
+    while ((TRUE == HAL_lpi2cTxBusy()) && (FALSE == HAL_timeoutExpired()))
+    {
+        /* Wait for the master to read the replies */
+    }
+    NVIC_DisableIRQ(LPI2C0_IRQn);            /* Disable interrupt */
+    DRI_LPI2C_SlaveDeInit(LPI2C0);
+    DRI_CLOCK_DisableClock(PCC_PORTA_INDEX); /* Disable clock for LPI2C0 PORT */
+}
+
+
+/*
+ * @brief: LPI2C0 is the only port, there is nothing else to stop
+ */
+static void HAL_lpi2cLock(const uint8_t port)
+{
+    (void)port;
+}
+
+
+/*
+ * @brief: Stretch SCL on the next image byte, or release it
+ */
+static void HAL_lpi2cFlowControl(const uint8_t pause)
+{
+    g_paused = pause;
+    if ((FALSE == pause) && (0U == (LPI2C0->SIER & LPI2C_SIER_RDIE_MASK)))
+    {
+        /* A byte is waiting in SRDR: read it from the interrupt handler now */
+        LPI2C_SlaveSetInterrupts(LPI2C0, LPI2C_SIER_RDIE_MASK, 0U);
+        NVIC_SetPendingIRQ(LPI2C0_IRQn);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Queue replies for the master to read without ever waiting
+ */
+static uint32_t HAL_lpi2cWriteAsync(const uint8_t *const data, const uint32_t size)
+{
+    uint16_t head     = g_txHead;
+    uint32_t room     = HAL_TX_BUFFER_SIZE - (uint16_t)(head - g_txTail);
+    uint32_t accepted = (size < room) ? size : room;
+    uint32_t index    = 0U;
+
+    for (index = 0U; index < accepted; ++index)
+    {
+        g_txBuffer[(uint16_t)(head + index) & (HAL_TX_BUFFER_SIZE - 1U)] = data[index];
+    }
+    /* Published once the characters are in the ring */
+    g_txHead = (uint16_t)(head + accepted);
+
+    return accepted;
+}
+
+
+/*
+ * @brief: Check if replies are waiting to be read
+ */
+static uint8_t HAL_lpi2cTxBusy(void)
+{
+    return (g_txHead != g_txTail) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Sets the function called once all queued replies have been read
+ */
+static void HAL_lpi2cSetTxCallback(const funcTxDone funcAddress)
+{
+    g_txCallback = funcAddress;
+}
+
+
+/*
+ * @brief: Gets the receive error counters of LPI2C0
+ */
+static const HAL_RxErrors_t* HAL_lpi2cRxErrors(const uint8_t port)
+{
+    return (port < HAL_PORT_COUNT) ? &g_rxErrors : NULL;
+}
+
+
+/*
+ * @brief: Hands a byte written by the master to the register selected by the transfer
+ */
+static void HAL_writeRegister(const uint8_t data)
+{
+    if (TRUE == g_registerNext)
+    {
+        g_register     = data;
+        g_registerNext = FALSE;
+    }
+    else if (HAL_I2C_REG_BLOCK == g_register)
+    {
+        HAL_receiveData(HAL_I2C_PORT, data);
+    }
+    else if ((HAL_I2C_REG_JUMP == g_register) && (HAL_I2C_JUMP_KEY == data))
+    {
+        HAL_requestJump();
+    }
+    else
+    {
+        /* Do Nothing: the other registers are read-only */
+    }
+}
+
+
+/*
+ * @brief: Gets the next byte of the register read by the master
+ */
+static uint8_t HAL_readRegister(void)
+{
+    uint8_t  data    = HAL_I2C_IDLE_BYTE;
+    uint16_t tail    = g_txTail;
+    uint16_t waiting = (uint16_t)(g_txHead - tail);
+
+    if ((HAL_I2C_REG_STATUS == g_register) && (0U == g_readIndex))
+    {
+        data = ((TRUE == g_paused) ? HAL_I2C_STATUS_BUSY : 0U)
+             | ((0U != g_rxErrors.overrun) ? HAL_I2C_STATUS_ERROR : 0U)
+             | ((0U != waiting) ? HAL_I2C_STATUS_REPLY : 0U)
+             | ((TRUE == HAL_jumpRequested()) ? HAL_I2C_STATUS_JUMP : 0U);
+    }
+    else if ((HAL_I2C_REG_STATUS == g_register) && (1U == g_readIndex))
+    {
+        data = (waiting > 0xFFU) ? 0xFFU : (uint8_t)waiting;
+    }
+    else if ((HAL_I2C_REG_REPLY == g_register) && (0U != waiting))
+    {
+        data     = g_txBuffer[tail & (HAL_TX_BUFFER_SIZE - 1U)];
+        g_txTail = (uint16_t)(tail + 1U);
+
+        /* The last reply byte has been handed to the master */
+        if ((1U == waiting) && (NULL != g_txCallback))
+        {
+            g_txCallback();
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (g_readIndex < 0xFFU)
+    {
+        g_readIndex++;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return data;
+}
+
+#endif /* HAL_TRANSPORT */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
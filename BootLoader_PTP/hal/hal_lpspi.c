@@ -0,0 +1,352 @@
+/*
+ * hal_lpspi.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal.h"
+#include "hal_transport.h"
+
+#if (HAL_TRANSPORT_LPSPI == HAL_TRANSPORT)
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_LPSPI0_IRQHandler     LPSPI0_IRQHandler
+
+#define HAL_SPI_PORT              0U       /* Index given to LPSPI0 in the middle layer */
+#define HAL_SPI_FRAME_SIZE        8U       /* One character per frame */
+#define HAL_SPI_RX_WATERMARK      0U       /* Interrupt on every received character */
+#define HAL_SPI_RX_ERROR_FLAGS    (LPSPI_SR_REF_MASK | LPSPI_SR_TEF_MASK)
+#define HAL_SPI_DRAIN_TIMEOUT     100000U  /* Microseconds the master is given to clock the last replies out */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t           g_txBuffer[HAL_TX_BUFFER_SIZE];  /* Replies waiting to be clocked out by the master */
+static volatile uint16_t g_txHead;      /* Free-running index of the next character written by the caller */
+static volatile uint16_t g_txTail;      /* Free-running index of the next character sent by the interrupt */
+static volatile uint8_t  g_txActive;    /* TRUE while the last reply character is still being shifted out */
+static funcTxDone        g_txCallback;
+static HAL_RxErrors_t    g_rxErrors;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Starts LPSPI0, called by HAL_Init
+ * @return: None
+ */
+static void HAL_lpspiInit(void);
+
+
+/*
+ * @brief:  Stops LPSPI0 once the replies have been sent, or the host has given up
+ * @return: None
+ */
+static void HAL_lpspiDeInit(void);
+
+
+/*
+ * @brief:    LPSPI0 is the only port, there is nothing to stop
+ * @param[in] port: Index of the port locked onto
+ * @return:   None
+ */
+static void HAL_lpspiLock(const uint8_t port);
+
+
+/*
+ * @brief:    Drives the busy pin, high while the master must not send
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ */
+static void HAL_lpspiFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:    Queues replies in the transmit ring without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted
+ */
+static uint32_t HAL_lpspiWriteAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Checks if replies are waiting or being sent
+ * @return: TRUE while replies are in flight, FALSE otherwise
+ */
+static uint8_t HAL_lpspiTxBusy(void);
+
+
+/*
+ * @brief:    Sets the function called once all queued replies have been sent
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+static void HAL_lpspiSetTxCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Gets the receive error counters of LPSPI0
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+static const HAL_RxErrors_t* HAL_lpspiRxErrors(const uint8_t port);
+
+
+/*
+ * @brief:  Writes the character shifted out on the next frame: the next reply character,
+ *          or HAL_SPI_IDLE_BYTE while no reply is waiting
+ * @return: None
+ */
+static void HAL_refillTransmit(void);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Operations of LPSPI0, bytes are pushed from its interrupt and the master gives the clock */
+const HAL_Transport_t g_lpspiTransport =
+{
+    .init                = HAL_lpspiInit,
+    .deInit              = HAL_lpspiDeInit,
+    .lock                = HAL_lpspiLock,
+    .rxAvailable         = NULL,
+    .readBurst           = NULL,
+    .writeAsync          = HAL_lpspiWriteAsync,
+    .txBusy              = HAL_lpspiTxBusy,
+    .setTxCallback       = HAL_lpspiSetTxCallback,
+    .flowControl         = HAL_lpspiFlowControl,
+    .rxErrors            = HAL_lpspiRxErrors,
+    .isBaudrateSupported = NULL,
+    .changeBaudrate      = NULL,
+    .detectBaudrate      = NULL,
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: LPSPI0 interrupt handler.
+ *         For every character the master clocks in, the next one to shift out is written,
+ *         so the transmit FIFO always holds one character ahead of the master
+ */
+void HAL_LPSPI0_IRQHandler(void)
+{
+    uint32_t status = LPSPI0->SR;
+    uint8_t  data   = 0U;
+
+    while (FALSE == LPSPI_ReceiveEmpty(LPSPI0))
+    {
+        data = (uint8_t)LPSPI_ReceiveWord(LPSPI0);
+        HAL_refillTransmit();
+        HAL_receiveData(HAL_SPI_PORT, data);
+    }
+
+    /* The receive FIFO overflowed: characters were lost */
+    if (0U != (status & LPSPI_SR_REF_MASK))
+    {
+        g_rxErrors.overrun++;
+        HAL_receiveError(HAL_SPI_PORT);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* A transmit underrun only shifts out a filler the master ignores */
+    LPSPI_ClearStatusFlags(LPSPI0, status & HAL_SPI_RX_ERROR_FLAGS);
+}
+
+
+/*
+ * @brief: Start LPSPI0 as a slave, with the busy pin high until it is ready
+ */
+static void HAL_lpspiInit(void)
+{
+    /* Port initialization structure */
+    PORT_InitTypeDef PORT_InitStruct =
+    {
+        .Mux  = PORT_MUX_GPIO,
+        .Pull = PORT_PULL_UP,
+    };
+
+    /* GPIO initialization structure */
+    GPIO_InitTypeDef GPIO_InitStruct =
+    {
+        .Direction   = GPIO_OUTPUT,
+        .OutputLogic = GPIO_PIN_SET,
+    };
+
+    /* LPSPI initialization structure */
+    LPSPI_SlaveInitTypeDef LPSPI_InitStruct =
+    {
+        .ClockPolarity = LPSPI_CLOCK_IDLE_LOW,
+        .ClockPhase    = LPSPI_CAPTURE_LEADING,
+        .FrameSize     = HAL_SPI_FRAME_SIZE,
+        .ChipSelect    = LPSPI0_PCS,
+        .LSBFirst      = FALSE,
+        .RxWatermark   = HAL_SPI_RX_WATERMARK,
+        .TxWatermark   = 0U
+    };
+
+    /* The master waits while the busy pin is high */
+    DRI_PORT_Pin_Init(LPSPI0_BUSY_PORT, LPSPI0_BUSY_PIN, &PORT_InitStruct);
+    DRI_GPIO_Init(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN, &GPIO_InitStruct);
+
+    /* Configure Pins for LPSPI function */
+    DRI_CLOCK_EnableClock(PCC_PORTB_INDEX);
+    PORT_InitStruct.Mux = LPSPI0_MUX;
+    DRI_PORT_Pin_Init(LPSPI0_SCK_PORT, LPSPI0_SCK_PIN, &PORT_InitStruct);
+    DRI_PORT_Pin_Init(LPSPI0_SIN_PORT, LPSPI0_SIN_PIN, &PORT_InitStruct);
+    DRI_PORT_Pin_Init(LPSPI0_SOUT_PORT, LPSPI0_SOUT_PIN, &PORT_InitStruct);
+    DRI_PORT_Pin_Init(LPSPI0_PCS_PORT, LPSPI0_PCS_PIN, &PORT_InitStruct);
+
+    g_txHead   = 0U;
+    g_txTail   = 0U;
+    g_txActive = FALSE;
+    (void)memset(&g_rxErrors, 0, sizeof(g_rxErrors));
+
+    /* Initialize the LPSPI module, with the first character to shift out ready */
+    DRI_LPSPI_SlaveInit(LPSPI0, &LPSPI_InitStruct);
+    LPSPI_TransmitWord(LPSPI0, HAL_SPI_IDLE_BYTE);
+    LPSPI_EnableInterrupts(LPSPI0, LPSPI_IER_RDIE_MASK | LPSPI_IER_REIE_MASK);
+    NVIC_EnableIRQ(LPSPI0_IRQn);
+
+    /* Ready for the master */
+    DRI_GPIO_WritePin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN, GPIO_PIN_RESET);
+}
+
+
+/*
+ * @brief: Stop LPSPI0 once the master has clocked the replies out, or has given up
+ */
+static void HAL_lpspiDeInit(void)
+{
+    HAL_timeoutStart(HAL_SPI_DRAIN_TIMEOUT);
+    while ((TRUE == HAL_lpspiTxBusy()) && (FALSE == HAL_timeoutExpired()))
+    {
+        /* Wait for the master to clock the replies out */
+    }
+    NVIC_DisableIRQ(LPSPI0_IRQn);            /* Disable interrupt */
+    DRI_LPSPI_DeInit(LPSPI0);
+    DRI_GPIO_WritePin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN, GPIO_PIN_SET);
+    DRI_CLOCK_DisableClock(PCC_PORTB_INDEX); /* Disable clock for LPSPI0 PORT */
+}
+
+
+/*
+ * @brief: LPSPI0 is the only port, there is nothing else to stop
+ */
+static void HAL_lpspiLock(const uint8_t port)
+{
+    (void)port;
+}
+
+
+/*
+ * @brief: Ask the master to pause or resume sending with the busy pin
+ */
+static void HAL_lpspiFlowControl(const uint8_t pause)
+{
+    DRI_GPIO_WritePin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN,
+                      (TRUE == pause) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+
+/*
+ * @brief: Queue replies for the master to clock out without ever waiting
+ */
+static uint32_t HAL_lpspiWriteAsync(const uint8_t *const data, const uint32_t size)
+{
+    uint16_t head     = g_txHead;
+    uint32_t room     = HAL_TX_BUFFER_SIZE - (uint16_t)(head - g_txTail);
+    uint32_t accepted = (size < room) ? size : room;
+    uint32_t index    = 0U;
+
+    for (index = 0U; index < accepted; ++index)
+    {
+        g_txBuffer[(uint16_t)(head + index) & (HAL_TX_BUFFER_SIZE - 1U)] = data[index];
+    }
+    /* Published once the characters are in the ring */
+    g_txHead = (uint16_t)(head + accepted);
+
+    return accepted;
+}
+
+
+/*
+ * @brief: Check if replies are waiting or being shifted out
+ */
+static uint8_t HAL_lpspiTxBusy(void)
+{
+    return ((g_txHead != g_txTail) || (TRUE == g_txActive)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Sets the function called once all queued replies have been shifted out
+ */
+static void HAL_lpspiSetTxCallback(const funcTxDone funcAddress)
+{
+    g_txCallback = funcAddress;
+}
+
+
+/*
+ * @brief: Gets the receive error counters of LPSPI0
+ */
+static const HAL_RxErrors_t* HAL_lpspiRxErrors(const uint8_t port)
+{
+    return (port < HAL_PORT_COUNT) ? &g_rxErrors : NULL;
+}
+
+
+/*
+ * @brief: Writes the character shifted out on the next frame
+ */
+static void HAL_refillTransmit(void)
+{
+    uint16_t tail = g_txTail;
+
+    if (g_txHead != tail)
+    {
+        LPSPI_TransmitWord(LPSPI0, g_txBuffer[tail & (HAL_TX_BUFFER_SIZE - 1U)]);
+        g_txTail   = (uint16_t)(tail + 1U);
+        g_txActive = TRUE;
+    }
+    else
+    {
+        LPSPI_TransmitWord(LPSPI0, HAL_SPI_IDLE_BYTE);
+
+        /* The frame just received shifted the last reply character out */
+        if (TRUE == g_txActive)
+        {
+            g_txActive = FALSE;
+            if (NULL != g_txCallback)
+            {
+                g_txCallback();
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+#endif /* HAL_TRANSPORT */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,873 @@
+/*
+ * hal_lpuart.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal.h"
+#include "hal_transport.h"
+
+#if (HAL_TRANSPORT_LPUART == HAL_TRANSPORT)
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_LPUART0_IRQHandler    LPUART0_IRQHandler
+#define HAL_LPUART1_IRQHandler    LPUART1_IRQHandler
+#define HAL_LPUART2_IRQHandler    LPUART2_IRQHandler
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t   g_txBuffer[HAL_PORT_COUNT][HAL_TX_BUFFER_SIZE];
+static LPUART_TxRing_t g_txRing[HAL_PORT_COUNT];  /* Characters waiting for the transmit interrupt of each port */
+static HAL_RxErrors_t g_rxErrors[HAL_PORT_COUNT];
+static uint32_t  g_autobaudWraps;  /* SysTick periods left before the baud rate measurement gives up */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Starts listening on every LPUART of HAL_PORT_MASK, called by HAL_Init
+ * @return: None
+ */
+static void HAL_lpuartInit(void);
+
+
+/*
+ * @brief:  Stops the LPUARTs once the data still in their transmit rings has been sent
+ * @return: None
+ */
+static void HAL_lpuartDeInit(void);
+
+
+/*
+ * @brief:    Stops receiving on every LPUART but the locked one
+ * @param[in] port: Index of the port locked onto
+ * @return:   None
+ */
+static void HAL_lpuartLock(const uint8_t port);
+
+
+/*
+ * @brief:    Asks the host to pause or resume sending, with RTS or XOFF/XON
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ */
+static void HAL_lpuartFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:  Measures the baud rate of the host on its sync character and programs every port with it
+ * @return: The measured baud rate
+ */
+static uint32_t HAL_lpuartDetectBaudrate(void);
+
+
+/*
+ * @brief:    Checks if the LPUARTs can run at a baud rate, within HAL_BAUDRATE_TOLERANCE
+ * @param[in] baudrate: The baud rate to be checked
+ * @return:   TRUE if the baud rate is supported, FALSE otherwise
+ */
+static uint8_t HAL_lpuartIsBaudrateSupported(const uint32_t baudrate);
+
+
+/*
+ * @brief:    Switches the ports in use to another baud rate once the data being sent has left the line
+ * @param[in] baudrate: The new baud rate
+ * @return:   None
+ */
+static void HAL_lpuartChangeBaudrate(const uint32_t baudrate);
+
+
+/*
+ * @brief:    Queues data for the locked port, or every port until one is locked, without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted, 0 or size until a port is locked
+ */
+static uint32_t HAL_lpuartWriteAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Checks if the transmission is still in progress on any port in use
+ * @return: TRUE while characters are waiting or being sent, FALSE once the lines are idle
+ */
+static uint8_t HAL_lpuartTxBusy(void);
+
+
+/*
+ * @brief:    Sets the function called once all queued data has been sent, on every port
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+static void HAL_lpuartSetTxCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Gets the receive error counters of a port
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+static const HAL_RxErrors_t* HAL_lpuartRxErrors(const uint8_t port);
+
+
+/*
+ * @brief:    Checks if data is sent on a port: the locked one, or every port of HAL_PORT_MASK before
+ * @param[in] port: Index of the port
+ * @return:   TRUE if the port is in use, FALSE otherwise
+ */
+static uint8_t HAL_isPortActive(const uint8_t port);
+
+
+/*
+ * @brief:  Counts the SysTick periods of the baud rate measurement
+ * @return: TRUE once HAL_AUTOBAUD_TIMEOUT has elapsed, FALSE before
+ * @note:   Must be called at least once per SysTick period (2^24 cycles)
+ */
+static uint8_t HAL_autobaudExpired(void);
+
+
+/*
+ * @brief:    Waits for the RX line of a port to reach a level, until HAL_AUTOBAUD_TIMEOUT
+ * @param[in] port: Index of the port
+ * @param[in] level: 0U for low, non-zero for high
+ * @return:   The SysTick value when the level was seen
+ */
+static uint32_t HAL_waitRxLevel(const uint8_t port, const uint32_t level);
+
+
+/*
+ * @brief:  Waits for the RX line of any port to fall, until HAL_AUTOBAUD_TIMEOUT
+ * @return: Index of the port, HAL_PORT_NONE on timeout
+ */
+static uint8_t HAL_waitRxActivity(void);
+
+
+/*
+ * @brief:    Times the falling edges of one sync character on the RX line of a port
+ * @param[in] port: Index of the port
+ * @return:   The SysTick ticks of HAL_AUTOBAUD_BITS bit times, 0 if the character is not a sync
+ *            or HAL_AUTOBAUD_TIMEOUT has elapsed
+ */
+static uint32_t HAL_measureSync(const uint8_t port);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Wiring of every LPUART, indexed by instance. Only the ports of HAL_PORT_MASK are used */
+static const HAL_Port_t s_ports[HAL_PORT_COUNT] =
+{
+    {
+        .base        = LPUART0,
+        .irq         = LPUART0_IRQn,
+        .portClock   = PCC_PORTB_INDEX,
+        .rxPort      = LPUART0_SDA_RX_PORT,
+        .rxGpio      = LPUART0_SDA_RX_GPIO,
+        .rxPin       = LPUART0_SDA_RX_PIN,
+        .txPort      = LPUART0_SDA_TX_PORT,
+        .txPin       = LPUART0_SDA_TX_PIN,
+        .mux         = PORT_MUX_ALT2,
+        .flowControl = HAL_HARDWARE_FLOW_CONTROL,
+    },
+    {
+        .base        = LPUART1,
+        .irq         = LPUART1_IRQn,
+        .portClock   = PCC_PORTC_INDEX,
+        .rxPort      = LPUART1_RX_PORT,
+        .rxGpio      = LPUART1_RX_GPIO,
+        .rxPin       = LPUART1_RX_PIN,
+        .txPort      = LPUART1_TX_PORT,
+        .txPin       = LPUART1_TX_PIN,
+        .mux         = PORT_MUX_ALT2,
+        .flowControl = FALSE,
+    },
+    {
+        .base        = LPUART2,
+        .irq         = LPUART2_IRQn,
+        .portClock   = PCC_PORTD_INDEX,
+        .rxPort      = LPUART2_RX_PORT,
+        .rxGpio      = LPUART2_RX_GPIO,
+        .rxPin       = LPUART2_RX_PIN,
+        .txPort      = LPUART2_TX_PORT,
+        .txPin       = LPUART2_TX_PIN,
+        .mux         = PORT_MUX_ALT2,
+        .flowControl = FALSE,
+    },
+};
+
+/* Operations of the LPUARTs, received characters are pushed from their interrupts */
+const HAL_Transport_t g_lpuartTransport =
+{
+    .init                = HAL_lpuartInit,
+    .deInit              = HAL_lpuartDeInit,
+    .lock                = HAL_lpuartLock,
+    .rxAvailable         = NULL,
+    .readBurst           = NULL,
+    .writeAsync          = HAL_lpuartWriteAsync,
+    .txBusy              = HAL_lpuartTxBusy,
+    .setTxCallback       = HAL_lpuartSetTxCallback,
+    .flowControl         = HAL_lpuartFlowControl,
+    .rxErrors            = HAL_lpuartRxErrors,
+    .isBaudrateSupported = HAL_lpuartIsBaudrateSupported,
+    .changeBaudrate      = HAL_lpuartChangeBaudrate,
+    .detectBaudrate      = HAL_lpuartDetectBaudrate,
+};
+
+/*
+ * @brief:    Interrupt handler body shared by every port
+ * @param[in] port: Index of the port
+ */
+static void HAL_LPUART_IRQHandler(const uint8_t port)
+{
+    LPUART_Type *const base   = s_ports[port].base;
+    uint32_t           status = base->STAT;
+    uint32_t           data   = 0U;
+
+    /* Re-arm the idle line detection before draining, so the next burst raises it again.
+     * The error flags only tell that an error happened, the characters carry their own */
+    LPUART_ClearStatusFlags(base, status & (LPUART_STAT_IDLE_MASK | LPUART_STAT_NF_MASK
+                                            | LPUART_STAT_FE_MASK | LPUART_STAT_PF_MASK));
+
+    /* Drain every received character, the watermark (RDRF) and the idle line both end up here.
+     * Stop early if the receiver was paused on the way, the rest then holds RTS negated */
+    while ((FALSE == LPUART_IsReceiveEmpty(base))
+           && (0U != (base->CTRL & LPUART_CTRL_RIE_MASK)))
+    {
+        data = base->DATA;
+
+        if (0U != (data & LPUART_DATA_NOISY_MASK))
+        {
+            /* The majority of the samples still gave the bit values */
+            g_rxErrors[port].noise++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if (0U != (data & (LPUART_DATA_FRETSC_MASK | LPUART_DATA_PARITYE_MASK)))
+        {
+            /* The character cannot be trusted: drop it and give the record up */
+            g_rxErrors[port].framing += (0U != (data & LPUART_DATA_FRETSC_MASK)) ? 1U : 0U;
+            g_rxErrors[port].parity  += (0U != (data & LPUART_DATA_PARITYE_MASK)) ? 1U : 0U;
+            HAL_receiveError(port);
+        }
+        else
+        {
+            /* Push received character into Queue */
+            HAL_receiveData(port, (uint8_t)data);
+        }
+    }
+
+    /* Nothing is received while OR is set: the receive FIFO holds what came before the lost
+     * characters, so it is drained first, then the record is given up and reception resumes */
+    if (0U != (status & LPUART_STAT_OR_MASK))
+    {
+        g_rxErrors[port].overrun++;
+        HAL_receiveError(port);
+        LPUART_ClearStatusFlags(base, LPUART_STAT_OR_MASK);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* Send the pending XON/XOFF and the transmit ring */
+    DRI_LPUART_TransmitIRQHandler(base, &g_txRing[port]);
+}
+
+
+/*
+ * @brief: LPUART0 interrupt handler
+ */
+void HAL_LPUART0_IRQHandler(void)
+{
+    HAL_LPUART_IRQHandler(0U);
+}
+
+
+/*
+ * @brief: LPUART1 interrupt handler
+ */
+void HAL_LPUART1_IRQHandler(void)
+{
+    HAL_LPUART_IRQHandler(1U);
+}
+
+
+/*
+ * @brief: LPUART2 interrupt handler
+ */
+void HAL_LPUART2_IRQHandler(void)
+{
+    HAL_LPUART_IRQHandler(2U);
+}
+
+/*
+ * @brief: Start listening on every LPUART of HAL_PORT_MASK
+ */
+static void HAL_lpuartInit(void)
+{
+    /* Port initialization structure */
+    PORT_InitTypeDef PORT_InitStruct =
+    {
+        .Mux  = PORT_MUX_ALT2,
+        .Pull = PORT_PULL_UP,
+    };
+
+    uint32_t baudrate = HAL_getBaudrate();
+
+    /* LPUART initialization structure */
+    LPUART_InitTypeDef LPUART_InitStruct =
+    {
+        .BaudRate            = (HAL_BAUDRATE_AUTO == baudrate) ? HAL_AUTOBAUD_DEFAULT : baudrate,
+        .Parity              = LPUART_NO_PARITY,
+        .Mode                = LPUART_8_BITS_MODE,
+        .StopBit             = LPUART_ONE_STOP_BIT,
+        .MSBFirst            = FALSE,
+        .ReceiveInverted     = FALSE,
+        .TransmitInverted    = FALSE,
+        .HardwareFlowControl = FALSE,
+        .RTSWatermark        = HAL_RTS_WATERMARK,
+        .ReceiveFifo         = TRUE,
+        .RxWatermark         = HAL_RX_WATERMARK,
+        .IdleConfig          = HAL_IDLE_CONFIG,
+        .TransmitFifo        = TRUE,
+        .TxWatermark         = HAL_TX_WATERMARK
+    };
+
+    uint8_t port = 0U;
+
+    /* Configure Pins for the RTS/CTS lines */
+    if (TRUE == HAL_HARDWARE_FLOW_CONTROL)
+    {
+        DRI_CLOCK_EnableClock(PCC_PORTC_INDEX);                           /* Enable clock for RTS/CTS PORT */
+        PORT_InitStruct.Mux = LPUART0_RTS_CTS_MUX;
+        DRI_PORT_Pin_Init(LPUART0_CTS_PORT, LPUART0_CTS_PIN, &PORT_InitStruct);  /* PORTC-PIN8: CTS Pin */
+        DRI_PORT_Pin_Init(LPUART0_RTS_PORT, LPUART0_RTS_PIN, &PORT_InitStruct);  /* PORTC-PIN9: RTS Pin */
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    (void)memset(g_rxErrors, 0, sizeof(g_rxErrors));
+
+    /* Listen on every port at once */
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (0U != (HAL_PORT_MASK & (1U << port)))
+        {
+            g_txRing[port].buffer   = g_txBuffer[port];
+            g_txRing[port].mask     = HAL_TX_BUFFER_SIZE - 1U;
+            g_txRing[port].head     = 0U;
+            g_txRing[port].tail     = 0U;
+            g_txRing[port].priority = 0U;
+
+            /* Configure Pins for LPUART function */
+            DRI_CLOCK_EnableClock(s_ports[port].portClock);
+            PORT_InitStruct.Mux = s_ports[port].mux;
+            DRI_PORT_Pin_Init(s_ports[port].rxPort, s_ports[port].rxPin, &PORT_InitStruct);
+            DRI_PORT_Pin_Init(s_ports[port].txPort, s_ports[port].txPin, &PORT_InitStruct);
+
+            /* Initialize the LPUART module and enable its interrupt */
+            LPUART_InitStruct.HardwareFlowControl = s_ports[port].flowControl;
+            DRI_LPUART_Init(s_ports[port].base, &LPUART_InitStruct);
+            LPUART_EnableInterrupts(s_ports[port].base, HAL_RX_INTERRUPTS);
+            NVIC_EnableIRQ(s_ports[port].irq);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+
+/*
+ * @brief: Stop the LPUARTs once the data still in their transmit rings has been sent
+ */
+static void HAL_lpuartDeInit(void)
+{
+    uint8_t port = 0U;
+
+    while (TRUE == HAL_lpuartTxBusy())
+    {
+        /* Wait for the transmit rings to be sent */
+    }
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (0U != (HAL_PORT_MASK & (1U << port)))
+        {
+            /* Nothing may be received once the application owns the LPUART */
+            DRI_LPUART_SetInterrupts(s_ports[port].base, 0U,
+                    HAL_RX_INTERRUPTS | LPUART_CTRL_TIE_MASK | LPUART_CTRL_TCIE_MASK);
+            NVIC_DisableIRQ(s_ports[port].irq);              /* Disable interrupt */
+            /* PORTD also carries SW3, which is still read after the HAL is stopped:
+             * its clock is left on, as HAL_Init enabled it for the button */
+            if (PCC_PORTD_INDEX != s_ports[port].portClock)
+            {
+                DRI_CLOCK_DisableClock(s_ports[port].portClock); /* Disable clock for its PORT */
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+
+/*
+ * @brief: Stop receiving on every LPUART but the locked one
+ */
+static void HAL_lpuartLock(const uint8_t port)
+{
+    uint8_t other = 0U;
+
+    for (other = 0U; other < HAL_PORT_COUNT; ++other)
+    {
+        if ((other != port) && (0U != (HAL_PORT_MASK & (1U << other))))
+        {
+            /* What is still in its transmit ring is sent out */
+            DRI_LPUART_SetInterrupts(s_ports[other].base, 0U, HAL_RX_INTERRUPTS);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+
+/*
+ * @brief: Ask the host to pause or resume sending
+ */
+static void HAL_lpuartFlowControl(const uint8_t pause)
+{
+    uint8_t port = 0U;
+
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (FALSE == HAL_isPortActive(port))
+        {
+            /* Do Nothing */
+        }
+        else if (TRUE == s_ports[port].flowControl)
+        {
+            /* Characters left in the receiver hold RTS negated until they are read again */
+            if (TRUE == pause)
+            {
+                DRI_LPUART_SetInterrupts(s_ports[port].base, 0U, HAL_RX_INTERRUPTS);
+            }
+            else
+            {
+                DRI_LPUART_SetInterrupts(s_ports[port].base, HAL_RX_INTERRUPTS, 0U);
+                /* The line stays idle while RTS is negated, so characters below the watermark
+                 * raise neither RDRF nor IDLE: drain them from the interrupt handler now */
+                NVIC_SetPendingIRQ(s_ports[port].irq);
+            }
+        }
+        else
+        {
+            DRI_LPUART_TransmitPriority(s_ports[port].base, &g_txRing[port],
+                                        (TRUE == pause) ? HAL_XOFF : HAL_XON);
+        }
+    }
+}
+
+
+/*
+ * @brief: Measures the baud rate of the host on its sync character
+ */
+static uint32_t HAL_lpuartDetectBaudrate(void)
+{
+    PORT_InitTypeDef PORT_InitStruct =
+    {
+        .Mux  = PORT_MUX_GPIO,
+        .Pull = PORT_PULL_UP,
+    };
+    GPIO_InitTypeDef GPIO_InitStruct =
+    {
+        .Direction = GPIO_INPUT,
+    };
+    uint32_t sysTickCtrl = SysTick->CTRL;
+    uint32_t sysTickLoad = SysTick->LOAD;
+    uint32_t ticks       = 0U;
+    uint32_t idleTicks   = 0U;
+    uint32_t start       = 0U;
+    uint32_t baudrate    = 0U;
+    uint8_t  port        = 0U;
+    uint8_t  measured    = 0U;
+
+    /* Free-running SysTick on the core clock, without interrupt */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL  = 0U;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    g_autobaudWraps = (((HAL_AUTOBAUD_TIMEOUT * (SystemCoreClock / 1000U)) >> 24U) + 1U);
+
+    /* Take the RX pins away from the LPUARTs */
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (0U != (HAL_PORT_MASK & (1U << port)))
+        {
+            DRI_PORT_Pin_Init(s_ports[port].rxPort, s_ports[port].rxPin, &PORT_InitStruct);
+            DRI_GPIO_Init(s_ports[port].rxGpio, s_ports[port].rxPin, &GPIO_InitStruct);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    /* Measure on the port the host is sending on */
+    while ((0U == ticks) && (FALSE == HAL_autobaudExpired()))
+    {
+        measured = HAL_waitRxActivity();
+        ticks    = (HAL_PORT_NONE != measured) ? HAL_measureSync(measured) : 0U;
+    }
+
+    if (0U != ticks)
+    {
+        /* Wait for a pause of the host, so that the receiver starts between two characters */
+        idleTicks = (ticks * HAL_AUTOBAUD_IDLE) / HAL_AUTOBAUD_BITS;
+        start     = HAL_waitRxLevel(measured, 1U);
+        while ((((start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk) < idleTicks) && (FALSE == HAL_autobaudExpired()))
+        {
+            if (0U == (s_ports[measured].rxGpio->PDIR & (1UL << s_ports[measured].rxPin)))
+            {
+                start = HAL_waitRxLevel(measured, 1U);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        baudrate = (SystemCoreClock * HAL_AUTOBAUD_BITS) / ticks;
+    }
+    else
+    {
+        /* No sync from the host in time: keep the fixed rate */
+        baudrate = HAL_AUTOBAUD_DEFAULT;
+    }
+
+    /* Every port runs at the measured rate, and gets its RX pin back */
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (0U != (HAL_PORT_MASK & (1U << port)))
+        {
+            DRI_LPUART_ChangeBaudRate(s_ports[port].base, baudrate);
+            PORT_InitStruct.Mux = s_ports[port].mux;
+            DRI_PORT_Pin_Init(s_ports[port].rxPort, s_ports[port].rxPin, &PORT_InitStruct);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    SysTick->LOAD = sysTickLoad;
+    SysTick->VAL  = 0U;
+    SysTick->CTRL = sysTickCtrl;
+
+    return baudrate;
+}
+
+
+/*
+ * @brief: Checks if the LPUARTs can run at a baud rate
+ */
+static uint8_t HAL_lpuartIsBaudrateSupported(const uint32_t baudrate)
+{
+    uint8_t  supported = FALSE;
+    uint32_t actual    = DRI_LPUART_GetBaudRate(baudrate);
+    uint32_t error     = (actual > baudrate) ? (actual - baudrate) : (baudrate - actual);
+
+    if ((0U != actual) && (error <= (baudrate / HAL_BAUDRATE_TOLERANCE)))
+    {
+        supported = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return supported;
+}
+
+
+/*
+ * @brief: Switches the ports in use to another baud rate once the data being sent has left the line
+ */
+static void HAL_lpuartChangeBaudrate(const uint32_t baudrate)
+{
+    uint8_t port = 0U;
+
+    while (TRUE == HAL_lpuartTxBusy())
+    {
+        /* Wait for the transmit rings to be sent at the current baud rate */
+    }
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if (TRUE == HAL_isPortActive(port))
+        {
+            DRI_LPUART_ChangeBaudRate(s_ports[port].base, baudrate);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+
+/*
+ * @brief: Queues data for the ports in use without ever waiting
+ */
+static uint32_t HAL_lpuartWriteAsync(const uint8_t *const data, const uint32_t size)
+{
+    uint32_t accepted = size;
+    uint8_t  locked   = HAL_getLockedPort();
+    uint8_t  port     = 0U;
+
+    if (HAL_PORT_NONE != locked)
+    {
+        accepted = DRI_LPUART_TransmitAsync(s_ports[locked].base, &g_txRing[locked], data, size);
+    }
+    else
+    {
+        /* The same data must go out on every port, so it goes into all rings or none */
+        for (port = 0U; port < HAL_PORT_COUNT; ++port)
+        {
+            if ((0U != (HAL_PORT_MASK & (1U << port))) && (DRI_LPUART_TransmitFree(&g_txRing[port]) < size))
+            {
+                accepted = 0U;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+
+        for (port = 0U; (port < HAL_PORT_COUNT) && (0U != accepted); ++port)
+        {
+            if (0U != (HAL_PORT_MASK & (1U << port)))
+            {
+                (void)DRI_LPUART_TransmitAsync(s_ports[port].base, &g_txRing[port], data, size);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+
+    return accepted;
+}
+
+
+/*
+ * @brief: Check if the transmission is still in progress on any port in use
+ */
+static uint8_t HAL_lpuartTxBusy(void)
+{
+    uint8_t busy = FALSE;
+    uint8_t port = 0U;
+
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        if ((TRUE == HAL_isPortActive(port))
+                && (TRUE == DRI_LPUART_TransmitBusy(s_ports[port].base, &g_txRing[port])))
+        {
+            busy = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return busy;
+}
+
+
+/*
+ * @brief: Sets the function called once all queued data has been sent
+ */
+static void HAL_lpuartSetTxCallback(const funcTxDone funcAddress)
+{
+    uint8_t port = 0U;
+
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        g_txRing[port].callback = funcAddress;
+    }
+}
+
+
+/*
+ * @brief: Gets the receive error counters of a port
+ */
+static const HAL_RxErrors_t* HAL_lpuartRxErrors(const uint8_t port)
+{
+    return (port < HAL_PORT_COUNT) ? &g_rxErrors[port] : NULL;
+}
+
+
+/*
+ * @brief: Checks if data is sent on a port
+ */
+static uint8_t HAL_isPortActive(const uint8_t port)
+{
+    uint8_t locked = HAL_getLockedPort();
+
+    return (((HAL_PORT_NONE == locked) && (0U != (HAL_PORT_MASK & (1U << port))))
+            || (port == locked)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Counts the SysTick periods of the baud rate measurement
+ */
+static uint8_t HAL_autobaudExpired(void)
+{
+    /* COUNTFLAG is cleared by reading it */
+    if ((0U != g_autobaudWraps) && (0U != (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk)))
+    {
+        g_autobaudWraps--;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return (0U == g_autobaudWraps) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Waits for the RX line of a port to reach a level, until HAL_AUTOBAUD_TIMEOUT
+ */
+static uint32_t HAL_waitRxLevel(const uint8_t port, const uint32_t level)
+{
+    GPIO_Type *const gpio = s_ports[port].rxGpio;
+    const uint32_t   mask = 1UL << s_ports[port].rxPin;
+    const uint32_t   want = (0U != level) ? mask : 0U;
+
+    while (((gpio->PDIR & mask) != want) && (FALSE == HAL_autobaudExpired()))
+    {
+        /* Keep the loop short, its period is the resolution of the measurement */
+    }
+
+    return SysTick->VAL;
+}
+
+
+/*
+ * @brief: Waits for the RX line of any port to fall, until HAL_AUTOBAUD_TIMEOUT
+ */
+static uint8_t HAL_waitRxActivity(void)
+{
+    uint8_t port   = 0U;
+    uint8_t active = HAL_PORT_NONE;
+
+    while ((HAL_PORT_NONE == active) && (FALSE == HAL_autobaudExpired()))
+    {
+        for (port = 0U; port < HAL_PORT_COUNT; ++port)
+        {
+            if ((0U != (HAL_PORT_MASK & (1U << port)))
+                    && (0U == (s_ports[port].rxGpio->PDIR & (1UL << s_ports[port].rxPin))))
+            {
+                active = port;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+
+    return active;
+}
+
+
+/*
+ * @brief: Times the falling edges of one sync character on the RX line of a port.
+ *         The character that woke HAL_waitRxActivity up may be caught anywhere, so timing
+ *         starts at the first character after a pause of the host
+ */
+static uint32_t HAL_measureSync(const uint8_t port)
+{
+    uint32_t edges[(HAL_AUTOBAUD_BITS / 2U) + 1U];
+    uint32_t index   = 0U;
+    uint32_t span    = 0U;
+    uint32_t period  = 0U;
+    uint32_t rise    = 0U;
+    uint32_t high    = 0U;
+    uint32_t minHigh = SysTick_LOAD_RELOAD_Msk;
+    uint8_t  aligned = FALSE;
+
+    /* Every high level of the sync character lasts one bit, the stop bit and the pause after it
+     * last at least twice as long: the fall that ends them is the start bit of a fresh character */
+    while ((FALSE == aligned) && (FALSE == HAL_autobaudExpired()))
+    {
+        rise      = HAL_waitRxLevel(port, 1U);
+        edges[0U] = HAL_waitRxLevel(port, 0U);
+        high      = (rise - edges[0U]) & SysTick_LOAD_RELOAD_Msk;
+        if (high > (2U * minHigh))
+        {
+            aligned = TRUE;
+        }
+        else if (high < minHigh)
+        {
+            minHigh = high;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    /* The sync character 01010101 falls at the start bit and at bits 1, 3, 5 and 7 */
+    for (index = 1U; index < ((HAL_AUTOBAUD_BITS / 2U) + 1U); ++index)
+    {
+        (void)HAL_waitRxLevel(port, 1U);
+        edges[index] = HAL_waitRxLevel(port, 0U);
+    }
+
+    /* SysTick counts down */
+    span = (TRUE == HAL_autobaudExpired()) ? 0U
+         : ((edges[0U] - edges[HAL_AUTOBAUD_BITS / 2U]) & SysTick_LOAD_RELOAD_Msk);
+
+    /* Every two-bit period must be within 25% of the average, or this was not a sync character */
+    for (index = 1U; index < ((HAL_AUTOBAUD_BITS / 2U) + 1U); ++index)
+    {
+        period = ((edges[index - 1U] - edges[index]) & SysTick_LOAD_RELOAD_Msk) * (HAL_AUTOBAUD_BITS / 2U);
+        if ((period < (span - (span / 4U))) || (period > (span + (span / 4U))))
+        {
+            span = 0U;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return span;
+}
+#endif /* HAL_TRANSPORT */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,599 @@
+/*
+ * hal_mscan.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal.h"
+#include "hal_transport.h"
+
+#if (HAL_TRANSPORT_MSCAN == HAL_TRANSPORT)
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HAL_MSCAN_Rx_IRQHandler   MSCAN_Rx_IRQHandler
+#define HAL_MSCAN_ORed_IRQHandler MSCAN_ORed_IRQHandler
+
+#define HAL_CAN_PORT              0U       /* Index given to MSCAN in the middle layer */
+#define HAL_CAN_TIME_QUANTA       16U      /* Time quanta per bit: sync, 12 before and 3 after the sample point */
+#define HAL_CAN_TIME_SEGMENT1     12U
+#define HAL_CAN_TIME_SEGMENT2     3U
+#define HAL_CAN_SJW               3U
+#define HAL_CAN_DRAIN_TIMEOUT     100000U  /* Microseconds given to the last replies to leave the bus */
+
+#define HAL_ISOTP_SINGLE          0x00U    /* Protocol control information: type in the high nibble */
+#define HAL_ISOTP_FIRST           0x10U
+#define HAL_ISOTP_CONSECUTIVE     0x20U
+#define HAL_ISOTP_FLOW_CONTROL    0x30U
+#define HAL_ISOTP_TYPE_MASK       0xF0U
+#define HAL_ISOTP_NIBBLE_MASK     0x0FU
+#define HAL_ISOTP_CTS             0x00U    /* Flow status: clear to send */
+#define HAL_ISOTP_WAIT            0x01U    /* Flow status: wait for the next flow control */
+#define HAL_ISOTP_SINGLE_MAX      7U       /* Data bytes of a single frame */
+#define HAL_ISOTP_FIRST_DATA      6U       /* Data bytes of a first frame with a 12-bit length */
+#define HAL_ISOTP_ESCAPE_DATA     2U       /* Data bytes of a first frame with a 32-bit length */
+#define HAL_ISOTP_SHORT_MAX       4095U    /* Longest message given a 12-bit length */
+
+#define HAL_CAN_PRIO_FLOW         0U       /* Flow control is sent ahead of the replies */
+#define HAL_CAN_PRIO_REPLY        1U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t           g_txBuffer[HAL_TX_BUFFER_SIZE];  /* Replies waiting to be sent in single frames */
+static volatile uint16_t g_txHead;      /* Free-running index of the next character written by the caller */
+static volatile uint16_t g_txTail;      /* Free-running index of the next character sent by the interrupt */
+static volatile uint8_t  g_txActive;    /* TRUE while reply frames are still on the bus */
+static funcTxDone        g_txCallback;
+static HAL_RxErrors_t    g_rxErrors;
+static uint32_t          g_rxRemaining; /* Bytes of the multi-frame message still expected */
+static uint8_t           g_rxSequence;  /* Sequence number of the next consecutive frame */
+static uint8_t           g_rxBlock;     /* Consecutive frames left before the next flow control */
+static volatile uint8_t  g_paused;      /* TRUE while the host must wait at the next flow control */
+static volatile uint8_t  g_flowWaiting; /* TRUE once the host has been told to wait */
+static volatile uint8_t  g_flowPending; /* Flow status still to be sent, 0xFF if none */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Starts MSCAN, called by HAL_Init
+ * @return: None
+ */
+static void HAL_mscanInit(void);
+
+
+/*
+ * @brief:  Stops MSCAN once the replies have been sent, or the host has given up
+ * @return: None
+ */
+static void HAL_mscanDeInit(void);
+
+
+/*
+ * @brief:    MSCAN is the only port, there is nothing to stop
+ * @param[in] port: Index of the port locked onto
+ * @return:   None
+ */
+static void HAL_mscanLock(const uint8_t port);
+
+
+/*
+ * @brief:    Makes the next flow control frame a wait while paused, and sends clear to send on resume
+ * @param[in] pause: TRUE to pause the host, FALSE to let it resume
+ * @return:   None
+ */
+static void HAL_mscanFlowControl(const uint8_t pause);
+
+
+/*
+ * @brief:    Queues replies in the transmit ring without ever waiting
+ * @param[in] data: Pointer to the data buffer to be transmitted
+ * @param[in] size: Size of the data buffer to be transmitted
+ * @return:   The number of bytes accepted
+ */
+static uint32_t HAL_mscanWriteAsync(const uint8_t *const data, const uint32_t size);
+
+
+/*
+ * @brief:  Checks if replies are waiting or being sent
+ * @return: TRUE while replies are in flight, FALSE otherwise
+ */
+static uint8_t HAL_mscanTxBusy(void);
+
+
+/*
+ * @brief:    Sets the function called once all queued replies have been sent
+ * @param[in] funcAddress: The address of the function, NULL for none
+ * @return:   None
+ */
+static void HAL_mscanSetTxCallback(const funcTxDone funcAddress);
+
+
+/*
+ * @brief:    Gets the receive error counters of MSCAN
+ * @param[in] port: Index of the port
+ * @return:   Pointer to the counters, NULL if the port does not exist
+ */
+static const HAL_RxErrors_t* HAL_mscanRxErrors(const uint8_t port);
+
+
+/*
+ * @brief:    Hands the data bytes of a frame over to the middle layer
+ * @param[in] data: Pointer to the data bytes
+ * @param[in] length: Number of data bytes
+ * @return:   None
+ */
+static void HAL_receiveBytes(const uint8_t *const data, const uint32_t length);
+
+
+/*
+ * @brief:    Reassembles the message carried by a received frame
+ * @param[in] frame: The received frame
+ * @return:   None
+ */
+static void HAL_receiveFrame(const MSCAN_Frame_t *const frame);
+
+
+/*
+ * @brief:  Asks the host for the next block, or to wait while the pipeline is paused
+ * @return: None
+ */
+static void HAL_requestBlock(void);
+
+
+/*
+ * @brief:  Fills the empty transmit buffers with the pending flow control, then the replies,
+ *          and enables the interrupts of the buffers still in use
+ * @return: None
+ */
+static void HAL_sendFrames(void);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Operations of MSCAN, whose bit rate is fixed by HAL_CAN_BITRATE */
+const HAL_Transport_t g_mscanTransport =
+{
+    .init                = HAL_mscanInit,
+    .deInit              = HAL_mscanDeInit,
+    .lock                = HAL_mscanLock,
+    .rxAvailable         = NULL,
+    .readBurst           = NULL,
+    .writeAsync          = HAL_mscanWriteAsync,
+    .txBusy              = HAL_mscanTxBusy,
+    .setTxCallback       = HAL_mscanSetTxCallback,
+    .flowControl         = HAL_mscanFlowControl,
+    .rxErrors            = HAL_mscanRxErrors,
+    .isBaudrateSupported = NULL,
+    .changeBaudrate      = NULL,
+    .detectBaudrate      = NULL,
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: MSCAN receive interrupt handler
+ */
+void HAL_MSCAN_Rx_IRQHandler(void)
+{
+    MSCAN_Frame_t frame;
+
+    while (TRUE == MSCAN_ReceiveFull(MSCAN))
+    {
+        DRI_MSCAN_ReadFrame(MSCAN, &frame);
+        HAL_receiveFrame(&frame);
+    }
+}
+
+
+/*
+ * @brief: MSCAN transmit and error interrupt handler
+ */
+void HAL_MSCAN_ORed_IRQHandler(void)
+{
+    /* Every receive buffer was full: a frame of the message was lost */
+    if (0U != (MSCAN->CANRFLG & MSCAN_CANRFLG_OVRIF_MASK))
+    {
+        MSCAN->CANRFLG = MSCAN_CANRFLG_OVRIF_MASK;
+        g_rxErrors.overrun++;
+        g_rxRemaining = 0U;
+        HAL_receiveError(HAL_CAN_PORT);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    HAL_sendFrames();
+}
+
+
+/*
+ * @brief: Join the bus at HAL_CAN_BITRATE, receiving the frames of HAL_CAN_RX_ID
+ */
+static void HAL_mscanInit(void)
+{
+    /* Port initialization structure */
+    PORT_InitTypeDef PORT_InitStruct =
+    {
+        .Mux  = MSCAN_MUX,
+        .Pull = PORT_PULL_UP,
+    };
+
+    /* MSCAN initialization structure, its bus clock runs at the core clock */
+    MSCAN_InitTypeDef MSCAN_InitStruct =
+    {
+        .Prescaler     = (uint8_t)(SystemCoreClock / (HAL_CAN_BITRATE * HAL_CAN_TIME_QUANTA)),
+        .SyncJumpWidth = HAL_CAN_SJW,
+        .TimeSegment1  = HAL_CAN_TIME_SEGMENT1,
+        .TimeSegment2  = HAL_CAN_TIME_SEGMENT2,
+        .FilterId      = HAL_CAN_RX_ID,
+        .Loopback      = FALSE
+    };
+
+    /* Configure Pins for MSCAN function */
+    DRI_CLOCK_EnableClock(PCC_PORTE_INDEX);
+    DRI_PORT_Pin_Init(MSCAN_RX_PORT, MSCAN_RX_PIN, &PORT_InitStruct);
+    DRI_PORT_Pin_Init(MSCAN_TX_PORT, MSCAN_TX_PIN, &PORT_InitStruct);
+
+    g_txHead      = 0U;
+    g_txTail      = 0U;
+    g_txActive    = FALSE;
+    g_rxRemaining = 0U;
+    g_paused      = FALSE;
+    g_flowWaiting = FALSE;
+    g_flowPending = 0xFFU;
+    (void)memset(&g_rxErrors, 0, sizeof(g_rxErrors));
+
+    /* Initialize the MSCAN module and enable its interrupts */
+    DRI_MSCAN_Init(MSCAN, &MSCAN_InitStruct);
+    MSCAN->CANRIER = MSCAN_CANRIER_RXFIE_MASK | MSCAN_CANRIER_OVRIE_MASK;
+    NVIC_EnableIRQ(MSCAN_Rx_IRQn);
+    NVIC_EnableIRQ(MSCAN_ORed_IRQn);
+}
+
+
+/*
+ * @brief: Leave the bus once the replies have been sent, or could not be
+ */
+static void HAL_mscanDeInit(void)
+{
+    HAL_timeoutStart(HAL_CAN_DRAIN_TIMEOUT);
+    while ((TRUE == HAL_mscanTxBusy()) && (FALSE == HAL_timeoutExpired()))
+    {
+        /* Wait for the replies to leave the bus */
+    }
+    NVIC_DisableIRQ(MSCAN_Rx_IRQn);          /* Disable interrupts */
+    NVIC_DisableIRQ(MSCAN_ORed_IRQn);
+    DRI_MSCAN_DeInit(MSCAN);
+    DRI_CLOCK_DisableClock(PCC_PORTE_INDEX); /* Disable clock for MSCAN PORT */
+}
+
+
+/*
+ * @brief: MSCAN is the only port, there is nothing else to stop
+ */
+static void HAL_mscanLock(const uint8_t port)
+{
+    (void)port;
+}
+
+
+/*
+ * @brief: Make the host wait at the next flow control, or let it go on
+ */
+static void HAL_mscanFlowControl(const uint8_t pause)
+{
+    g_paused = pause;
+    if ((FALSE == pause) && (TRUE == g_flowWaiting))
+    {
+        /* The host is waiting for clear to send, sent from the interrupt handler */
+        g_flowWaiting = FALSE;
+        g_flowPending = HAL_ISOTP_CTS;
+        MSCAN_SetTransmitInterrupts(MSCAN, MSCAN_TX_BUFFERS_MASK);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Queue replies to be sent in single frames without ever waiting
+ */
+static uint32_t HAL_mscanWriteAsync(const uint8_t *const data, const uint32_t size)
+{
+    uint16_t head     = g_txHead;
+    uint32_t room     = HAL_TX_BUFFER_SIZE - (uint16_t)(head - g_txTail);
+    uint32_t accepted = (size < room) ? size : room;
+    uint32_t index    = 0U;
+
+    for (index = 0U; index < accepted; ++index)
+    {
+        g_txBuffer[(uint16_t)(head + index) & (HAL_TX_BUFFER_SIZE - 1U)] = data[index];
+    }
+    /* Published once the characters are in the ring, then sent from the interrupt handler */
+    g_txHead = (uint16_t)(head + accepted);
+    if (0U != accepted)
+    {
+        MSCAN_SetTransmitInterrupts(MSCAN, MSCAN_TX_BUFFERS_MASK);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return accepted;
+}
+
+
+/*
+ * @brief: Check if replies are waiting or still on the bus
+ */
+static uint8_t HAL_mscanTxBusy(void)
+{
+    return ((g_txHead != g_txTail) || (TRUE == g_txActive)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Sets the function called once all queued replies have been sent
+ */
+static void HAL_mscanSetTxCallback(const funcTxDone funcAddress)
+{
+    g_txCallback = funcAddress;
+}
+
+
+/*
+ * @brief: Gets the receive error counters of MSCAN
+ */
+static const HAL_RxErrors_t* HAL_mscanRxErrors(const uint8_t port)
+{
+    return (port < HAL_PORT_COUNT) ? &g_rxErrors : NULL;
+}
+
+
+/*
+ * @brief: Hands the data bytes of a frame over to the middle layer
+ */
+static void HAL_receiveBytes(const uint8_t *const data, const uint32_t length)
+{
+    HAL_receiveBurst(HAL_CAN_PORT, data, length);
+}
+
+
+/*
+ * @brief: Reassembles the message carried by a received frame
+ */
+static void HAL_receiveFrame(const MSCAN_Frame_t *const frame)
+{
+    uint8_t  type   = frame->data[0] & HAL_ISOTP_TYPE_MASK;
+    uint8_t  nibble = frame->data[0] & HAL_ISOTP_NIBBLE_MASK;
+    uint32_t length = 0U;
+
+    if (0U == frame->length)
+    {
+        /* Do Nothing: no protocol control information */
+    }
+    else if ((HAL_ISOTP_SINGLE == type) || (HAL_ISOTP_FIRST == type))
+    {
+        /* A new message gives up the one in progress */
+        if (0U != g_rxRemaining)
+        {
+            g_rxRemaining = 0U;
+            HAL_receiveError(HAL_CAN_PORT);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if (HAL_ISOTP_SINGLE == type)
+        {
+            if ((0U != nibble) && (nibble < frame->length))
+            {
+                HAL_receiveBytes(&frame->data[1], nibble);
+            }
+            else
+            {
+                /* Do Nothing: malformed single frame */
+            }
+        }
+        else if (DRI_MSCAN_MAX_DATA == frame->length)
+        {
+            length = ((uint32_t)nibble << 8U) | frame->data[1];
+            if (length > HAL_ISOTP_SINGLE_MAX)
+            {
+                HAL_receiveBytes(&frame->data[2], HAL_ISOTP_FIRST_DATA);
+                g_rxRemaining = length - HAL_ISOTP_FIRST_DATA;
+            }
+            else if (0U == length)
+            {
+                /* Messages longer than 4095 bytes give their length on 32 bits */
+                length = ((uint32_t)frame->data[2] << 24U) | ((uint32_t)frame->data[3] << 16U)
+                       | ((uint32_t)frame->data[4] << 8U) | frame->data[5];
+                if (length > HAL_ISOTP_SHORT_MAX)
+                {
+                    HAL_receiveBytes(&frame->data[6], HAL_ISOTP_ESCAPE_DATA);
+                    g_rxRemaining = length - HAL_ISOTP_ESCAPE_DATA;
+                }
+                else
+                {
+                    /* Do Nothing: the message would fit in the 12-bit length */
+                }
+            }
+            else
+            {
+                /* Do Nothing: the message would fit in a single frame */
+            }
+
+            if (0U != g_rxRemaining)
+            {
+                g_rxSequence = 1U;
+                HAL_requestBlock();
+            }
+            else
+            {
+                /* Malformed first frame: nothing is received and no flow control is sent */
+                HAL_receiveError(HAL_CAN_PORT);
+            }
+        }
+        else
+        {
+            /* Do Nothing: malformed first frame */
+        }
+    }
+    else if ((HAL_ISOTP_CONSECUTIVE == type) && (0U != g_rxRemaining))
+    {
+        if (nibble != g_rxSequence)
+        {
+            /* A consecutive frame is missing: the rest of the message is dropped */
+            g_rxRemaining = 0U;
+            HAL_receiveError(HAL_CAN_PORT);
+        }
+        else
+        {
+            length = (g_rxRemaining < HAL_ISOTP_SINGLE_MAX) ? g_rxRemaining : HAL_ISOTP_SINGLE_MAX;
+            length = (length < (uint32_t)(frame->length - 1U)) ? length : (uint32_t)(frame->length - 1U);
+            HAL_receiveBytes(&frame->data[1], length);
+            g_rxRemaining -= length;
+            g_rxSequence   = (g_rxSequence + 1U) & HAL_ISOTP_NIBBLE_MASK;
+
+            if ((0U != g_rxRemaining) && (0U != HAL_CAN_BLOCK_SIZE))
+            {
+                g_rxBlock--;
+                if (0U == g_rxBlock)
+                {
+                    HAL_requestBlock();
+                }
+                else
+                {
+                    /* Do Nothing */
+                }
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing: flow control from the host, or a consecutive frame of no message */
+    }
+}
+
+
+/*
+ * @brief: Asks the host for the next block, or to wait while the pipeline is paused
+ */
+static void HAL_requestBlock(void)
+{
+    g_rxBlock = HAL_CAN_BLOCK_SIZE;
+    if (TRUE == g_paused)
+    {
+        g_flowWaiting = TRUE;
+        g_flowPending = HAL_ISOTP_WAIT;
+    }
+    else
+    {
+        g_flowPending = HAL_ISOTP_CTS;
+    }
+    HAL_sendFrames();
+}
+
+
+/*
+ * @brief: Fills the empty transmit buffers with the pending flow control, then the replies
+ */
+static void HAL_sendFrames(void)
+{
+    MSCAN_Frame_t frame;
+    uint16_t      tail    = g_txTail;
+    uint8_t       done    = FALSE;
+    uint8_t       index   = 0U;
+    uint8_t       length  = 0U;
+
+    frame.id     = HAL_CAN_TX_ID;
+    frame.length = DRI_MSCAN_MAX_DATA;
+
+    while ((0U != MSCAN_GetEmptyTransmit(MSCAN)) && (FALSE == done))
+    {
+        (void)memset(frame.data, HAL_CAN_PADDING, sizeof(frame.data));
+        if (0xFFU != g_flowPending)
+        {
+            frame.data[0] = HAL_ISOTP_FLOW_CONTROL | g_flowPending;
+            frame.data[1] = HAL_CAN_BLOCK_SIZE;
+            frame.data[2] = HAL_CAN_STMIN;
+            (void)DRI_MSCAN_WriteFrame(MSCAN, &frame, HAL_CAN_PRIO_FLOW);
+            g_flowPending = 0xFFU;
+        }
+        else if (g_txHead != tail)
+        {
+            length = (uint8_t)(g_txHead - tail);
+            length = (length < HAL_ISOTP_SINGLE_MAX) ? length : HAL_ISOTP_SINGLE_MAX;
+            frame.data[0] = HAL_ISOTP_SINGLE | length;
+            for (index = 0U; index < length; ++index)
+            {
+                frame.data[1U + index] = g_txBuffer[(uint16_t)(tail + index) & (HAL_TX_BUFFER_SIZE - 1U)];
+            }
+            (void)DRI_MSCAN_WriteFrame(MSCAN, &frame, HAL_CAN_PRIO_REPLY);
+            tail       = (uint16_t)(tail + length);
+            g_txTail   = tail;
+            g_txActive = TRUE;
+        }
+        else
+        {
+            done = TRUE;
+        }
+    }
+
+    if ((0xFFU != g_flowPending) || (g_txHead != tail))
+    {
+        /* Wait for any buffer to empty */
+        MSCAN_SetTransmitInterrupts(MSCAN, MSCAN_TX_BUFFERS_MASK);
+    }
+    else if (MSCAN_TX_BUFFERS_MASK != MSCAN_GetEmptyTransmit(MSCAN))
+    {
+        /* Wait for the buffers still in use, the empty ones would interrupt at once */
+        MSCAN_SetTransmitInterrupts(MSCAN, (uint8_t)~MSCAN_GetEmptyTransmit(MSCAN));
+    }
+    else
+    {
+        MSCAN_SetTransmitInterrupts(MSCAN, 0U);
+        if (TRUE == g_txActive)
+        {
+            /* The last reply frame has left the bus */
+            g_txActive = FALSE;
+            if (NULL != g_txCallback)
+            {
+                g_txCallback();
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+#endif /* HAL_TRANSPORT */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
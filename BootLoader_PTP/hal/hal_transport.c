@@ -0,0 +1,434 @@
+/*
+ * hal_transport.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal_transport.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const HAL_Transport_t *g_transport = HAL_DEFAULT_TRANSPORT;  /* Transport the host talks through */
+static uint8_t   g_pushFailed[HAL_PORT_COUNT];  /* Set once a character of the port could not be queued */
+static uint32_t  g_baudrate;
+static volatile uint8_t g_jumpRequested;  /* Set once the host has asked to start the application */
+static volatile uint8_t g_lockedPort = HAL_PORT_NONE;  /* Port the bootloader listens on, once it is known */
+static funcMid   Push_Data_Func;  /* Used to save the function' address
+                                          which push received data into queue */
+static funcMidError Rx_Error_Func;  /* Called when received characters are lost or dropped */
+static funcMidBurst Push_Burst_Func;  /* Called with the characters received together, if set */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Replaces the transport selected by HAL_TRANSPORT
+ */
+void HAL_setTransport(const HAL_Transport_t *const transport)
+{
+    if (NULL != transport)
+    {
+        g_transport = transport;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Clears the state kept for the middle layer and starts listening on the transport
+ */
+void HAL_transportInit(void)
+{
+    (void)memset(g_pushFailed, FALSE, sizeof(g_pushFailed));
+    g_jumpRequested = FALSE;
+    g_lockedPort    = HAL_PORT_NONE;
+
+    g_transport->init();
+}
+
+
+/*
+ * @brief: Stops the transport once the data waiting to be sent has been sent
+ */
+void HAL_transportDeInit(void)
+{
+    g_transport->deInit();
+}
+
+
+/*
+ * @brief: Keeps listening on one port only
+ */
+void HAL_lockPort(const uint8_t port)
+{
+    if ((port < HAL_PORT_COUNT) && (HAL_PORT_NONE == g_lockedPort))
+    {
+        g_lockedPort = port;
+        g_transport->lock(port);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Gets the port the bootloader is locked onto
+ */
+uint8_t HAL_getLockedPort(void)
+{
+    return g_lockedPort;
+}
+
+
+/*
+ * @brief: Hands the characters a polled transport has received over to the middle layer
+ */
+void HAL_poll(void)
+{
+    uint8_t  burst[HAL_POLL_BURST];
+    uint32_t available = 0U;
+    uint32_t count     = 0U;
+    uint8_t  port      = 0U;
+
+    if ((NULL != g_transport->rxAvailable) && (NULL != g_transport->readBurst))
+    {
+        for (port = 0U; port < HAL_PORT_COUNT; ++port)
+        {
+            /* Only what has arrived so far, so that the caller gets back to the queue */
+            available = g_transport->rxAvailable(port);
+            while (0U != available)
+            {
+                count = g_transport->readBurst(port, burst,
+                                               (available < HAL_POLL_BURST) ? available : HAL_POLL_BURST);
+                HAL_receiveBurst(port, burst, count);
+                /* Nothing is read while the host is paused */
+                available = (0U == count) ? 0U : (available - count);
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Hands a received character over to the middle layer
+ */
+void HAL_receiveData(const uint8_t port, const uint8_t data)
+{
+    /* Push received character into Queue, a lost character is reported until HAL_Init.
+     * Nothing is pushed before the middle layer has set its function */
+    if ((NULL != Push_Data_Func) && (0U != Push_Data_Func(port, data)))
+    {
+        g_pushFailed[port] = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Hands characters received together over to the middle layer
+ */
+void HAL_receiveBurst(const uint8_t port, const uint8_t *const data, const uint32_t count)
+{
+    uint32_t index = 0U;
+
+    if (NULL != Push_Burst_Func)
+    {
+        if ((0U != count) && (0U != Push_Burst_Func(port, data, count)))
+        {
+            g_pushFailed[port] = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        for (index = 0U; index < count; ++index)
+        {
+            HAL_receiveData(port, data[index]);
+        }
+    }
+}
+
+
+/*
+ * @brief: Tells the middle layer that received characters were lost or dropped
+ */
+void HAL_receiveError(const uint8_t port)
+{
+    /* A line error before the middle layer has set its function has no record to give up */
+    if ((NULL != Rx_Error_Func) && (0U != Rx_Error_Func(port)))
+    {
+        g_pushFailed[port] = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Ask the host to pause or resume sending
+ */
+void HAL_requestFlowControl(const uint8_t pause)
+{
+    g_transport->flowControl(pause);
+}
+
+
+/*
+ * @brief: Set the baud rate used for communication in the HAL layer
+ */
+void HAL_SetBaudrate(const uint32_t baudrate)
+{
+    g_baudrate = baudrate;
+}
+
+
+/*
+ * @brief: Gets the baud rate in use
+ */
+uint32_t HAL_getBaudrate(void)
+{
+    return g_baudrate;
+}
+
+
+/*
+ * @brief: Measures the baud rate of the host, unless a fixed one was set
+ */
+uint32_t HAL_detectBaudrate(void)
+{
+    if ((HAL_BAUDRATE_AUTO == g_baudrate) && (NULL != g_transport->detectBaudrate))
+    {
+        g_baudrate = g_transport->detectBaudrate();
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return g_baudrate;
+}
+
+
+/*
+ * @brief: Checks if the transport can run at a baud rate
+ */
+uint8_t HAL_isBaudrateSupported(const uint32_t baudrate)
+{
+    return (NULL != g_transport->isBaudrateSupported) ? g_transport->isBaudrateSupported(baudrate) : FALSE;
+}
+
+
+/*
+ * @brief: Switches the transport to another baud rate once the data being sent has left the line
+ */
+void HAL_changeBaudrate(const uint32_t baudrate)
+{
+    if (NULL != g_transport->changeBaudrate)
+    {
+        g_transport->changeBaudrate(baudrate);
+        g_baudrate = baudrate;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Transmit data on the locked port, or on every port until one is locked
+ */
+uint32_t HAL_TransmitData(const uint8_t *const data, const uint32_t size)
+{
+    uint32_t sent     = 0U;
+    uint32_t chunk    = 0U;
+    uint32_t accepted = 0U;
+    uint8_t  dropped  = FALSE;
+
+    while ((sent < size) && (FALSE == dropped))
+    {
+        /* Only waits here while the ring is full. A chunk never exceeds the ring,
+         * so that it is accepted even where the data goes into several rings or none */
+        chunk     = ((size - sent) < HAL_TX_BUFFER_SIZE) ? (size - sent) : HAL_TX_BUFFER_SIZE;
+        accepted  = g_transport->writeAsync(&data[sent], chunk);
+        sent     += accepted;
+
+        /* Nothing drains the ring of a polled transport while the caller waits: the rest is dropped */
+        if ((NULL != g_transport->readBurst) && (accepted < chunk))
+        {
+            dropped = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return sent;
+}
+
+
+/*
+ * @brief: Queues data for the ports in use without ever waiting
+ */
+uint32_t HAL_TransmitDataAsync(const uint8_t *const data, const uint32_t size)
+{
+    return g_transport->writeAsync(data, size);
+}
+
+
+/*
+ * @brief: Check if the transmission is still in progress
+ */
+uint8_t HAL_TransmitBusy(void)
+{
+    return g_transport->txBusy();
+}
+
+
+/*
+ * @brief: Sets the function called once all queued data has been sent
+ */
+void HAL_setTransmitCallback(const funcTxDone funcAddress)
+{
+    g_transport->setTxCallback(funcAddress);
+}
+
+
+/*
+ * @brief: Gets the receive error counters of a port
+ */
+const HAL_RxErrors_t* HAL_getRxErrors(const uint8_t port)
+{
+    return g_transport->rxErrors(port);
+}
+
+
+/*
+ * @brief: Records that the host has asked to start the application
+ */
+void HAL_requestJump(void)
+{
+    g_jumpRequested = TRUE;
+}
+
+
+/*
+ * @brief: Checks if the host has asked to start the application
+ */
+uint8_t HAL_jumpRequested(void)
+{
+    return g_jumpRequested;
+}
+
+
+/*
+ * @brief: Sets the address of a function from a higher layer in the system
+ */
+uint8_t HAL_getFuncAddress(const void *const funcAddress)
+{
+    DRI_StatusTypeDef status = 0U;
+
+    if (funcAddress != NULL)
+    {
+        Push_Data_Func = funcAddress;
+    }
+    else
+    {
+        status = 1U;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Sets the function called when received characters are lost or dropped
+ */
+uint8_t HAL_getErrorFuncAddress(const void *const funcAddress)
+{
+    DRI_StatusTypeDef status = 0U;
+
+    if (funcAddress != NULL)
+    {
+        Rx_Error_Func = funcAddress;
+    }
+    else
+    {
+        status = 1U;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Sets the function called with the characters received together
+ */
+uint8_t HAL_getBurstFuncAddress(const void *const funcAddress)
+{
+    DRI_StatusTypeDef status = 0U;
+
+    if (funcAddress != NULL)
+    {
+        Push_Burst_Func = funcAddress;
+    }
+    else
+    {
+        status = 1U;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Returns the status of the data push operation to the queue
+ */
+uint8_t HAL_pushDataFailed(void)
+{
+    uint8_t failed = FALSE;
+    uint8_t port   = 0U;
+
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        /* The ports dropped by HAL_lockPort no longer count */
+        if (((HAL_PORT_NONE == g_lockedPort) || (port == g_lockedPort)) && (TRUE == g_pushFailed[port]))
+        {
+            failed = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return failed;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,89 @@
+/*
+ * hal_transport.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_HAL_TRANSPORT_H_
+#define _INC_HAL_TRANSPORT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hal_def.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#if (HAL_TRANSPORT_LPSPI == HAL_TRANSPORT)
+#define HAL_DEFAULT_TRANSPORT     (&g_lpspiTransport)
+#elif (HAL_TRANSPORT_LPI2C == HAL_TRANSPORT)
+#define HAL_DEFAULT_TRANSPORT     (&g_lpi2cTransport)
+#elif (HAL_TRANSPORT_MSCAN == HAL_TRANSPORT)
+#define HAL_DEFAULT_TRANSPORT     (&g_mscanTransport)
+#elif (HAL_TRANSPORT_LOOPBACK == HAL_TRANSPORT)
+#define HAL_DEFAULT_TRANSPORT     (&g_loopbackTransport)
+#else
+#define HAL_DEFAULT_TRANSPORT     (&g_lpuartTransport)
+#endif
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:  Clears the state kept for the middle layer and starts listening on the transport,
+ *          called by HAL_Init once the clocks are running
+ * @return: None
+ */
+void HAL_transportInit(void);
+
+
+/*
+ * @brief:  Stops the transport once the data waiting to be sent has been sent, called by HAL_DeInit
+ * @return: None
+ */
+void HAL_transportDeInit(void);
+
+
+/*
+ * @brief:    Hands a received character over to the middle layer, from the transport interrupt or HAL_poll
+ * @param[in] port: Index of the port the character came from
+ * @param[in] data: The received character
+ * @return:   None
+ */
+void HAL_receiveData(const uint8_t port, const uint8_t data);
+
+
+/*
+ * @brief:    Hands characters received together over to the middle layer, from the transport
+ *            interrupt or HAL_poll
+ * @param[in] port: Index of the port the characters came from
+ * @param[in] data: Pointer to the received characters
+ * @param[in] count: Number of received characters
+ * @return:   None
+ */
+void HAL_receiveBurst(const uint8_t port, const uint8_t *const data, const uint32_t count);
+
+
+/*
+ * @brief:    Tells the middle layer that received characters were lost or dropped,
+ *            from the transport interrupt
+ * @param[in] port: Index of the port
+ * @return:   None
+ */
+void HAL_receiveError(const uint8_t port);
+
+
+/*
+ * @brief:  Records that the host has asked to start the application, from the transport interrupt
+ * @return: None
+ */
+void HAL_requestJump(void);
+
+#endif /* _INC_HAL_TRANSPORT_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
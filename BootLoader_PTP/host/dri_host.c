@@ -0,0 +1,378 @@
+/*
+ * dri_host.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_host.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+PORT_Type  g_hostPort[5];
+GPIO_Type  g_hostGpio[5];
+uint8_t    g_hostClock[128];
+uint32_t   g_hostNvic;
+LPSPI_Type g_hostLpspi0;
+uint32_t   g_hostLpspiUnderruns;
+MSCAN_Type g_hostMscan;
+uint32_t   SystemCoreClock = 48000000U;  /* FIRC, as set up by the bootloader */
+
+static uint32_t s_mscanFlags;  /* CANRFLG as the hardware holds it, see HOST_mscanSync */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Clears every simulated peripheral
+ */
+void HOST_Reset(void)
+{
+    (void)memset(g_hostPort, 0, sizeof(g_hostPort));
+    (void)memset(g_hostGpio, 0, sizeof(g_hostGpio));
+    (void)memset(g_hostClock, 0, sizeof(g_hostClock));
+    (void)memset(&g_hostLpspi0, 0, sizeof(g_hostLpspi0));
+    (void)memset(&g_hostMscan, 0, sizeof(g_hostMscan));
+    g_hostMscan.CANRFLG  = HOST_MSCAN_UNWRITTEN;
+    s_mscanFlags         = 0U;
+    g_hostNvic           = 0U;
+    g_hostLpspiUnderruns = 0U;
+}
+
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    g_hostNvic |= (1UL << (uint32_t)IRQn);
+}
+
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    g_hostNvic &= ~(1UL << (uint32_t)IRQn);
+}
+
+
+DRI_StatusTypeDef DRI_GPIO_WritePin(GPIO_Type *const GPIOx,
+        const GPIO_Pin_t Pin, const GPIO_Pin_State_t State)
+{
+    if (GPIO_PIN_SET == State)
+    {
+        GPIOx->PDOR |= (1UL << Pin);
+    }
+    else
+    {
+        GPIOx->PDOR &= ~(1UL << Pin);
+    }
+
+    return DRIVER_OK;
+}
+
+
+/*
+ * @brief: An output reads back its level, an input the level set by the test in PDIR
+ */
+GPIO_Pin_State_t DRI_GPIO_ReadPin(const GPIO_Type *const GPIOx,
+        const GPIO_Pin_t Pin)
+{
+    uint32_t level = (0U != (GPIOx->PDDR & (1UL << Pin))) ? GPIOx->PDOR : GPIOx->PDIR;
+
+    return (0U != (level & (1UL << Pin))) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+
+DRI_StatusTypeDef DRI_GPIO_Init(GPIO_Type *const GPIOx, const GPIO_Pin_t Pin,
+        const GPIO_InitTypeDef *const GPIO_Init)
+{
+    if (GPIO_OUTPUT == GPIO_Init->Direction)
+    {
+        (void)DRI_GPIO_WritePin(GPIOx, Pin, GPIO_Init->OutputLogic);
+        GPIOx->PDDR |= (1UL << Pin);
+    }
+    else
+    {
+        GPIOx->PDDR &= ~(1UL << Pin);
+    }
+
+    return DRIVER_OK;
+}
+
+
+/*
+ * @brief: Starts LPSPI with empty FIFOs and no flag set
+ */
+void DRI_LPSPI_SlaveInit(LPSPI_Type *const LPSPIx, const LPSPI_SlaveInitTypeDef *const LPSPI_Init)
+{
+    (void)LPSPI_Init;
+    LPSPIx->SR      = 0U;
+    LPSPIx->IER     = 0U;
+    LPSPIx->rxCount = 0U;
+    LPSPIx->txCount = 0U;
+    LPSPIx->enabled = TRUE;
+}
+
+
+void DRI_LPSPI_DeInit(LPSPI_Type *const LPSPIx)
+{
+    LPSPIx->IER     = 0U;
+    LPSPIx->enabled = FALSE;
+}
+
+
+/*
+ * @brief: Clocks one frame as the SPI master
+ */
+uint8_t HOST_lpspiTransfer(const uint8_t mosi)
+{
+    uint8_t miso = HOST_SPI_UNDERRUN_BYTE;
+
+    if (TRUE == g_hostLpspi0.enabled)
+    {
+        if (0U != g_hostLpspi0.txCount)
+        {
+            miso = g_hostLpspi0.txFifo[0];
+            g_hostLpspi0.txCount--;
+            (void)memmove(&g_hostLpspi0.txFifo[0], &g_hostLpspi0.txFifo[1], g_hostLpspi0.txCount);
+        }
+        else
+        {
+            g_hostLpspi0.SR |= LPSPI_SR_TEF_MASK;
+            g_hostLpspiUnderruns++;
+        }
+
+        if (g_hostLpspi0.rxCount < LPSPI_FIFO_SIZE)
+        {
+            g_hostLpspi0.rxFifo[g_hostLpspi0.rxCount++] = mosi;
+        }
+        else
+        {
+            g_hostLpspi0.SR |= LPSPI_SR_REF_MASK;
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return miso;
+}
+
+
+/*
+ * @brief: Checks if LPSPI0 requests its interrupt
+ */
+uint8_t HOST_lpspiInterruptPending(void)
+{
+    uint8_t pending = FALSE;
+
+    if (0U != (g_hostNvic & (1UL << (uint32_t)LPSPI0_IRQn)))
+    {
+        if (((0U != g_hostLpspi0.rxCount) && (0U != (g_hostLpspi0.IER & LPSPI_IER_RDIE_MASK)))
+                || ((0U != (g_hostLpspi0.SR & LPSPI_SR_REF_MASK)) && (0U != (g_hostLpspi0.IER & LPSPI_IER_REIE_MASK))))
+        {
+            pending = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return pending;
+}
+
+
+/*
+ * @brief: Joins the bus with an empty receive FIFO and every transmit buffer empty
+ */
+void DRI_MSCAN_Init(MSCAN_Type *const MSCANx, const MSCAN_InitTypeDef *const MSCAN_Init)
+{
+    MSCANx->CANRFLG  = HOST_MSCAN_UNWRITTEN;
+    MSCANx->CANRIER  = 0U;
+    MSCANx->CANTFLG  = MSCAN_TX_BUFFERS_MASK;
+    MSCANx->CANTIER  = 0U;
+    MSCANx->rxCount  = 0U;
+    MSCANx->filterId = MSCAN_Init->FilterId;
+    MSCANx->enabled  = TRUE;
+}
+
+
+/*
+ * @brief: Leaves the bus
+ */
+void DRI_MSCAN_DeInit(MSCAN_Type *const MSCANx)
+{
+    MSCANx->CANRIER = 0U;
+    MSCANx->CANTIER = 0U;
+    MSCANx->enabled = FALSE;
+}
+
+
+/*
+ * @brief: Takes the oldest frame out of the receive FIFO, which releases the foreground buffer
+ */
+void DRI_MSCAN_ReadFrame(MSCAN_Type *const MSCANx, MSCAN_Frame_t *const frame)
+{
+    if (0U != MSCANx->rxCount)
+    {
+        *frame = MSCANx->rxFifo[0];
+        MSCANx->rxCount--;
+        (void)memmove(&MSCANx->rxFifo[0], &MSCANx->rxFifo[1], MSCANx->rxCount * sizeof(MSCAN_Frame_t));
+    }
+    else
+    {
+        (void)memset(frame, 0, sizeof(*frame));
+    }
+    HOST_mscanSync();
+}
+
+
+/*
+ * @brief: Hands the frame over to the lowest empty transmit buffer
+ */
+DRI_StatusTypeDef DRI_MSCAN_WriteFrame(MSCAN_Type *const MSCANx, const MSCAN_Frame_t *const frame,
+        const uint8_t priority)
+{
+    DRI_StatusTypeDef status = DRIVER_ERROR_BUSY;
+    uint8_t           buffer = 0U;
+
+    while ((buffer < MSCAN_TX_BUFFERS) && (0U == (MSCANx->CANTFLG & (1U << buffer))))
+    {
+        buffer++;
+    }
+
+    if (buffer < MSCAN_TX_BUFFERS)
+    {
+        MSCANx->txBuffer[buffer]   = *frame;
+        MSCANx->txPriority[buffer] = priority;
+        MSCANx->CANTFLG &= (uint8_t)~(1U << buffer);
+        status = DRIVER_OK;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Puts a frame sent by another node into the receive FIFO
+ */
+void HOST_mscanDeliver(const MSCAN_Frame_t *const frame)
+{
+    HOST_mscanSync();
+    if ((TRUE == g_hostMscan.enabled) && (frame->id == g_hostMscan.filterId))
+    {
+        if (g_hostMscan.rxCount < MSCAN_RX_FIFO_SIZE)
+        {
+            g_hostMscan.rxFifo[g_hostMscan.rxCount++] = *frame;
+        }
+        else
+        {
+            g_hostMscan.CANRFLG |= MSCAN_CANRFLG_OVRIF_MASK;
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+    HOST_mscanSync();
+}
+
+
+/*
+ * @brief: Sends the frame of the transmit buffer that wins the arbitration
+ */
+uint8_t HOST_mscanTransmit(MSCAN_Frame_t *const frame)
+{
+    uint8_t sent   = FALSE;
+    uint8_t winner = MSCAN_TX_BUFFERS;
+    uint8_t buffer = 0U;
+
+    for (buffer = 0U; buffer < MSCAN_TX_BUFFERS; ++buffer)
+    {
+        if ((0U == (g_hostMscan.CANTFLG & (1U << buffer)))
+                && ((MSCAN_TX_BUFFERS == winner) || (g_hostMscan.txPriority[buffer] < g_hostMscan.txPriority[winner])))
+        {
+            winner = buffer;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    if ((TRUE == g_hostMscan.enabled) && (winner < MSCAN_TX_BUFFERS))
+    {
+        *frame = g_hostMscan.txBuffer[winner];
+        g_hostMscan.CANTFLG |= (uint8_t)(1U << winner);
+        sent = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return sent;
+}
+
+
+/*
+ * @brief: Applies the writes to CANRFLG and updates RXF
+ */
+void HOST_mscanSync(void)
+{
+    uint32_t flags = g_hostMscan.CANRFLG;
+
+    if (0U == (flags & HOST_MSCAN_UNWRITTEN))
+    {
+        /* Written since the last call: what was written is the flags to clear */
+        flags = s_mscanFlags & ~flags;
+    }
+    else
+    {
+        flags &= ~HOST_MSCAN_UNWRITTEN;
+    }
+    flags = (flags & ~MSCAN_CANRFLG_RXF_MASK) | ((0U != g_hostMscan.rxCount) ? MSCAN_CANRFLG_RXF_MASK : 0U);
+
+    s_mscanFlags        = flags;
+    g_hostMscan.CANRFLG = flags | HOST_MSCAN_UNWRITTEN;
+}
+
+
+/*
+ * @brief: Checks if MSCAN requests its receive interrupt
+ */
+uint8_t HOST_mscanRxInterruptPending(void)
+{
+    return ((0U != (g_hostNvic & (1UL << (uint32_t)MSCAN_Rx_IRQn)))
+            && (0U != (g_hostMscan.CANRFLG & MSCAN_CANRFLG_RXF_MASK))
+            && (0U != (g_hostMscan.CANRIER & MSCAN_CANRIER_RXFIE_MASK))) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Checks if MSCAN requests its transmit and error interrupt
+ */
+uint8_t HOST_mscanOredInterruptPending(void)
+{
+    return ((0U != (g_hostNvic & (1UL << (uint32_t)MSCAN_ORed_IRQn)))
+            && ((0U != (g_hostMscan.CANTFLG & g_hostMscan.CANTIER))
+                || ((0U != (g_hostMscan.CANRFLG & MSCAN_CANRFLG_OVRIF_MASK))
+                    && (0U != (g_hostMscan.CANRIER & MSCAN_CANRIER_OVRIE_MASK))))) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,105 @@
+/*
+ * dri_host.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_HOST_H_
+#define _INC_DRI_HOST_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_gpio.h"
+#include "dri_lpspi.h"
+#include "dri_mscan.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HOST_SPI_UNDERRUN_BYTE   0x00U   /* Shifted out when the transmit FIFO of the slave is empty */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern uint32_t g_hostLpspiUnderruns;    /* Frames clocked out of an empty transmit FIFO */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief:    Clears every simulated peripheral, the pins and the interrupt enables
+ * @return:   None
+ */
+void HOST_Reset(void);
+
+
+/*
+ * @brief:    Clocks one frame as the SPI master: the slave shifts out the oldest word of its
+ *            transmit FIFO and receives mosi into its receive FIFO
+ * @param[in] mosi: The character sent by the master
+ * @return:   The character shifted out by the slave, HOST_SPI_UNDERRUN_BYTE if it had none
+ * @note:     Sets TEF on an empty transmit FIFO, REF on a full receive FIFO (mosi is then lost).
+ *            The frame is dropped while LPSPI0 is stopped
+ */
+uint8_t HOST_lpspiTransfer(const uint8_t mosi);
+
+
+/*
+ * @brief:    Checks if LPSPI0 requests its interrupt: enabled in the NVIC, and a received word
+ *            or a receive error with its interrupt enabled
+ * @return:   TRUE if LPSPI0_IRQHandler would run
+ */
+uint8_t HOST_lpspiInterruptPending(void);
+
+
+/*
+ * @brief:    Puts a frame sent by another node on the bus into the receive FIFO of MSCAN,
+ *            if its identifier passes the filter
+ * @param[in] frame: The frame
+ * @return:   None
+ * @note:     Sets OVRIF and drops the frame when the receive FIFO is full.
+ *            The frame is dropped while MSCAN is stopped
+ */
+void HOST_mscanDeliver(const MSCAN_Frame_t *const frame);
+
+
+/*
+ * @brief:     Sends the frame of the transmit buffer that wins the arbitration: the lowest
+ *             priority value, then the lowest buffer, and empties the buffer
+ * @param[out] frame: The frame sent
+ * @return:    TRUE if a frame was sent, FALSE if every transmit buffer is empty
+ */
+uint8_t HOST_mscanTransmit(MSCAN_Frame_t *const frame);
+
+
+/*
+ * @brief:  Applies what software wrote to CANRFLG since the last call, as write 1 to clear,
+ *          and updates RXF from the receive FIFO.
+ *          CANRFLG holds HOST_MSCAN_UNWRITTEN until it is written
+ * @return: None
+ */
+void HOST_mscanSync(void);
+
+
+/*
+ * @brief:  Checks if MSCAN requests its receive interrupt: enabled in the NVIC and RXF with RXFIE
+ * @return: TRUE if MSCAN_Rx_IRQHandler would run
+ */
+uint8_t HOST_mscanRxInterruptPending(void);
+
+
+/*
+ * @brief:  Checks if MSCAN requests its transmit and error interrupt: enabled in the NVIC,
+ *          and an empty transmit buffer with its TXEIE, or OVRIF with OVRIE
+ * @return: TRUE if MSCAN_ORed_IRQHandler would run
+ */
+uint8_t HOST_mscanOredInterruptPending(void);
+
+#endif /* _INC_DRI_HOST_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,207 @@
+/*
+ * hal_host.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <time.h>
+#include "hal_host.h"
+#include "hal_transport.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+uint8_t  g_hostFlash[HOST_FLASH_SIZE];
+uint32_t g_hostFlashErrors;
+uint8_t  g_hostSwitch = SWITCH_PRESSED;
+jmp_buf  g_hostJump;
+uint32_t g_hostJumpAddress;
+uint32_t g_hostEntryPoint;
+
+static struct timespec s_timeoutStart;   /* Time when the timeout was started */
+static uint32_t        s_timeoutLength;  /* Length of the timeout in microseconds */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/* The device-specific half of the HAL (hal.c and flash.c), in memory */
+
+/*
+ * @brief: Nothing to clock, only the transport is started
+ */
+void HAL_Init(void)
+{
+    HAL_transportInit();
+}
+
+
+/*
+ * @brief: Stops the transport
+ */
+void HAL_DeInit(void)
+{
+    HAL_transportDeInit();
+}
+
+
+/*
+ * @brief: Starts a timeout measured with the monotonic clock of the host
+ */
+void HAL_timeoutStart(const uint32_t microseconds)
+{
+    (void)clock_gettime(CLOCK_MONOTONIC, &s_timeoutStart);
+    s_timeoutLength = microseconds;
+}
+
+
+/*
+ * @brief: Checks if the timeout started by HAL_timeoutStart has expired
+ */
+uint8_t HAL_timeoutExpired(void)
+{
+    struct timespec now;
+    int64_t         elapsed = 0;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed = ((int64_t)(now.tv_sec - s_timeoutStart.tv_sec) * 1000000)
+              + ((now.tv_nsec - s_timeoutStart.tv_nsec) / 1000);
+
+    return (elapsed >= (int64_t)s_timeoutLength) ? TRUE : FALSE;
+}
+
+
+/*
+ * @brief: Erases the sectors of the application space
+ */
+uint8_t HAL_eraseFlash(const uint32_t startAddress, const uint32_t size)
+{
+    return Erase_Multi_Sector(startAddress, size);
+}
+
+
+/*
+ * @brief: Gets the state set by the test
+ */
+uint8_t HAL_switchIsPressed(void)
+{
+    return g_hostSwitch;
+}
+
+
+/*
+ * @brief: Records where the application would be started, and returns to the test
+ */
+void HAL_jumpApplication(const uint32_t appAddress, const uint32_t entryPoint)
+{
+    g_hostJumpAddress = appAddress;
+    g_hostEntryPoint  = entryPoint;
+    longjmp(g_hostJump, 1);
+}
+
+
+/*
+ * @brief: Copies the application into the backup space, one longword at a time
+ */
+void HAL_backupApplication(const uint32_t appAddress,
+                           const uint32_t backupAddress,
+                           const uint32_t appSize)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < (appSize * 1024U); index += 4U)
+    {
+        Program_LongWord(backupAddress + index, &g_hostFlash[appAddress + index]);
+    }
+}
+
+
+/*
+ * @brief: Copies the backup into the application space, one longword at a time
+ */
+void HAL_restoreApplication(const uint32_t restoreAddress,
+                            const uint32_t backupAddress,
+                            const uint32_t appSize)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < (appSize * 1024U); index += 4U)
+    {
+        Program_LongWord(restoreAddress + index, &g_hostFlash[backupAddress + index]);
+    }
+}
+
+
+/*
+ * @brief: Programs a longword, which must have been erased as on the device
+ */
+void Program_LongWord(uint32_t Addr, const uint8_t *const Data)
+{
+    uint8_t index = 0U;
+
+    if ((0U != (Addr & 3U)) || (Addr > (HOST_FLASH_SIZE - 4U)))
+    {
+        g_hostFlashErrors++;
+    }
+    else
+    {
+        for (index = 0U; index < 4U; ++index)
+        {
+            if (0xFFU != g_hostFlash[Addr + index])
+            {
+                g_hostFlashErrors++;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            /* Programming only clears bits */
+            g_hostFlash[Addr + index] &= Data[index];
+        }
+    }
+}
+
+
+/*
+ * @brief: Erases a sector of HOST_SECTOR_SIZE bytes
+ */
+uint8_t Erase_Sector(const uint32_t Addr)
+{
+    uint8_t status = 0U;
+
+    if (Addr < HOST_FLASH_SIZE)
+    {
+        (void)memset(&g_hostFlash[Addr & ~(HOST_SECTOR_SIZE - 1U)], 0xFF, HOST_SECTOR_SIZE);
+    }
+    else
+    {
+        status = 1U;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Erases Size sectors from Addr
+ */
+uint8_t Erase_Multi_Sector(const uint32_t Addr, const uint32_t Size)
+{
+    uint32_t index  = 0U;
+    uint8_t  status = 0U;
+
+    for (index = 0U; index < Size; ++index)
+    {
+        status |= Erase_Sector(Addr + (index * HOST_SECTOR_SIZE));
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,46 @@
+/*
+ * hal_host.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_HAL_HOST_H_
+#define _INC_HAL_HOST_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <setjmp.h>
+#include "hal_def.h"
+#include "flash.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define HOST_FLASH_SIZE          (64U * 1024U)   /* Program flash of the MKE16Z64, from address 0 */
+#define HOST_SECTOR_SIZE         1024U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Content of the program flash, written by Program_LongWord and Erase_Sector */
+extern uint8_t  g_hostFlash[HOST_FLASH_SIZE];
+
+/* Longwords programmed without being erased first, or outside of the flash */
+extern uint32_t g_hostFlashErrors;
+
+/* State returned by HAL_switchIsPressed, SWITCH_PRESSED to run the bootloader */
+extern uint8_t  g_hostSwitch;
+
+/* HAL_jumpApplication returns here with longjmp, once it has recorded where it jumped */
+extern jmp_buf  g_hostJump;
+extern uint32_t g_hostJumpAddress;
+extern uint32_t g_hostEntryPoint;
+
+#endif /* _INC_HAL_HOST_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
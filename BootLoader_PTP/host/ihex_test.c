@@ -0,0 +1,179 @@
+/*
+ * ihex_test.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "Ihex.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define TEST_GUARD_LENGTH       16U     /* Bytes watched after the data buffer of the record */
+#define TEST_GUARD_BYTE         0x5AU
+#define TEST_FIRST_COUNT        (SREC_MAX_DATA_LENGTH - 2U)  /* Byte counts tried, up to 0xFF */
+#define TEST_LINE_SIZE          (1U + ((4U + 255U + 1U) * 2U) + 2U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t s_line[TEST_LINE_SIZE];
+
+/* Data buffer of the record, with guard bytes behind it that must never be written */
+static uint8_t s_data[SREC_MAX_DATA_LENGTH + TEST_GUARD_LENGTH];
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Writes a data record of byteCount data bytes, with a valid checksum
+ * @param[in]  byteCount: byteCount field of the record
+ * @return:    Number of characters of the record, "\r\n" included
+ */
+static uint32_t TEST_BuildRecord(const uint8_t byteCount);
+
+
+/*
+ * @brief:     Feeds a record into the decoder
+ * @param[out] decoder: Pointer to the decoder context
+ * @param[in]  size: Number of characters of the record in s_line
+ * @param[out] record: The record being filled in
+ * @return:    The first status other than SREC_PENDING, SREC_PENDING if there was none
+ */
+static Srec_Status_t TEST_Decode(Ihex_Decoder_t *const decoder, const uint32_t size,
+                                 Srec_Record_t *const record);
+
+
+/*
+ * @brief:     Checks that the guard bytes behind the data buffer are untouched
+ * @return:    0 if they are, 1 otherwise
+ */
+static uint8_t TEST_GuardWritten(void);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Feeds data records of byteCount SREC_MAX_DATA_LENGTH - 2 to 0xFF into the Intel HEX
+ *         decoder: the longer ones must be rejected before a data byte is stored
+ */
+int main(void)
+{
+    Ihex_Decoder_t decoder;
+    Srec_Record_t  record;
+    Srec_Status_t  status    = SREC_PENDING;
+    Srec_Status_t  expected  = SREC_PENDING;
+    uint8_t        retVal    = 0U;
+    uint8_t        failed    = 0U;
+    uint16_t       byteCount = 0U;
+    uint32_t       size      = 0U;
+
+    IHEX_DecoderInit(&decoder);
+    record.data = s_data;
+
+    for (byteCount = TEST_FIRST_COUNT; byteCount <= 0xFFU; ++byteCount)
+    {
+        (void)memset(s_data, TEST_GUARD_BYTE, sizeof(s_data));
+        size     = TEST_BuildRecord((uint8_t)byteCount);
+        status   = TEST_Decode(&decoder, size, &record);
+        expected = (byteCount <= SREC_MAX_DATA_LENGTH) ? SREC_OK : SREC_ERROR_BYTE_COUNT;
+        failed   = (expected != status) || (0U != TEST_GuardWritten());
+        if (SREC_OK == status)
+        {
+            failed |= (byteCount != record.length) || (IHEX_DATA_RECORD_TYPE != record.type);
+        }
+        else
+        {
+            failed |= (0U != record.length);
+        }
+
+        /* The decoder drops the rest of a bad line and takes the next record */
+        size    = TEST_BuildRecord(1U);
+        failed |= (SREC_OK != TEST_Decode(&decoder, size, &record)) || (1U != record.length);
+
+        printf("byteCount %3u  status %u  %s\n", (unsigned)byteCount, (unsigned)status,
+               (0U == failed) ? "ok" : "FAIL");
+        retVal |= failed;
+    }
+
+    printf("ihex: %s\n", (0U == retVal) ? "PASS" : "FAIL");
+
+    return (int)retVal;
+}
+
+
+/*
+ * @brief: Writes a data record of byteCount data bytes
+ */
+static uint32_t TEST_BuildRecord(const uint8_t byteCount)
+{
+    uint32_t size  = 0U;
+    uint16_t index = 0U;
+    uint8_t  sum   = byteCount;
+
+    size += (uint32_t)sprintf((char *)&s_line[size], ":%02X000000", (unsigned)byteCount);
+    for (index = 0U; index < byteCount; ++index)
+    {
+        sum  += (uint8_t)index;
+        size += (uint32_t)sprintf((char *)&s_line[size], "%02X", (unsigned)(uint8_t)index);
+    }
+    size += (uint32_t)sprintf((char *)&s_line[size], "%02X\r\n", (unsigned)(uint8_t)(0U - sum));
+
+    return size;
+}
+
+
+/*
+ * @brief: Feeds a record into the decoder
+ */
+static Srec_Status_t TEST_Decode(Ihex_Decoder_t *const decoder, const uint32_t size,
+                                 Srec_Record_t *const record)
+{
+    Srec_Status_t status = SREC_PENDING;
+    Srec_Status_t first  = SREC_PENDING;
+    uint32_t      index  = 0U;
+
+    for (index = 0U; index < size; ++index)
+    {
+        status = IHEX_DecodeChar(decoder, s_line[index], record);
+        if ((SREC_PENDING == first) && (SREC_PENDING != status))
+        {
+            first = status;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return first;
+}
+
+
+/*
+ * @brief: Checks that the guard bytes behind the data buffer are untouched
+ */
+static uint8_t TEST_GuardWritten(void)
+{
+    uint8_t  written = 0U;
+    uint32_t index   = 0U;
+
+    for (index = SREC_MAX_DATA_LENGTH; index < sizeof(s_data); ++index)
+    {
+        written |= (TEST_GUARD_BYTE != s_data[index]);
+    }
+
+    return written;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,299 @@
+/*
+ * lpspi_test.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "hal.h"
+#include "hal_transport.h"
+#include "dri_host.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define TEST_STREAM_SIZE        4096U   /* Frames clocked by the master in the stream */
+#define TEST_REPLY_EVERY        300U    /* Frames between two replies, enough to clock the longest one out */
+#define TEST_MAX_REPLIES        ((TEST_STREAM_SIZE / TEST_REPLY_EVERY) + 1U)
+#define TEST_MAX_RECEIVED       (TEST_STREAM_SIZE + 16U)
+#define TEST_OVERRUN_FRAMES     (LPSPI_FIFO_SIZE + 1U)  /* Frames clocked without the interrupt running */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t  s_mosi[TEST_STREAM_SIZE];
+static uint8_t  s_miso[TEST_STREAM_SIZE];
+static uint8_t  s_replies[TEST_STREAM_SIZE];          /* Every reply queued, one after the other */
+static uint32_t s_repliesSize;
+static uint32_t s_replyFrame[TEST_MAX_REPLIES];      /* Frame before which each reply was queued */
+static uint32_t s_replyStart[TEST_MAX_REPLIES];      /* Offset of each reply in s_replies */
+static uint32_t s_numReplies;
+
+/* What the transport handed over to the layer above */
+static uint8_t  s_received[TEST_MAX_RECEIVED];
+static uint32_t s_receivedSize;
+static uint32_t s_errors;
+static uint32_t s_txDone;
+
+/* Length of the replies queued in turn, together they wrap the transmit ring several times */
+static const uint8_t s_replyLength[] = { 1U, 7U, 120U, 33U };
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/* Interrupt handler of hal_lpspi.c */
+void LPSPI0_IRQHandler(void);
+
+
+/*
+ * @brief:    Takes a received character, as MID_PushData does
+ * @param[in] port: Index of the port
+ * @param[in] data: The character
+ * @return:   0
+ */
+static int8_t TEST_Push(const uint8_t port, const uint8_t data);
+
+
+/*
+ * @brief:    Counts the losses reported, as MID_ReceiveError does
+ * @param[in] port: Index of the port
+ * @return:   0
+ */
+static int8_t TEST_Error(const uint8_t port);
+
+
+/*
+ * @brief:  Counts the calls of the transmit callback
+ * @return: None
+ */
+static void TEST_TxDone(void);
+
+
+/*
+ * @brief:    Clocks one frame, then runs the interrupt handler for as long as LPSPI0 requests it
+ * @param[in] mosi: The character sent by the master
+ * @return:   The character shifted out by the bootloader
+ */
+static uint8_t TEST_Frame(const uint8_t mosi);
+
+
+/*
+ * @brief:     Prints the outcome of a check
+ * @param[in]  name: Name of the check
+ * @param[in]  failed: 0 if the check passed
+ * @return:    failed, as 0 or 1
+ */
+static uint8_t TEST_Report(const char *const name, const uint8_t failed);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Runs hal_lpspi.c and hal_transport.c against a simulated LPSPI0 and its master:
+ *         start, a stream with replies, flow control, a receive overrun and stop
+ */
+int main(void)
+{
+    uint8_t  retVal  = 0U;
+    uint8_t  failed  = 0U;
+    uint32_t frame   = 0U;
+    uint32_t index   = 0U;
+    uint32_t length  = 0U;
+    uint32_t offset  = 0U;
+    uint32_t seed    = 0x5B1U;
+
+    HOST_Reset();
+
+    /* A line error or a character before the middle layer has set its functions is dropped */
+    HAL_receiveError(0U);
+    HAL_receiveData(0U, 0x55U);
+    retVal |= TEST_Report("no callback", (0U != s_errors) || (0U != s_receivedSize));
+
+    (void)HAL_getFuncAddress(TEST_Push);
+    (void)HAL_getErrorFuncAddress(TEST_Error);
+    HAL_setTransmitCallback(TEST_TxDone);
+    HAL_Init();
+
+    /* Started: the pins are given to LPSPI0, the busy pin is low, and the first character
+     * the master clocks is the idle byte, already in the transmit FIFO */
+    failed  = (LPSPI0_MUX != PORTB->mux[LPSPI0_SCK_PIN]) || (LPSPI0_MUX != PORTB->mux[LPSPI0_SIN_PIN])
+              || (LPSPI0_MUX != PORTB->mux[LPSPI0_SOUT_PIN]) || (LPSPI0_MUX != PORTB->mux[LPSPI0_PCS_PIN]);
+    failed |= (GPIO_PIN_RESET != DRI_GPIO_ReadPin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN));
+    failed |= (0U == (g_hostNvic & (1UL << (uint32_t)LPSPI0_IRQn)));
+    failed |= ((LPSPI_IER_RDIE_MASK | LPSPI_IER_REIE_MASK) != g_hostLpspi0.IER);
+    failed |= (1U != g_hostLpspi0.txCount) || (HAL_SPI_IDLE_BYTE != g_hostLpspi0.txFifo[0]);
+    retVal |= TEST_Report("init", failed);
+
+    /* The master clocks a stream while replies are queued now and then */
+    for (frame = 0U; frame < TEST_STREAM_SIZE; ++frame)
+    {
+        seed ^= seed << 13U;
+        seed ^= seed >> 17U;
+        seed ^= seed << 5U;
+        s_mosi[frame] = (uint8_t)seed;
+
+        if (0U == (frame % TEST_REPLY_EVERY))
+        {
+            length = s_replyLength[s_numReplies % sizeof(s_replyLength)];
+            for (index = 0U; index < length; ++index)
+            {
+                /* Never the idle byte, so the replies can be told apart from it */
+                s_replies[s_repliesSize + index] = (uint8_t)('A' + ((s_numReplies + index) % 26U));
+            }
+            s_replyFrame[s_numReplies] = frame;
+            s_replyStart[s_numReplies] = s_repliesSize;
+            s_repliesSize += HAL_TransmitDataAsync(&s_replies[s_repliesSize], length);
+            s_numReplies++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        s_miso[frame] = TEST_Frame(s_mosi[frame]);
+    }
+
+    failed  = (TEST_STREAM_SIZE != s_receivedSize) || (0 != memcmp(s_received, s_mosi, TEST_STREAM_SIZE));
+    failed |= (0U != s_errors) || (0U != g_hostLpspiUnderruns) || (0U != g_hostLpspi0.txOverflows);
+    retVal |= TEST_Report("stream, mosi", failed);
+
+    /* MISO carries every reply in order, the idle byte in between. A reply queued before frame n
+     * starts on frame n + 1, as frame n shifts out the character already in the FIFO */
+    failed = 0U;
+    offset = 0U;
+    for (frame = 0U; frame < TEST_STREAM_SIZE; ++frame)
+    {
+        if (HAL_SPI_IDLE_BYTE != s_miso[frame])
+        {
+            failed |= (offset >= s_repliesSize) || (s_replies[offset] != s_miso[frame]);
+            offset++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    failed |= (offset != s_repliesSize);
+    for (index = 0U; index < s_numReplies; ++index)
+    {
+        frame   = s_replyFrame[index] + 1U;
+        failed |= (frame >= TEST_STREAM_SIZE) || (s_replies[s_replyStart[index]] != s_miso[frame])
+                  || (HAL_SPI_IDLE_BYTE != s_miso[frame - 1U]);
+    }
+    /* The callback runs once the last character of each reply has been clocked out */
+    failed |= (s_numReplies != s_txDone) || (FALSE != HAL_TransmitBusy());
+    retVal |= TEST_Report("stream, miso", failed);
+
+    /* The busy pin pauses the master */
+    HAL_requestFlowControl(TRUE);
+    failed  = (GPIO_PIN_SET != DRI_GPIO_ReadPin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN));
+    HAL_requestFlowControl(FALSE);
+    failed |= (GPIO_PIN_RESET != DRI_GPIO_ReadPin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN));
+    retVal |= TEST_Report("flow control", failed);
+
+    /* The master clocks one frame more than the receive FIFO holds before the interrupt runs:
+     * the FIFO is handed over, the last character is reported lost */
+    s_receivedSize = 0U;
+    for (frame = 0U; frame < TEST_OVERRUN_FRAMES; ++frame)
+    {
+        (void)HOST_lpspiTransfer((uint8_t)(0xA0U + frame));
+    }
+    while (TRUE == HOST_lpspiInterruptPending())
+    {
+        LPSPI0_IRQHandler();
+    }
+    failed = (LPSPI_FIFO_SIZE != s_receivedSize);
+    for (index = 0U; index < s_receivedSize; ++index)
+    {
+        failed |= ((uint8_t)(0xA0U + index) != s_received[index]);
+    }
+    failed |= (1U != s_errors) || (1U != HAL_getRxErrors(0U)->overrun);
+    failed |= (0U != (g_hostLpspi0.SR & (LPSPI_SR_REF_MASK | LPSPI_SR_TEF_MASK)));
+    retVal |= TEST_Report("overrun", failed);
+
+    /* Stopped: the master is held off with the busy pin */
+    HAL_DeInit();
+    failed  = (GPIO_PIN_SET != DRI_GPIO_ReadPin(LPSPI0_BUSY_GPIO, LPSPI0_BUSY_PIN));
+    failed |= (0U != (g_hostNvic & (1UL << (uint32_t)LPSPI0_IRQn))) || (FALSE != g_hostLpspi0.enabled);
+    retVal |= TEST_Report("deinit", failed);
+
+    printf("lpspi: %s\n", (0U == retVal) ? "PASS" : "FAIL");
+
+    return (int)retVal;
+}
+
+
+/*
+ * @brief: Takes a received character
+ */
+static int8_t TEST_Push(const uint8_t port, const uint8_t data)
+{
+    if (s_receivedSize < TEST_MAX_RECEIVED)
+    {
+        s_received[s_receivedSize++] = data;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return 0;
+}
+
+
+/*
+ * @brief: Counts the losses reported
+ */
+static int8_t TEST_Error(const uint8_t port)
+{
+    s_errors++;
+
+    return 0;
+}
+
+
+/*
+ * @brief: Counts the calls of the transmit callback
+ */
+static void TEST_TxDone(void)
+{
+    s_txDone++;
+}
+
+
+/*
+ * @brief: Clocks one frame, then runs the interrupt handler
+ */
+static uint8_t TEST_Frame(const uint8_t mosi)
+{
+    uint8_t miso = HOST_lpspiTransfer(mosi);
+
+    while (TRUE == HOST_lpspiInterruptPending())
+    {
+        LPSPI0_IRQHandler();
+    }
+
+    return miso;
+}
+
+
+/*
+ * @brief: Prints the outcome of a check
+ */
+static uint8_t TEST_Report(const char *const name, const uint8_t failed)
+{
+    printf("%-14s %s\n", name, (0U == failed) ? "ok" : "FAIL");
+
+    return (0U == failed) ? 0U : 1U;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,635 @@
+/*
+ * mscan_test.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+#include "dri_host.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define TEST_MAX_MESSAGE        6000U   /* Largest message sent by the host */
+#define TEST_MAX_FRAMES         2048U   /* Frames kept of what the bootloader sends */
+#define TEST_MAX_INTERRUPTS     16U     /* Interrupts in a row before the handlers are said to storm */
+#define TEST_MAX_BUS_STEPS      64U     /* Frames the host waits for a flow control */
+
+#define TEST_FC_CTS             0x30U   /* First byte of a flow control: clear to send */
+#define TEST_FC_WAIT            0x31U   /* First byte of a flow control: wait */
+#define TEST_FC_NONE            0xFFU   /* No flow control was received */
+
+#define TEST_BAD_SHORT          3U      /* First frames refused for their 12-bit length */
+#define TEST_BAD_ESCAPE         4U      /* First frames refused for their 32-bit length */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t       s_message[TEST_MAX_MESSAGE];
+
+/* What the transport handed over to the layer above */
+static uint8_t       s_received[TEST_MAX_MESSAGE + 64U];
+static uint32_t      s_receivedSize;
+static uint32_t      s_errors;
+static uint32_t      s_txDone;
+
+/* Frames sent by the bootloader, in the order they left the bus */
+static MSCAN_Frame_t s_sent[TEST_MAX_FRAMES];
+static uint32_t      s_numSent;
+
+/* Lengths of first frames whose message does not need the form they were given */
+static const uint8_t  s_badShort[TEST_BAD_SHORT]   = { 1U, 6U, 7U };
+static const uint16_t s_badEscape[TEST_BAD_ESCAPE] = { 0U, 1U, 7U, 4095U };
+
+static uint8_t       s_storm;           /* TRUE once an interrupt kept running without end */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/* Interrupt handlers of hal_mscan.c */
+void MSCAN_Rx_IRQHandler(void);
+void MSCAN_ORed_IRQHandler(void);
+
+
+/*
+ * @brief:    Takes the characters of a frame, as MID_PushBurst does
+ * @param[in] port: Index of the port
+ * @param[in] data: The characters
+ * @param[in] count: Number of characters
+ * @return:   0
+ */
+static int8_t TEST_PushBurst(const uint8_t port, const uint8_t *const data, const uint32_t count);
+
+
+/*
+ * @brief:    Takes a received character, as MID_PushData does
+ * @param[in] port: Index of the port
+ * @param[in] data: The character
+ * @return:   0
+ */
+static int8_t TEST_Push(const uint8_t port, const uint8_t data);
+
+
+/*
+ * @brief:    Counts the losses reported, as MID_ReceiveError does
+ * @param[in] port: Index of the port
+ * @return:   0
+ */
+static int8_t TEST_Error(const uint8_t port);
+
+
+/*
+ * @brief:  Counts the calls of the transmit callback
+ * @return: None
+ */
+static void TEST_TxDone(void);
+
+
+/*
+ * @brief:  Runs the interrupt handlers for as long as MSCAN requests them
+ * @return: None
+ */
+static void TEST_Interrupts(void);
+
+
+/*
+ * @brief:  Runs the interrupt handlers, which fill the empty transmit buffers, lets one frame
+ *          of the bootloader leave the bus, then runs them again
+ * @return: TRUE if a frame was sent
+ */
+static uint8_t TEST_BusStep(void);
+
+
+/*
+ * @brief:    Sends a frame from the host and runs the interrupt handlers
+ * @param[in] id: Identifier of the frame
+ * @param[in] data: Data bytes of the frame
+ * @param[in] length: Number of data bytes
+ * @return:   None
+ */
+static void TEST_Send(const uint16_t id, const uint8_t *const data, const uint8_t length);
+
+
+/*
+ * @brief:  Lets the bootloader send until a flow control leaves the bus
+ * @return: The first byte of the flow control, TEST_FC_NONE if none was sent
+ */
+static uint8_t TEST_WaitFlowControl(void);
+
+
+/*
+ * @brief:     Sends s_message as the host does: a first frame, then consecutive frames
+ *             in blocks of the size given by each flow control
+ * @param[in]  size: Size of the message
+ * @param[out] flowControls: Number of flow controls received
+ * @return:    0 if every flow control came when expected and was clear to send, 1 otherwise
+ */
+static uint8_t TEST_SendMessage(const uint32_t size, uint32_t *const flowControls);
+
+
+/*
+ * @brief:     Checks that a frame sent by the bootloader is well formed: its identifier,
+ *             8 bytes, and the padding after the bytes in use
+ * @param[in]  frame: The frame
+ * @param[in]  used: Number of bytes in use
+ * @return:    0 if it is, 1 otherwise
+ */
+static uint8_t TEST_CheckFrame(const MSCAN_Frame_t *const frame, const uint8_t used);
+
+
+/*
+ * @brief:     Prints the outcome of a check
+ * @param[in]  name: Name of the check
+ * @param[in]  failed: 0 if the check passed
+ * @return:    failed, as 0 or 1
+ */
+static uint8_t TEST_Report(const char *const name, const uint8_t failed);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Runs hal_mscan.c and hal_transport.c against a simulated MSCAN on a bus with the host:
+ *         start, single frames, segmented messages with their flow control, a pause, a missing
+ *         consecutive frame, a receive overrun, replies, and stop
+ */
+int main(void)
+{
+    static const uint8_t reply[20] = "0123456789abcdefghij";
+    uint8_t  frame[DRI_MSCAN_MAX_DATA];
+    uint8_t  retVal       = 0U;
+    uint8_t  failed       = 0U;
+    uint8_t  status       = 0U;
+    uint32_t index        = 0U;
+    uint32_t offset       = 0U;
+    uint32_t flowControls = 0U;
+    uint32_t first        = 0U;
+    uint32_t seed         = 0xCA7U;
+
+    for (index = 0U; index < TEST_MAX_MESSAGE; ++index)
+    {
+        seed ^= seed << 13U;
+        seed ^= seed >> 17U;
+        seed ^= seed << 5U;
+        s_message[index] = (uint8_t)seed;
+    }
+
+    HOST_Reset();
+    (void)HAL_getFuncAddress(TEST_Push);
+    (void)HAL_getErrorFuncAddress(TEST_Error);
+    (void)HAL_getBurstFuncAddress(TEST_PushBurst);
+    HAL_setTransmitCallback(TEST_TxDone);
+    HAL_Init();
+
+    /* Started: the pins are given to MSCAN, which listens to HAL_CAN_RX_ID only */
+    failed  = (MSCAN_MUX != PORTE->mux[MSCAN_RX_PIN]) || (MSCAN_MUX != PORTE->mux[MSCAN_TX_PIN]);
+    failed |= (0U == (g_hostNvic & (1UL << (uint32_t)MSCAN_Rx_IRQn)));
+    failed |= (0U == (g_hostNvic & (1UL << (uint32_t)MSCAN_ORed_IRQn)));
+    failed |= ((MSCAN_CANRIER_RXFIE_MASK | MSCAN_CANRIER_OVRIE_MASK) != g_hostMscan.CANRIER);
+    failed |= (HAL_CAN_RX_ID != g_hostMscan.filterId) || (0U != g_hostMscan.CANTIER);
+    retVal |= TEST_Report("init", failed);
+
+    /* Single frames: their bytes are handed over, a frame of another node is not received */
+    frame[0] = 0x05U;
+    (void)memcpy(&frame[1], s_message, 5U);
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    TEST_Send(HAL_CAN_RX_ID + 1U, frame, 8U);
+    frame[0] = 0x07U;
+    (void)memcpy(&frame[1], &s_message[5], 7U);
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    failed  = (12U != s_receivedSize) || (0 != memcmp(s_received, s_message, 12U));
+    failed |= (0U != s_errors) || (0U != s_numSent);
+    retVal |= TEST_Report("single frames", failed);
+
+    /* A message with a 12-bit length: clear to send after the first frame, then after every block */
+    s_receivedSize = 0U;
+    failed  = TEST_SendMessage(1000U, &flowControls);
+    failed |= (1000U != s_receivedSize) || (0 != memcmp(s_received, s_message, 1000U));
+    /* 994 bytes after the first frame: 142 consecutive frames, a flow control after each full block */
+    failed |= ((1U + ((142U - 1U) / HAL_CAN_BLOCK_SIZE)) != flowControls) || (0U != s_errors);
+    retVal |= TEST_Report("message", failed);
+
+    /* A message longer than 4095 bytes gives its length on 32 bits */
+    s_receivedSize = 0U;
+    failed  = TEST_SendMessage(5000U, &flowControls);
+    failed |= (5000U != s_receivedSize) || (0 != memcmp(s_received, s_message, 5000U));
+    failed |= (0U != s_errors);
+    retVal |= TEST_Report("message, 32-bit", failed);
+
+    /* Paused: the next flow control is a wait, clear to send follows the resume */
+    s_receivedSize = 0U;
+    HAL_requestFlowControl(TRUE);
+    frame[0] = 0x10U;
+    frame[1] = 20U;
+    (void)memcpy(&frame[2], s_message, 6U);
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    status  = TEST_WaitFlowControl();
+    failed  = (TEST_FC_WAIT != status) || (TEST_FC_NONE != TEST_WaitFlowControl());
+    HAL_requestFlowControl(FALSE);
+    status  = TEST_WaitFlowControl();
+    failed |= (TEST_FC_CTS != status);
+    for (index = 0U; index < 2U; ++index)
+    {
+        frame[0] = (uint8_t)(0x21U + index);
+        (void)memcpy(&frame[1], &s_message[6U + (index * 7U)], 7U);
+        TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    }
+    failed |= (20U != s_receivedSize) || (0 != memcmp(s_received, s_message, 20U)) || (0U != s_errors);
+    retVal |= TEST_Report("pause", failed);
+
+    /* A consecutive frame is missing: the loss is reported and the rest of the message dropped */
+    s_receivedSize = 0U;
+    frame[0] = 0x10U;
+    frame[1] = 30U;
+    (void)memcpy(&frame[2], s_message, 6U);
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    failed = (TEST_FC_CTS != TEST_WaitFlowControl());
+    frame[0] = 0x22U;
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    frame[0] = 0x23U;
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    failed |= (6U != s_receivedSize) || (1U != s_errors);
+    retVal |= TEST_Report("sequence", failed);
+
+    /* First frames of messages that fit in a single frame, or in a 12-bit length, are refused:
+     * nothing is handed over, no flow control is sent, and no consecutive frame is taken */
+    s_receivedSize = 0U;
+    s_errors       = 0U;
+    failed         = 0U;
+    for (index = 0U; index < (TEST_BAD_SHORT + TEST_BAD_ESCAPE); ++index)
+    {
+        (void)memset(frame, 0, sizeof(frame));
+        if (index < TEST_BAD_SHORT)
+        {
+            frame[0] = 0x10U;
+            frame[1] = s_badShort[index];
+        }
+        else
+        {
+            frame[0] = 0x10U;
+            frame[4] = (uint8_t)(s_badEscape[index - TEST_BAD_SHORT] >> 8U);
+            frame[5] = (uint8_t)s_badEscape[index - TEST_BAD_SHORT];
+        }
+        TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+        failed |= (TEST_FC_NONE != TEST_WaitFlowControl());
+        frame[0] = 0x21U;
+        TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+        failed |= ((index + 1U) != s_errors);
+    }
+    failed |= (0U != s_receivedSize);
+    /* The shortest message of each form is still taken */
+    failed |= TEST_SendMessage(8U, &flowControls) || (8U != s_receivedSize);
+    s_receivedSize = 0U;
+    failed |= TEST_SendMessage(4096U, &flowControls) || (4096U != s_receivedSize)
+              || (0 != memcmp(s_received, s_message, 4096U));
+    failed |= ((TEST_BAD_SHORT + TEST_BAD_ESCAPE) != s_errors);
+    retVal |= TEST_Report("first length", failed);
+
+    /* One frame more than the receive FIFO holds arrives before the interrupt runs */
+    s_receivedSize = 0U;
+    s_errors       = 0U;
+    for (index = 0U; index < (MSCAN_RX_FIFO_SIZE + 1U); ++index)
+    {
+        MSCAN_Frame_t single = { HAL_CAN_RX_ID, 2U, { 0x01U, (uint8_t)index } };
+
+        HOST_mscanDeliver(&single);
+    }
+    TEST_Interrupts();
+    failed = (MSCAN_RX_FIFO_SIZE != s_receivedSize);
+    for (index = 0U; index < s_receivedSize; ++index)
+    {
+        failed |= ((uint8_t)index != s_received[index]);
+    }
+    failed |= (1U != s_errors) || (1U != HAL_getRxErrors(0U)->overrun);
+    failed |= (0U != (g_hostMscan.CANRFLG & MSCAN_CANRFLG_OVRIF_MASK));
+    retVal |= TEST_Report("overrun", failed);
+
+    /* Replies leave in single frames of up to 7 bytes */
+    first  = s_numSent;
+    s_txDone = 0U;
+    failed = (sizeof(reply) != HAL_TransmitDataAsync(reply, sizeof(reply)));
+    while (TRUE == TEST_BusStep())
+    {
+        /* Let every frame leave */
+    }
+    offset = 0U;
+    for (index = first; index < s_numSent; ++index)
+    {
+        status  = s_sent[index].data[0];
+        failed |= (0U == status) || (status > 7U) || (0U != TEST_CheckFrame(&s_sent[index], 1U + status))
+                  || ((offset + status) > sizeof(reply)) || (0 != memcmp(&s_sent[index].data[1], &reply[offset], status));
+        offset += status;
+    }
+    failed |= (sizeof(reply) != offset) || (3U != (s_numSent - first));
+    failed |= (1U != s_txDone) || (FALSE != HAL_TransmitBusy()) || (0U != g_hostMscan.CANTIER);
+    retVal |= TEST_Report("replies", failed);
+
+    /* A first frame arrives while the transmit buffers are full of replies:
+     * its flow control takes the first buffer to empty and leaves ahead of the other replies */
+    first = s_numSent;
+    (void)HAL_TransmitDataAsync(s_message, 70U);
+    TEST_Interrupts();
+    failed = (0U != MSCAN_GetEmptyTransmit(MSCAN));
+    frame[0] = 0x10U;
+    frame[1] = 20U;
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    while (TRUE == TEST_BusStep())
+    {
+        /* Let every frame leave */
+    }
+    failed |= (TEST_FC_CTS != s_sent[first + 1U].data[0]) || (0U != TEST_CheckFrame(&s_sent[first + 1U], 3U));
+    failed |= ((first + 1U + 10U) != s_numSent) || (FALSE != HAL_TransmitBusy()) || (0U != g_hostMscan.CANTIER);
+
+    /* Two replies wait in the lower buffers when a first frame arrives:
+     * its flow control, in the last buffer, still leaves before them */
+    first = s_numSent;
+    (void)HAL_TransmitDataAsync(s_message, 14U);
+    TEST_Interrupts();
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    while (TRUE == TEST_BusStep())
+    {
+        /* Let every frame leave */
+    }
+    failed |= (TEST_FC_CTS != s_sent[first].data[0]) || ((first + 3U) != s_numSent);
+    retVal |= TEST_Report("flow first", failed);
+
+    failed = (0U != s_storm);
+    retVal |= TEST_Report("interrupts", failed);
+
+    /* Stopped */
+    HAL_DeInit();
+    failed  = (0U != (g_hostNvic & ((1UL << (uint32_t)MSCAN_Rx_IRQn) | (1UL << (uint32_t)MSCAN_ORed_IRQn))));
+    failed |= (FALSE != g_hostMscan.enabled) || (FALSE != g_hostClock[PCC_PORTE_INDEX]);
+    retVal |= TEST_Report("deinit", failed);
+
+    printf("mscan: %s\n", (0U == retVal) ? "PASS" : "FAIL");
+
+    return (int)retVal;
+}
+
+
+/*
+ * @brief: Takes the characters of a frame
+ */
+static int8_t TEST_PushBurst(const uint8_t port, const uint8_t *const data, const uint32_t count)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < count; ++index)
+    {
+        (void)TEST_Push(port, data[index]);
+    }
+
+    return 0;
+}
+
+
+/*
+ * @brief: Takes a received character
+ */
+static int8_t TEST_Push(const uint8_t port, const uint8_t data)
+{
+    if (s_receivedSize < sizeof(s_received))
+    {
+        s_received[s_receivedSize++] = data;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return 0;
+}
+
+
+/*
+ * @brief: Counts the losses reported
+ */
+static int8_t TEST_Error(const uint8_t port)
+{
+    s_errors++;
+
+    return 0;
+}
+
+
+/*
+ * @brief: Counts the calls of the transmit callback
+ */
+static void TEST_TxDone(void)
+{
+    s_txDone++;
+}
+
+
+/*
+ * @brief: Runs the interrupt handlers for as long as MSCAN requests them
+ */
+static void TEST_Interrupts(void)
+{
+    uint32_t count = 0U;
+
+    while ((count < TEST_MAX_INTERRUPTS)
+            && ((TRUE == HOST_mscanRxInterruptPending()) || (TRUE == HOST_mscanOredInterruptPending())))
+    {
+        if (TRUE == HOST_mscanRxInterruptPending())
+        {
+            MSCAN_Rx_IRQHandler();
+        }
+        else
+        {
+            MSCAN_ORed_IRQHandler();
+        }
+        HOST_mscanSync();
+        count++;
+    }
+
+    /* An interrupt that is still requested would run again at once */
+    if (TEST_MAX_INTERRUPTS == count)
+    {
+        s_storm = TRUE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @brief: Lets one frame of the bootloader leave the bus
+ */
+static uint8_t TEST_BusStep(void)
+{
+    MSCAN_Frame_t frame;
+    uint8_t       sent = FALSE;
+
+    TEST_Interrupts();
+    sent = HOST_mscanTransmit(&frame);
+    if ((TRUE == sent) && (s_numSent < TEST_MAX_FRAMES))
+    {
+        s_sent[s_numSent++] = frame;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+    TEST_Interrupts();
+
+    return sent;
+}
+
+
+/*
+ * @brief: Sends a frame from the host
+ */
+static void TEST_Send(const uint16_t id, const uint8_t *const data, const uint8_t length)
+{
+    MSCAN_Frame_t frame;
+
+    frame.id     = id;
+    frame.length = length;
+    (void)memcpy(frame.data, data, length);
+    HOST_mscanDeliver(&frame);
+    TEST_Interrupts();
+}
+
+
+/*
+ * @brief: Lets the bootloader send until a flow control leaves the bus
+ */
+static uint8_t TEST_WaitFlowControl(void)
+{
+    uint8_t  status = TEST_FC_NONE;
+    uint32_t steps  = 0U;
+
+    while ((TEST_FC_NONE == status) && (steps < TEST_MAX_BUS_STEPS) && (TRUE == TEST_BusStep()))
+    {
+        if (0x30U == (s_sent[s_numSent - 1U].data[0] & 0xF0U))
+        {
+            status = s_sent[s_numSent - 1U].data[0];
+            if ((0U != TEST_CheckFrame(&s_sent[s_numSent - 1U], 3U))
+                    || (HAL_CAN_BLOCK_SIZE != s_sent[s_numSent - 1U].data[1])
+                    || (HAL_CAN_STMIN != s_sent[s_numSent - 1U].data[2]))
+            {
+                status = TEST_FC_NONE;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        steps++;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Sends s_message as the host does
+ */
+static uint8_t TEST_SendMessage(const uint32_t size, uint32_t *const flowControls)
+{
+    uint8_t  frame[DRI_MSCAN_MAX_DATA];
+    uint8_t  retVal   = 0U;
+    uint8_t  block    = 0U;
+    uint8_t  sequence = 1U;
+    uint32_t offset   = 0U;
+    uint32_t length   = 0U;
+
+    if (size <= 4095U)
+    {
+        frame[0] = (uint8_t)(0x10U | (size >> 8U));
+        frame[1] = (uint8_t)size;
+        (void)memcpy(&frame[2], s_message, 6U);
+        offset = 6U;
+    }
+    else
+    {
+        frame[0] = 0x10U;
+        frame[1] = 0U;
+        frame[2] = (uint8_t)(size >> 24U);
+        frame[3] = (uint8_t)(size >> 16U);
+        frame[4] = (uint8_t)(size >> 8U);
+        frame[5] = (uint8_t)size;
+        (void)memcpy(&frame[6], s_message, 2U);
+        offset = 2U;
+    }
+    TEST_Send(HAL_CAN_RX_ID, frame, 8U);
+    *flowControls = 0U;
+
+    while (offset < size)
+    {
+        if (0U == block)
+        {
+            retVal |= (TEST_FC_CTS != TEST_WaitFlowControl());
+            (*flowControls)++;
+            block = HAL_CAN_BLOCK_SIZE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        length   = ((size - offset) < 7U) ? (size - offset) : 7U;
+        frame[0] = (uint8_t)(0x20U | sequence);
+        (void)memcpy(&frame[1], &s_message[offset], length);
+        /* The last frame is as long as its bytes */
+        TEST_Send(HAL_CAN_RX_ID, frame, (uint8_t)(1U + length));
+        offset  += length;
+        sequence = (sequence + 1U) & 0x0FU;
+        block--;
+    }
+
+    /* No flow control after the last consecutive frame */
+    retVal |= (TEST_FC_NONE != TEST_WaitFlowControl());
+
+    return retVal;
+}
+
+
+/*
+ * @brief: Checks that a frame sent by the bootloader is well formed
+ */
+static uint8_t TEST_CheckFrame(const MSCAN_Frame_t *const frame, const uint8_t used)
+{
+    uint8_t failed = 0U;
+    uint8_t index  = 0U;
+
+    failed = (HAL_CAN_TX_ID != frame->id) || (DRI_MSCAN_MAX_DATA != frame->length);
+    for (index = used; index < DRI_MSCAN_MAX_DATA; ++index)
+    {
+        failed |= (HAL_CAN_PADDING != frame->data[index]);
+    }
+
+    return failed;
+}
+
+
+/*
+ * @brief: Prints the outcome of a check
+ */
+static uint8_t TEST_Report(const char *const name, const uint8_t failed)
+{
+    printf("%-16s %s\n", name, (0U == failed) ? "ok" : "FAIL");
+
+    return (0U == failed) ? 0U : 1U;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,499 @@
+/*
+ * pipeline_test.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "app.h"
+#include "hal_host.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define PIPE_IMAGE_SIZE         (32U * 1024U)   /* Room for the generated image */
+#define PIPE_REPLY_SIZE         1024U           /* Room for the replies of the bootloader */
+#define PIPE_APP_LENGTH         3072U           /* Bytes of the generated application, three of its four sectors */
+#define PIPE_RECORD_LENGTH      16U             /* Data bytes per record */
+#define PIPE_BAD_RECORD         100U            /* Record given a bad checksum in the corrupted image */
+#define PIPE_MAX_STEPS          1000000U        /* app_process_action calls before a run is given up */
+#define PIPE_HEX_ENTRY          0x8100U         /* Start address given by the 05 record of the Intel HEX image */
+
+#define PIPE_BIN_LENGTH         (PIPE_APP_LENGTH - 72U)  /* Data of the binary image, not a whole number of chunks */
+
+#define PIPE_FORMAT_SREC        0U
+#define PIPE_FORMAT_IHEX        1U
+#define PIPE_FORMAT_BIN         2U
+
+#define PIPE_INTACT             0U              /* The image is sent as generated */
+#define PIPE_BAD_CHECKSUM       1U              /* Record PIPE_BAD_RECORD, or the CRC-32 of a binary image, is wrong */
+#define PIPE_BAD_HEADER         2U              /* The header checksum of a binary image is wrong */
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: What the bootloader did with an image
+ */
+typedef struct
+{
+    uint8_t  jumped;                      /* TRUE once HAL_jumpApplication has been called */
+    uint32_t jumpAddress;
+    uint32_t entryPoint;
+    uint32_t sent;                        /* Characters of the image taken by the loopback */
+    uint32_t steps;                       /* app_process_action calls */
+    char     reply[PIPE_REPLY_SIZE + 1U]; /* Replies of the bootloader, NUL terminated */
+    uint32_t replyLength;
+} Pipe_Result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t       s_image[PIPE_IMAGE_SIZE];
+static uint8_t       s_app[PIPE_APP_LENGTH];          /* Application written by the images */
+static uint8_t       s_oldApp[USER_APPLICATION01_SIZE_SPACE * 1024U];  /* Application already in flash */
+static Pipe_Result_t s_result;                        /* Static, as it is written on both sides of setjmp */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:        Appends one record to an image
+ * @param[in]     format: PIPE_FORMAT_SREC or PIPE_FORMAT_IHEX
+ * @param[in]     type: Record type, the digit of an S-record or the type field of an Intel HEX record
+ * @param[in]     address: Address field of the record
+ * @param[in]     data: Data field of the record
+ * @param[in]     count: Number of data bytes
+ * @param[in,out] size: Size of the image, the record is written from there
+ * @return:       None
+ */
+static void PIPE_AppendRecord(const uint8_t format, const uint8_t type, const uint32_t address,
+                              const uint8_t *const data, const uint8_t count, uint32_t *const size);
+
+
+/*
+ * @brief:     Generates an image of s_app at USER_APPLICATION01_ADDRESS
+ * @param[in]  format: PIPE_FORMAT_SREC, PIPE_FORMAT_IHEX or PIPE_FORMAT_BIN
+ * @param[in]  corrupt: PIPE_INTACT, PIPE_BAD_CHECKSUM or PIPE_BAD_HEADER
+ * @return:    Size of the image
+ */
+static uint32_t PIPE_BuildImage(const uint8_t format, const uint8_t corrupt);
+
+
+/*
+ * @brief:     Generates an S-record or Intel HEX image of s_app at USER_APPLICATION01_ADDRESS
+ * @param[in]  format: PIPE_FORMAT_SREC or PIPE_FORMAT_IHEX
+ * @param[in]  corrupt: PIPE_INTACT, or PIPE_BAD_CHECKSUM to give record PIPE_BAD_RECORD a bad checksum
+ * @return:    Size of the image
+ */
+static uint32_t PIPE_BuildTextImage(const uint8_t format, const uint8_t corrupt);
+
+
+/*
+ * @brief:     Generates a binary image of the first PIPE_BIN_LENGTH bytes of s_app
+ *             at USER_APPLICATION01_ADDRESS
+ * @param[in]  corrupt: PIPE_INTACT, PIPE_BAD_CHECKSUM or PIPE_BAD_HEADER
+ * @return:    Size of the image
+ */
+static uint32_t PIPE_BuildBinImage(const uint8_t corrupt);
+
+
+/*
+ * @brief:     Puts the old application in flash, starts the bootloader with the switch pressed and
+ *             sends the image through the loopback until the bootloader jumps
+ * @param[in]  size: Size of the image in s_image
+ * @return:    None, the outcome is in s_result
+ */
+static void PIPE_Run(const uint32_t size);
+
+
+/*
+ * @brief:  Moves the replies waiting in the loopback into s_result
+ * @return: None
+ */
+static void PIPE_ReadReplies(void);
+
+
+/*
+ * @brief:     Checks the outcome of a run
+ * @param[in]  name: Name of the image
+ * @param[in]  size: Size of the image
+ * @param[in]  message: Reply expected from the bootloader
+ * @param[in]  expected: Content expected at USER_APPLICATION01_ADDRESS
+ * @param[in]  length: Number of bytes of expected
+ * @param[in]  entryPoint: Entry point expected in HAL_jumpApplication
+ * @return:    0 if the run went as expected, 1 otherwise
+ */
+static uint8_t PIPE_Check(const char *const name, const uint32_t size, const char *const message,
+                          const uint8_t *const expected, const uint32_t length, const uint32_t entryPoint);
+
+
+/*
+ * @brief:     Checks that the bootloader ignored an image: it still waits for one, said nothing
+ *             more than ready, and the application space holds the old application
+ * @param[in]  name: Name of the image
+ * @param[in]  size: Size of the image
+ * @return:    0 if the image was ignored, 1 otherwise
+ */
+static uint8_t PIPE_CheckIgnored(const char *const name, const uint32_t size);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @brief: Sends an S-record image, an Intel HEX image, a binary image and corrupted S-record and
+ *         binary images through app_init and app_process_action, over the loopback transport and
+ *         a flash kept in memory
+ */
+int main(void)
+{
+    uint32_t index  = 0U;
+    uint32_t size   = 0U;
+    uint8_t  retVal = 0U;
+
+    for (index = 0U; index < sizeof(s_app); ++index)
+    {
+        s_app[index] = (uint8_t)((index * 13U) + 5U);
+    }
+    for (index = 0U; index < sizeof(s_oldApp); ++index)
+    {
+        s_oldApp[index] = (uint8_t)((index * 7U) ^ 0xA5U);
+    }
+
+    printf("%-14s %10s %10s %10s  %s\n", "image", "characters", "steps", "entry", "result");
+
+    size = PIPE_BuildImage(PIPE_FORMAT_SREC, PIPE_INTACT);
+    PIPE_Run(size);
+    retVal |= PIPE_Check("srec", size, "Done!", s_app, sizeof(s_app), USER_APPLICATION01_ADDRESS);
+
+    size = PIPE_BuildImage(PIPE_FORMAT_IHEX, PIPE_INTACT);
+    PIPE_Run(size);
+    retVal |= PIPE_Check("ihex", size, "Done!", s_app, sizeof(s_app), PIPE_HEX_ENTRY);
+
+    /* The last chunk of the binary image is shorter than BIN_CHUNK_LENGTH */
+    size = PIPE_BuildImage(PIPE_FORMAT_BIN, PIPE_INTACT);
+    PIPE_Run(size);
+    retVal |= PIPE_Check("bin", size, "Done!", s_app, PIPE_BIN_LENGTH, 0U);
+
+    /* The bootloader stops on the bad record and puts the old application back */
+    size = PIPE_BuildImage(PIPE_FORMAT_SREC, PIPE_BAD_CHECKSUM);
+    PIPE_Run(size);
+    retVal |= PIPE_Check("srec, corrupt", size, "Error!", s_oldApp, sizeof(s_oldApp), 0U);
+
+    /* The same for a binary image whose CRC-32 is wrong */
+    size = PIPE_BuildImage(PIPE_FORMAT_BIN, PIPE_BAD_CHECKSUM);
+    PIPE_Run(size);
+    retVal |= PIPE_Check("bin, bad crc", size, "Error!", s_oldApp, sizeof(s_oldApp), 0U);
+
+    /* A bad header is taken for noise, as no port is locked yet: the image is ignored */
+    size = PIPE_BuildImage(PIPE_FORMAT_BIN, PIPE_BAD_HEADER);
+    PIPE_Run(size);
+    retVal |= PIPE_CheckIgnored("bin, bad head", size);
+
+    printf("pipeline: %s\n", (0U == retVal) ? "PASS" : "FAIL");
+
+    return (int)retVal;
+}
+
+
+/*
+ * @brief: Appends one record to an image
+ */
+static void PIPE_AppendRecord(const uint8_t format, const uint8_t type, const uint32_t address,
+                              const uint8_t *const data, const uint8_t count, uint32_t *const size)
+{
+    uint8_t  bytes[4U + 255U + 1U];
+    uint16_t numBytes = 0U;
+    uint16_t index    = 0U;
+    uint8_t  sum      = 0U;
+    uint8_t  addrLen  = 0U;
+
+    if (PIPE_FORMAT_SREC == format)
+    {
+        /* S0/S1/S5/S9: 2 address bytes, S2/S8: 3, S3/S7: 4 */
+        addrLen = ((2U == type) || (8U == type)) ? 3U : (((3U == type) || (7U == type)) ? 4U : 2U);
+        bytes[numBytes++] = (uint8_t)(addrLen + count + 1U);
+        for (index = addrLen; index > 0U; --index)
+        {
+            bytes[numBytes++] = (uint8_t)(address >> ((index - 1U) * 8U));
+        }
+        (void)memcpy(&bytes[numBytes], data, count);
+        numBytes += count;
+        for (index = 0U; index < numBytes; ++index)
+        {
+            sum += bytes[index];
+        }
+        bytes[numBytes++] = (uint8_t)~sum;
+        *size += (uint32_t)sprintf((char *)&s_image[*size], "S%u", (unsigned)type);
+    }
+    else
+    {
+        bytes[numBytes++] = count;
+        bytes[numBytes++] = (uint8_t)(address >> 8U);
+        bytes[numBytes++] = (uint8_t)address;
+        bytes[numBytes++] = type;
+        (void)memcpy(&bytes[numBytes], data, count);
+        numBytes += count;
+        for (index = 0U; index < numBytes; ++index)
+        {
+            sum += bytes[index];
+        }
+        bytes[numBytes++] = (uint8_t)(0U - sum);
+        s_image[(*size)++] = ':';
+    }
+
+    for (index = 0U; index < numBytes; ++index)
+    {
+        *size += (uint32_t)sprintf((char *)&s_image[*size], "%02X", bytes[index]);
+    }
+    *size += (uint32_t)sprintf((char *)&s_image[*size], "\r\n");
+}
+
+
+/*
+ * @brief: Generates an image of s_app at USER_APPLICATION01_ADDRESS
+ */
+static uint32_t PIPE_BuildImage(const uint8_t format, const uint8_t corrupt)
+{
+    return (PIPE_FORMAT_BIN == format) ? PIPE_BuildBinImage(corrupt) : PIPE_BuildTextImage(format, corrupt);
+}
+
+
+/*
+ * @brief: Generates an S-record or Intel HEX image of s_app at USER_APPLICATION01_ADDRESS
+ */
+static uint32_t PIPE_BuildTextImage(const uint8_t format, const uint8_t corrupt)
+{
+    static const uint8_t header[] = "pipeline";
+    uint8_t  start[4U] = { 0U, 0U, (uint8_t)(PIPE_HEX_ENTRY >> 8U), (uint8_t)PIPE_HEX_ENTRY };
+    uint8_t  upper[2U] = { 0U, 0U };
+    uint32_t size      = 0U;
+    uint32_t offset    = 0U;
+    uint32_t record    = 0U;
+
+    if (PIPE_FORMAT_SREC == format)
+    {
+        PIPE_AppendRecord(format, 0U, 0U, header, (uint8_t)(sizeof(header) - 1U), &size);
+    }
+    else
+    {
+        /* Upper address 0, then the start address given back by the End Of File record */
+        PIPE_AppendRecord(format, 0x04U, 0U, upper, sizeof(upper), &size);
+        PIPE_AppendRecord(format, 0x05U, 0U, start, sizeof(start), &size);
+    }
+
+    for (offset = 0U; offset < sizeof(s_app); offset += PIPE_RECORD_LENGTH)
+    {
+        PIPE_AppendRecord(format, (PIPE_FORMAT_SREC == format) ? 1U : 0x00U,
+                          USER_APPLICATION01_ADDRESS + offset, &s_app[offset], PIPE_RECORD_LENGTH, &size);
+        if ((PIPE_BAD_CHECKSUM == corrupt) && (PIPE_BAD_RECORD == record))
+        {
+            /* The last digit of the checksum, before "\r\n" */
+            s_image[size - 3U] = ('0' == s_image[size - 3U]) ? '1' : '0';
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        record++;
+    }
+
+    if (PIPE_FORMAT_SREC == format)
+    {
+        PIPE_AppendRecord(format, 9U, USER_APPLICATION01_ADDRESS, s_app, 0U, &size);
+    }
+    else
+    {
+        PIPE_AppendRecord(format, 0x01U, 0U, s_app, 0U, &size);
+    }
+
+    return size;
+}
+
+
+/*
+ * @brief: Generates a binary image of the first PIPE_BIN_LENGTH bytes of s_app
+ */
+static uint32_t PIPE_BuildBinImage(const uint8_t corrupt)
+{
+    uint32_t size  = 0U;
+    uint32_t index = 0U;
+    uint32_t crc   = 0xFFFFFFFFU;
+    uint8_t  sum   = 0U;
+    uint8_t  bit   = 0U;
+
+    s_image[size++] = BIN_MAGIC;
+    for (index = 4U; index > 0U; --index)
+    {
+        s_image[size++] = (uint8_t)(USER_APPLICATION01_ADDRESS >> ((index - 1U) * 8U));
+    }
+    for (index = 4U; index > 0U; --index)
+    {
+        s_image[size++] = (uint8_t)(PIPE_BIN_LENGTH >> ((index - 1U) * 8U));
+    }
+    /* The header bytes, checksum included, add up to 0xFF */
+    for (index = 1U; index < size; ++index)
+    {
+        sum += s_image[index];
+    }
+    s_image[size++] = (uint8_t)(0xFFU - sum + ((PIPE_BAD_HEADER == corrupt) ? 1U : 0U));
+
+    /* CRC-32 of the data, bit by bit with the reflected polynomial, as the decoder should give */
+    for (index = 0U; index < PIPE_BIN_LENGTH; ++index)
+    {
+        s_image[size++] = s_app[index];
+        crc ^= s_app[index];
+        for (bit = 0U; bit < 8U; ++bit)
+        {
+            crc = (0U != (crc & 1U)) ? ((crc >> 1U) ^ 0xEDB88320U) : (crc >> 1U);
+        }
+    }
+    crc ^= 0xFFFFFFFFU;
+    crc ^= (PIPE_BAD_CHECKSUM == corrupt) ? 1U : 0U;
+    for (index = 4U; index > 0U; --index)
+    {
+        s_image[size++] = (uint8_t)(crc >> ((index - 1U) * 8U));
+    }
+
+    return size;
+}
+
+
+/*
+ * @brief: Sends the image through the loopback until the bootloader jumps
+ */
+static void PIPE_Run(const uint32_t size)
+{
+    (void)memset(&s_result, 0, sizeof(s_result));
+    (void)memset(g_hostFlash, 0xFF, sizeof(g_hostFlash));
+    (void)memcpy(&g_hostFlash[USER_APPLICATION01_ADDRESS], s_oldApp, sizeof(s_oldApp));
+    g_hostFlashErrors = 0U;
+    g_hostSwitch      = SWITCH_PRESSED;
+
+    if (0 == setjmp(g_hostJump))
+    {
+        app_init();
+        while (s_result.steps < PIPE_MAX_STEPS)
+        {
+            /* The host sends as much as the loopback takes, nothing while it is paused */
+            s_result.sent += HAL_loopbackWrite(&s_image[s_result.sent], size - s_result.sent);
+            app_process_action();
+            PIPE_ReadReplies();
+            s_result.steps++;
+        }
+    }
+    else
+    {
+        s_result.jumped      = TRUE;
+        s_result.jumpAddress = g_hostJumpAddress;
+        s_result.entryPoint  = g_hostEntryPoint;
+    }
+    /* The last reply is sent right before the jump */
+    PIPE_ReadReplies();
+}
+
+
+/*
+ * @brief: Moves the replies waiting in the loopback into s_result
+ */
+static void PIPE_ReadReplies(void)
+{
+    s_result.replyLength += HAL_loopbackRead((uint8_t *)&s_result.reply[s_result.replyLength],
+                                             PIPE_REPLY_SIZE - s_result.replyLength);
+    s_result.reply[s_result.replyLength] = '\0';
+}
+
+
+/*
+ * @brief: Checks the outcome of a run
+ */
+static uint8_t PIPE_Check(const char *const name, const uint32_t size, const char *const message,
+                          const uint8_t *const expected, const uint32_t length, const uint32_t entryPoint)
+{
+    uint8_t retVal = 0U;
+
+    if ((TRUE != s_result.jumped) || (USER_APPLICATION01_ADDRESS != s_result.jumpAddress)
+            || (entryPoint != s_result.entryPoint))
+    {
+        printf("%s: no jump to 0x%X, entry 0x%X\n", name,
+               (unsigned)USER_APPLICATION01_ADDRESS, (unsigned)entryPoint);
+        retVal = 1U;
+    }
+    else if ((NULL == strstr(s_result.reply, "ready")) || (NULL == strstr(s_result.reply, message)))
+    {
+        printf("%s: no \"%s\" in the replies \"%s\"\n", name, message, s_result.reply);
+        retVal = 1U;
+    }
+    else if (0 != memcmp(&g_hostFlash[USER_APPLICATION01_ADDRESS], expected, length))
+    {
+        printf("%s: the application space does not hold the expected image\n", name);
+        retVal = 1U;
+    }
+    else if (0 != memcmp(&g_hostFlash[BACKUP_APPLICATION_ADDRESS], s_oldApp, sizeof(s_oldApp)))
+    {
+        printf("%s: the backup does not hold the old application\n", name);
+        retVal = 1U;
+    }
+    else if (0U != g_hostFlashErrors)
+    {
+        printf("%s: %u longwords programmed without being erased\n", name, (unsigned)g_hostFlashErrors);
+        retVal = 1U;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    printf("%-14s %10u %10u %#10x  %s\n", name, (unsigned)size, (unsigned)s_result.steps,
+           (unsigned)s_result.entryPoint, (0U == retVal) ? "ok" : "FAIL");
+
+    return retVal;
+}
+
+
+/*
+ * @brief: Checks that the bootloader ignored an image
+ */
+static uint8_t PIPE_CheckIgnored(const char *const name, const uint32_t size)
+{
+    uint8_t retVal = 0U;
+
+    if (FALSE != s_result.jumped)
+    {
+        printf("%s: jump to 0x%X\n", name, (unsigned)s_result.jumpAddress);
+        retVal = 1U;
+    }
+    else if ((NULL == strstr(s_result.reply, "ready")) || (NULL != strstr(s_result.reply, "Error!"))
+             || (NULL != strstr(s_result.reply, "Done!")))
+    {
+        printf("%s: unexpected replies \"%s\"\n", name, s_result.reply);
+        retVal = 1U;
+    }
+    else if ((0 != memcmp(&g_hostFlash[USER_APPLICATION01_ADDRESS], s_oldApp, sizeof(s_oldApp)))
+             || (0U != g_hostFlashErrors))
+    {
+        printf("%s: the application space was written\n", name);
+        retVal = 1U;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    printf("%-14s %10u %10u %#10x  %s\n", name, (unsigned)size, (unsigned)s_result.steps,
+           (unsigned)s_result.entryPoint, (0U == retVal) ? "ok" : "FAIL");
+
+    return retVal;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,354 @@
+/*
+ * srec_base.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "srec_base.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Built twice: once as it ran on the target, once counting every read of the line */
+#ifdef BASE_COUNT_READS
+#define BASE_READ(line, index)      (g_baseReads++, (line)[(index)])
+#define BASE_API(name)              name##Counted
+#else
+#define BASE_READ(line, index)      ((line)[(index)])
+#define BASE_API(name)              name
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef BASE_COUNT_READS
+uint32_t g_baseReads;
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/* Copies of the baseline Srec.c, each character of the line being read once per visit through BASE_READ */
+static Srec_Status_t SREC_checkSyntax(const uint8_t *const srecLine);
+static Srec_Status_t SREC_Checksum(const uint8_t *const srecLine);
+static Srec_Status_t SREC_CheckByteCount(const uint8_t *const srecLine);
+static Srec_Status_t SREC_CheckRecordStart(const uint8_t *const srecLine);
+static Srec_Status_t SREC_CheckRecordType(const uint8_t *const srecLine);
+static int32_t SREC_convertStrToDec(const uint8_t* Str);
+static size_t SREC_lengthLineSrec(const uint8_t *str);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:  BASE_DecodeLine
+ * ----------------------------
+ * @brief: The five checks of the first bootloader, then the conversion of the fields
+ */
+Srec_Status_t BASE_API(BASE_DecodeLine)(const uint8_t *const line, Srec_Record_t *const record)
+{
+    static const uint8_t addressLength[10U] = { 2U, 2U, 3U, 4U, 0U, 2U, 3U, 4U, 3U, 2U };
+    Srec_Status_t statusRecord = SREC_ERROR;
+    uint8_t       index        = 0U;
+    uint8_t       offset       = 0U;
+
+    /* MID_Parse_Record of the baseline */
+    statusRecord = SREC_checkSyntax(line);
+    if (statusRecord == SREC_OK)
+    {
+        statusRecord = SREC_CheckRecordStart(line);
+        if (statusRecord == SREC_OK)
+        {
+            statusRecord = SREC_Checksum(line);
+            if (statusRecord == SREC_OK)
+            {
+                statusRecord = SREC_CheckByteCount(line);
+                if (statusRecord == SREC_OK)
+                {
+                    statusRecord = SREC_CheckRecordType(line);
+                }
+            }
+        }
+    }
+
+    /* The baseline took a record too short for its address, and converted the characters
+     * of the next line. It is rejected here, so that the fields are read within the line */
+    if ((SREC_OK == statusRecord)
+            && ((uint8_t)SREC_convertStrToDec(&line[2U]) <= addressLength[BASE_READ(line, 1U) - '0']))
+    {
+        statusRecord = SREC_ERROR;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* calculateAddress and tempBuff of the baseline, two characters per byte */
+    if (SREC_OK == statusRecord)
+    {
+        record->type    = (uint8_t)(BASE_READ(line, 1U) - '0');
+        record->address = 0U;
+        offset          = 4U;
+        for (index = 0U; index < addressLength[record->type]; ++index)
+        {
+            record->address = (record->address << 8U) | (uint8_t)SREC_convertStrToDec(&line[offset]);
+            offset         += 2U;
+        }
+
+        record->length = (uint8_t)(SREC_convertStrToDec(&line[2U]) - addressLength[record->type] - 1U);
+        for (index = 0U; index < record->length; ++index)
+        {
+            record->data[index] = (uint8_t)SREC_convertStrToDec(&line[offset]);
+            offset             += 2U;
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    record->status = statusRecord;
+
+    return statusRecord;
+}
+
+
+/*
+ * @name:  BASE_ConvertBytes
+ * ----------------------------
+ * @brief: Convert a string of hexadecimal characters with SREC_convertStrToDec
+ */
+uint8_t BASE_API(BASE_ConvertBytes)(const uint8_t *const str, uint8_t *const bytes, const uint16_t count)
+{
+    uint16_t index = 0U;
+    uint8_t  sum   = 0U;
+
+    for (index = 0U; index < count; ++index)
+    {
+        bytes[index] = (uint8_t)SREC_convertStrToDec(&str[2U * index]);
+        sum         += bytes[index];
+    }
+
+    return sum;
+}
+
+
+/*
+ * @name:  SREC_checkSyntax
+ * ----------------------------
+ * @brief: Check the syntax of an SREC record line.
+ */
+static Srec_Status_t SREC_checkSyntax(const uint8_t *const srecLine)
+{
+    Srec_Status_t status    = SREC_OK;
+    uint8_t       index     = 1U;
+    uint8_t       length    = 0U;
+    uint8_t       character = 0U;
+
+    if (srecLine != NULL)
+    {
+        length = SREC_lengthLineSrec(srecLine) - 2U;
+
+        for(index = 1U; index < length; ++index)
+        {
+            character = BASE_READ(srecLine, index);
+            if (!(((character >= '0') && (character <= '9'))
+                    || ((character >= 'A') && (character <= 'F'))))
+                    {
+                        index  = length; /*Break out the loop*/
+                        status = SREC_ERROR;
+                    }
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+        }
+    }
+    else
+    {
+        status = SREC_ERROR;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  SREC_Checksum
+ * ----------------------------
+ * @brief: Calculate and verify the checksum of an SREC record
+ */
+static Srec_Status_t SREC_Checksum(const uint8_t *const srecLine)
+{
+    Srec_Status_t status   = SREC_OK;
+    uint8_t       sum      = 0U;
+    uint8_t       index    = 0U;
+    uint8_t       checkSum = 0U;
+    uint8_t       length   = 0U;
+    uint8_t       tmp      = 0U;
+
+    if (NULL != srecLine)
+    {
+        length = SREC_lengthLineSrec(srecLine);
+        tmp    = (length - 6U) / 2U;
+
+        for (index = 1U; index <= tmp; ++index)
+        {
+            sum += SREC_convertStrToDec(&srecLine[(2U * index)]);
+        }
+
+        checkSum = SREC_convertStrToDec(&srecLine[(length - 4U)]);
+
+        (0xFFU == (uint8_t)(sum + checkSum)) ? (status = SREC_OK) : (status = SREC_ERROR);
+    }
+    else
+    {
+        status = SREC_ERROR;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  SREC_CheckByteCount
+ * ----------------------------
+ * @brief: Check the byteCount field of an SREC record
+ */
+static Srec_Status_t SREC_CheckByteCount(const uint8_t *const srecLine)
+{
+    Srec_Status_t status       = SREC_ERROR;
+    uint8_t       byteCount    = 0U;
+    uint8_t       byteCountCal = 0U;
+
+    if (NULL != srecLine)
+    {
+        byteCount    = SREC_convertStrToDec(&srecLine[2U]) * 2U;
+        byteCountCal = SREC_lengthLineSrec(srecLine) - 6U;
+        (byteCount == byteCountCal) ? (status = SREC_OK) : (status = SREC_ERROR);
+    }
+    else
+    {
+        status = SREC_ERROR;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name: SREC_CheckRecordStart
+ * ----------------------------
+ * @brief: Check the start field of an SREC record
+ */
+static Srec_Status_t SREC_CheckRecordStart(const uint8_t *const srecLine)
+{
+    Srec_Status_t status = SREC_ERROR;
+
+    if (NULL != srecLine)
+    {
+        (BASE_READ(srecLine, 0U) == 'S') ? (status = SREC_OK) : (status = SREC_ERROR);
+    }
+    else
+    {
+        status = SREC_ERROR;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  SREC_CheckRecordStart
+ * ----------------------------
+ * @brief: Check the recordType field of an SREC record
+ */
+static Srec_Status_t SREC_CheckRecordType(const uint8_t *const srecLine)
+{
+    Srec_Status_t status = SREC_ERROR;
+
+    if (NULL != srecLine)
+    {
+        switch (BASE_READ(srecLine, 1U))
+        {
+            case '0':  /* Header */
+            case '1':  /* Data */
+            case '2':  /* Data */
+            case '3':  /* Data */
+            case '5':  /* Count */
+            case '6':  /* Count */
+            case '7':  /* Start Address (Termination) */
+            case '8':  /* Start Address (Termination) */
+            case '9':  /* Start Address (Termination) */
+                status = SREC_OK;
+                break;
+
+            default:
+                status = SREC_ERROR;
+                break;
+        }
+    }
+    else
+    {
+        status = SREC_ERROR;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  SREC_convertStrToDec
+ * ----------------------------
+ * @brief: Convert the first two characters of a string to an integer in decimal format
+ */
+static int32_t SREC_convertStrToDec(const uint8_t* Str)
+{
+    uint8_t index     = 0U;
+    int32_t retVal    = 0U;
+    uint8_t character = 0U;
+
+    if (Str != NULL)
+    {
+        for (index = 0U; index < 2U; ++index)
+        {
+            /* Convert the character-form numbers to corresponding integer-form numbers */
+            character = BASE_READ(Str, index);
+            retVal   += ((character >= 'A') ? (character - 'A' + 10U) : (uint32_t)(character - '0')) << (4U * (1U - index));
+        }
+    }
+    else
+    {
+        retVal = -1; /* Return an error status if the string to be converted is invalid */
+    }
+
+    return retVal;
+}
+
+
+/*
+ * @name:  SREC_lengthLineSrec
+ * ----------------------------
+ * @brief: Calculate the length of a line in SREC format
+ */
+static size_t SREC_lengthLineSrec(const uint8_t *str)
+{
+    size_t length = 0U;
+
+    while (BASE_READ(str, length) != '\n')
+    {
+        length++;
+    }
+
+    return (++length);
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
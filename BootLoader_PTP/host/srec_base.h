@@ -0,0 +1,62 @@
+/*
+ * srec_base.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_SREC_BASE_H_
+#define _INC_SREC_BASE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "Srec.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Characters of the line read by the functions suffixed Counted */
+extern uint32_t g_baseReads;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       BASE_DecodeLine
+ * ----------------------------
+ * @brief:      The record path of the first bootloader: the five checks of the line
+ *              (syntax, start, checksum, byteCount, record type), each walking the line
+ *              on its own, then the conversion of the address and data fields
+ * @param[in]:  line: Pointer to the first character of the line, which ends with "\r\n"
+ *              and holds at most 255 characters
+ * @param[out]: record: The decoded record, its data field must hold SREC_MAX_DATA_LENGTH bytes
+ * @return:     SREC_OK if the record passed the five checks, SREC_ERROR otherwise
+ * @note:       BASE_DecodeLineCounted is the same, and adds the characters it reads to g_baseReads
+ */
+Srec_Status_t BASE_DecodeLine(const uint8_t *const line, Srec_Record_t *const record);
+Srec_Status_t BASE_DecodeLineCounted(const uint8_t *const line, Srec_Record_t *const record);
+
+
+/*
+ * @name:       BASE_ConvertBytes
+ * ----------------------------
+ * @brief:      Convert a string of hexadecimal characters one byte at a time with the
+ *              SREC_convertStrToDec of the baseline, which does not check the characters
+ * @param[in]:  str: Pointer to the characters to be converted (2 * count characters)
+ * @param[out]: bytes: Pointer to the buffer receiving the converted bytes
+ * @param[in]:  count: Number of bytes to be converted
+ * @return:     The 8-bit sum of the converted bytes
+ * @note:       BASE_ConvertBytesCounted is the same, and adds the characters it reads to g_baseReads
+ */
+uint8_t BASE_ConvertBytes(const uint8_t *const str, uint8_t *const bytes, const uint16_t count);
+uint8_t BASE_ConvertBytesCounted(const uint8_t *const str, uint8_t *const bytes, const uint16_t count);
+
+#endif /* _INC_SREC_BASE_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
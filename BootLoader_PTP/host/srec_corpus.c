@@ -0,0 +1,253 @@
+/*
+ * srec_corpus.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <string.h>
+#include "srec_corpus.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define CORPUS_LINE_SIZE        520U   /* 'S', type, 255 bytes in hexadecimal and "\r\n" */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint32_t s_random;              /* State of the xorshift generator */
+static uint32_t s_lines;               /* Lines written so far, picks the line ending */
+static uint8_t  s_crlf;                /* TRUE if every line ends with "\r\n" */
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Hexadecimal digits, upper case as the decoder expects */
+static const char s_hexDigits[] = "0123456789ABCDEF";
+
+/* Characters that are not hexadecimal digits, lower case included */
+static const char s_badChars[] = "GZaf g:@/\x7F";
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:  Gets the next number of the xorshift generator
+ * @return: A pseudo-random 32-bit number
+ */
+static uint32_t CORPUS_Random(void);
+
+
+/*
+ * @brief:     Writes one record without its line ending
+ * @param[out] line: Pointer to the buffer receiving the record (CORPUS_LINE_SIZE characters)
+ * @param[in]  type: Record type (0..9)
+ * @param[in]  byteCount: byteCount field of the record
+ * @param[in]  address: Address field, cut to the length of the record type
+ * @return:    Number of characters written
+ */
+static uint32_t CORPUS_WriteRecord(char *const line, const uint8_t type,
+                                   const uint8_t byteCount, const uint32_t address);
+
+
+/*
+ * @brief:     Appends a line and its line ending to the image
+ * @param[out] buffer: Pointer to the image
+ * @param[in]  size: Size of the image buffer
+ * @param[in]  offset: Number of characters already in the image
+ * @param[in]  line: Pointer to the line
+ * @param[in]  length: Number of characters of the line
+ * @return:    The new number of characters in the image, 0 if it does not fit
+ */
+static uint32_t CORPUS_Append(uint8_t *const buffer, const uint32_t size, const uint32_t offset,
+                              const char *const line, const uint32_t length);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:  CORPUS_Generate
+ * ----------------------------
+ * @brief: Write an SREC image with every record type and byteCount, and faulty copies
+ */
+uint32_t CORPUS_Generate(uint8_t *const buffer, const uint32_t size, const uint32_t seed,
+                         const uint8_t maxByteCount, const uint8_t faults)
+{
+    char     line[CORPUS_LINE_SIZE];
+    uint32_t offset    = 0U;
+    uint32_t length    = 0U;
+    uint32_t address   = 0U;
+    uint32_t records   = 0U;
+    uint32_t position  = 0U;
+    uint8_t  type      = 0U;
+    uint8_t  fault     = 0U;
+    uint16_t byteCount = 0U;
+
+    s_random = (0U != seed) ? seed : 1U;
+    s_lines  = 0U;
+    s_crlf   = (0U != (faults & CORPUS_CRLF)) ? 1U : 0U;
+
+    length = CORPUS_WriteRecord(line, 0U, 3U, 0U);
+    offset = CORPUS_Append(buffer, size, offset, line, length);
+
+    for (type = 1U; (type <= 3U) && (0U != offset); ++type)
+    {
+        for (byteCount = 1U; (byteCount <= maxByteCount) && (0U != offset); ++byteCount)
+        {
+            length  = CORPUS_WriteRecord(line, type, (uint8_t)byteCount, address);
+            offset  = CORPUS_Append(buffer, size, offset, line, length);
+            address += byteCount;
+            records++;
+
+            /* Each of the three faults has one chance in twelve */
+            fault = (uint8_t)(faults & CORPUS_FAULT_ALL & (1U << (CORPUS_Random() % 12U)));
+            if (0U != fault)
+            {
+                /* A faulty copy of the record follows the valid one */
+                if (CORPUS_FAULT_CHECKSUM == fault)
+                {
+                    line[length - 1U] = (line[length - 1U] == '0') ? '1' : '0';
+                }
+                else if (CORPUS_FAULT_CHAR == fault)
+                {
+                    line[CORPUS_Random() % length] = s_badChars[CORPUS_Random() % (sizeof(s_badChars) - 1U)];
+                }
+                else
+                {
+                    /* Cut after the record type at the earliest, so that the line is not empty */
+                    position = 2U + (CORPUS_Random() % (length - 2U));
+                    length   = position;
+                }
+                offset = CORPUS_Append(buffer, size, offset, line, length);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+
+    if (0U != offset)
+    {
+        length = CORPUS_WriteRecord(line, 5U, 3U, records);
+        offset = CORPUS_Append(buffer, size, offset, line, length);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (0U != offset)
+    {
+        length = CORPUS_WriteRecord(line, 9U, 3U, 0U);
+        offset = CORPUS_Append(buffer, size, offset, line, length);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return offset;
+}
+
+
+/*
+ * @brief: Gets the next number of the xorshift generator
+ */
+static uint32_t CORPUS_Random(void)
+{
+    s_random ^= s_random << 13U;
+    s_random ^= s_random >> 17U;
+    s_random ^= s_random << 5U;
+
+    return s_random;
+}
+
+
+/*
+ * @brief: Writes one record without its line ending
+ */
+static uint32_t CORPUS_WriteRecord(char *const line, const uint8_t type,
+                                   const uint8_t byteCount, const uint32_t address)
+{
+    static const uint8_t addressLength[10U] = { 2U, 2U, 3U, 4U, 0U, 2U, 3U, 4U, 3U, 2U };
+    uint32_t length = 0U;
+    uint8_t  sum    = 0U;
+    uint8_t  value  = 0U;
+    uint16_t index  = 0U;
+
+    line[length++] = 'S';
+    line[length++] = (char)('0' + type);
+
+    /* byteCount, then the address bytes, then the data bytes, the checksum last */
+    for (index = 0U; index < byteCount; ++index)
+    {
+        if (0U == index)
+        {
+            value = byteCount;
+        }
+        else if (index <= addressLength[type])
+        {
+            value = (uint8_t)(address >> (8U * (addressLength[type] - index)));
+        }
+        else
+        {
+            value = (uint8_t)CORPUS_Random();
+        }
+
+        sum            += value;
+        line[length++]  = s_hexDigits[value >> 4U];
+        line[length++]  = s_hexDigits[value & 0x0FU];
+    }
+
+    /* The checksum closes the record, whatever its byteCount */
+    value          = (uint8_t)~sum;
+    line[length++] = s_hexDigits[value >> 4U];
+    line[length++] = s_hexDigits[value & 0x0FU];
+
+    return length;
+}
+
+
+/*
+ * @brief: Appends a line and its line ending to the image
+ */
+static uint32_t CORPUS_Append(uint8_t *const buffer, const uint32_t size, const uint32_t offset,
+                              const char *const line, const uint32_t length)
+{
+    uint32_t retVal = 0U;
+
+    if ((offset + length + 2U) <= size)
+    {
+        (void)memcpy(&buffer[offset], line, length);
+        retVal = offset + length;
+        if ((0U != s_crlf) || (0U != (s_lines & 1U)))
+        {
+            buffer[retVal++] = '\r';
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        buffer[retVal++] = '\n';
+        s_lines++;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return retVal;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,53 @@
+/*
+ * srec_corpus.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_SREC_CORPUS_H_
+#define _INC_SREC_CORPUS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define CORPUS_FAULT_NONE          0x00U  /* Valid records only */
+#define CORPUS_FAULT_CHECKSUM      0x01U  /* Records with a wrong checksum */
+#define CORPUS_FAULT_CHAR          0x02U  /* Records holding a character that is not a hexadecimal digit */
+#define CORPUS_FAULT_TRUNCATED     0x04U  /* Records cut short before their newline */
+#define CORPUS_FAULT_ALL           (CORPUS_FAULT_CHECKSUM | CORPUS_FAULT_CHAR | CORPUS_FAULT_TRUNCATED)
+#define CORPUS_CRLF                0x80U  /* Every line ends with "\r\n", as the baseline parser requires */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       CORPUS_Generate
+ * ----------------------------
+ * @brief:      Write an SREC image made of an S0 header, then S1, S2 and S3 records
+ *              with every byteCount from 1 to maxByteCount, then an S5 count and an S9
+ *              termination record. Lines end with "\n" or "\r\n" in turn, unless CORPUS_CRLF is set.
+ *              byteCounts that leave no room for the address and checksum are rejected
+ *              by the decoder, and make up the byteCount faults of the image
+ * @param[out]: buffer: Pointer to the buffer receiving the image
+ * @param[in]:  size: Size of the buffer
+ * @param[in]:  seed: Seed of the pseudo-random data bytes and faults
+ * @param[in]:  maxByteCount: Largest byteCount written (1..255)
+ * @param[in]:  faults: CORPUS_FAULT_* flags, a faulty copy follows about one record in four,
+ *              and CORPUS_CRLF
+ * @return:     Number of characters written, 0 if the buffer is too small
+ */
+uint32_t CORPUS_Generate(uint8_t *const buffer, const uint32_t size, const uint32_t seed,
+                         const uint8_t maxByteCount, const uint8_t faults);
+
+#endif /* _INC_SREC_CORPUS_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,195 @@
+/*
+ * srec_ref.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "srec_ref.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Gets the value of a hexadecimal digit ('0'..'9', 'A'..'F')
+ * @param[in]  character: The digit
+ * @return:    The value of the digit, -1 for any other character
+ */
+static int32_t REF_Digit(const uint8_t character);
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:  REF_DecodeLine
+ * ----------------------------
+ * @brief: Reference SREC decoder, the whole line is checked then converted
+ */
+Srec_Status_t REF_DecodeLine(const uint8_t *const line, const uint32_t length,
+                             Srec_Record_t *const record)
+{
+    static const int32_t addressLength[10U] = { 2, 2, 3, 4, -1, 2, 3, 4, 3, 2 };
+    Srec_Status_t status    = SREC_OK;
+    uint8_t       bytes[256U];
+    uint32_t      numBytes  = 0U;
+    uint32_t      index     = 0U;
+    uint8_t       sum       = 0U;
+    int32_t       type      = -1;
+
+    /* Start field and record type */
+    if ((length < 4U) || ('S' != line[0U]) || (line[1U] < '0') || (line[1U] > '9'))
+    {
+        status = SREC_ERROR;
+    }
+    else
+    {
+        type = line[1U] - '0';
+        if ((addressLength[type] < 0) || (0U != (length & 1U)) || (length > (2U + 2U * 256U)))
+        {
+            status = SREC_ERROR;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    /* Every other character is a hexadecimal digit */
+    for (index = 2U; (index < length) && (SREC_OK == status); ++index)
+    {
+        if (REF_Digit(line[index]) < 0)
+        {
+            status = SREC_ERROR;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    /* Convert the pairs of digits, then check byteCount and checksum */
+    if (SREC_OK == status)
+    {
+        numBytes = (length - 2U) / 2U;
+        for (index = 0U; index < numBytes; ++index)
+        {
+            bytes[index] = (uint8_t)((REF_Digit(line[2U + 2U * index]) << 4U)
+                                     | REF_Digit(line[3U + 2U * index]));
+            sum = (uint8_t)(sum + bytes[index]);
+        }
+
+        if (((uint32_t)bytes[0U] != (numBytes - 1U))
+                || (bytes[0U] <= addressLength[type])
+                || ((uint32_t)(bytes[0U] - addressLength[type] - 1) > SREC_MAX_DATA_LENGTH)
+                || (0xFFU != sum))
+        {
+            status = SREC_ERROR;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (SREC_OK == status)
+    {
+        record->type    = (uint8_t)type;
+        record->address = 0U;
+        for (index = 1U; index <= (uint32_t)addressLength[type]; ++index)
+        {
+            record->address = (record->address << 8U) | bytes[index];
+        }
+        record->length = (uint8_t)(bytes[0U] - addressLength[type] - 1);
+        (void)memcpy(record->data, &bytes[1U + addressLength[type]], record->length);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    record->status = status;
+
+    return status;
+}
+
+
+/*
+ * @name:  REF_NextLine
+ * ----------------------------
+ * @brief: Find the next non-empty line of an image
+ */
+uint32_t REF_NextLine(const uint8_t *const image, const uint32_t size, const uint32_t offset,
+                      uint32_t *const start, uint32_t *const length)
+{
+    uint32_t index  = offset;
+    uint32_t end    = 0U;
+    uint32_t retVal = 0U;
+
+    /* Line endings between the lines are skipped, as the decoder does */
+    while ((index < size) && (('\r' == image[index]) || ('\n' == image[index])))
+    {
+        index++;
+    }
+
+    if (index < size)
+    {
+        *start = index;
+        while ((index < size) && ('\n' != image[index]))
+        {
+            index++;
+        }
+
+        end = index;
+        while ((end > *start) && ('\r' == image[end - 1U]))
+        {
+            end--;
+        }
+
+        *length = end - *start;
+        retVal  = (index < size) ? (index + 1U) : index;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return retVal;
+}
+
+
+/*
+ * @brief: Gets the value of a hexadecimal digit
+ */
+static int32_t REF_Digit(const uint8_t character)
+{
+    int32_t value = -1;
+
+    if ((character >= '0') && (character <= '9'))
+    {
+        value = character - '0';
+    }
+    else if ((character >= 'A') && (character <= 'F'))
+    {
+        value = character - 'A' + 10;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return value;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,54 @@
+/*
+ * srec_ref.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_SREC_REF_H_
+#define _INC_SREC_REF_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "Srec.h"
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       REF_DecodeLine
+ * ----------------------------
+ * @brief:      Reference SREC decoder, written straight from the format description:
+ *              the whole line is checked first, then converted one field at a time.
+ *              It shares nothing with Srec.c, so that both can be compared
+ * @param[in]:  line: Pointer to the first character of the line
+ * @param[in]:  length: Number of characters of the line, line ending excluded
+ * @param[out]: record: The decoded record, its data field must hold SREC_MAX_DATA_LENGTH bytes
+ * @return:     SREC_OK if the record is valid, SREC_ERROR otherwise
+ */
+Srec_Status_t REF_DecodeLine(const uint8_t *const line, const uint32_t length,
+                             Srec_Record_t *const record);
+
+
+/*
+ * @name:       REF_NextLine
+ * ----------------------------
+ * @brief:      Find the next non-empty line of an image
+ * @param[in]:  image: Pointer to the image
+ * @param[in]:  size: Number of characters of the image
+ * @param[in]:  offset: Offset from which the line is searched
+ * @param[out]: start: Offset of the first character of the line
+ * @param[out]: length: Number of characters of the line, "\r" and "\n" excluded
+ * @return:     Offset just past the line ending, 0 if there is no line left
+ */
+uint32_t REF_NextLine(const uint8_t *const image, const uint32_t size, const uint32_t offset,
+                      uint32_t *const start, uint32_t *const length);
+
+#endif /* _INC_SREC_REF_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,739 @@
+/*
+ * srec_test.c
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "Srec.h"
+#include "Queue.h"
+#include "srec_corpus.h"
+#include "srec_ref.h"
+#include "srec_base.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define TEST_IMAGE_SIZE         (512U * 1024U)  /* Room for the generated image */
+#define TEST_SEED               0x5EC0DEU       /* Seed of the generated image */
+#define TEST_BURST              64U             /* Characters per SREC_DecodeChars call, as read from a FIFO */
+#define TEST_MAX_BURST          40U             /* Burst sizes from 1 to this one are checked */
+#define TEST_MIN_TIME_NS        200000000ULL    /* Each entry point runs for at least this long */
+#define TEST_BASE_BYTE_COUNT    124U            /* Largest record of the baseline: 255 characters, "\r\n" included */
+#define TEST_MAX_FIELDS         256U            /* Data fields of one record type in the image */
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Summary of the records handed over by a decoder, compared between decoders
+ */
+typedef struct
+{
+    uint32_t records;        /* Records handed over, broken ones included */
+    uint32_t errors;         /* Records rejected */
+    uint32_t hash;           /* FNV-1a hash of the fields of the valid records, in order */
+} Test_Digest_t;
+
+
+/*
+ * @brief: An entry point run over the whole image
+ */
+typedef struct
+{
+    const char *name;
+    void (*run)(const uint8_t *const image, const uint32_t size, Test_Digest_t *const digest);
+} Test_Entry_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t          s_image[TEST_IMAGE_SIZE];
+static uint8_t          s_data[SREC_MAX_DATA_LENGTH];   /* Data field of the records not taken from the queue */
+static uint16_t         s_burst = TEST_BURST;           /* Burst size of TEST_RunDecodeChars */
+static CircularQueue_t  s_queue;
+
+/* Data fields of the records of one type, converted by TEST_ConvertFields */
+static uint32_t         s_fieldStart[TEST_MAX_FIELDS];
+static uint16_t         s_fieldCount[TEST_MAX_FIELDS];
+static uint32_t         s_numFields;
+
+/* Baseline record path run by TEST_RunBaseline, BASE_DecodeLineCounted to count the reads */
+static Srec_Status_t (*s_baseDecode)(const uint8_t *const line, Srec_Record_t *const record) = BASE_DecodeLine;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Adds a handed over record to a digest
+ * @param[out] digest: The digest
+ * @param[in]  status: Status returned with the record
+ * @param[in]  record: The record, only read if status is SREC_OK
+ * @return:    None
+ */
+static void TEST_Fold(Test_Digest_t *const digest, const Srec_Status_t status,
+                      const Srec_Record_t *const record);
+
+
+/*
+ * @brief:     Decodes the image line by line with the reference decoder
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records
+ * @return:    None
+ */
+static void TEST_RunReference(const uint8_t *const image, const uint32_t size,
+                              Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     Decodes the image line by line with the five checks of the baseline
+ * @param[in]  image: Pointer to the image, every line ending with "\r\n"
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records
+ * @return:    None
+ */
+static void TEST_RunBaseline(const uint8_t *const image, const uint32_t size,
+                             Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     Feeds the image to SREC_DecodeChar one character at a time
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records
+ * @return:    None
+ */
+static void TEST_RunDecodeChar(const uint8_t *const image, const uint32_t size,
+                               Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     Feeds the image to SREC_DecodeChars in bursts of s_burst characters
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records
+ * @return:    None
+ */
+static void TEST_RunDecodeChars(const uint8_t *const image, const uint32_t size,
+                                Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     Decodes the image in bursts straight into the queue, and drains the
+ *             queue whenever it has no free slot left, as the main loop does
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records
+ * @return:    None
+ */
+static void TEST_RunQueue(const uint8_t *const image, const uint32_t size,
+                          Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     Converts the bytes of every valid line of the image with SREC_HexToBytes
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Lines converted, and the hash of their sums
+ * @return:    None
+ */
+static void TEST_RunHexToBytes(const uint8_t *const image, const uint32_t size,
+                               Test_Digest_t *const digest);
+
+
+/*
+ * @brief:     SREC_HexToBytes with the signature of BASE_ConvertBytes
+ * @param[in]  str: Pointer to the characters to be converted (2 * count characters)
+ * @param[out] bytes: Pointer to the buffer receiving the converted bytes
+ * @param[in]  count: Number of bytes to be converted
+ * @return:    The 8-bit sum of the converted bytes
+ */
+static uint8_t TEST_HexToBytes(const uint8_t *const str, uint8_t *const bytes, const uint16_t count);
+
+
+/*
+ * @brief:     Finds the data fields of the valid records of one type
+ * @param[in]  image: Pointer to the image
+ * @param[in]  size: Number of characters of the image
+ * @param[in]  type: Record type (1..3)
+ * @return:    Number of characters in the data fields
+ */
+static uint32_t TEST_FindFields(const uint8_t *const image, const uint32_t size, const uint8_t type);
+
+
+/*
+ * @brief:     Converts every data field found by TEST_FindFields
+ * @param[in]  image: Pointer to the image
+ * @param[in]  convert: The converter
+ * @return:    The sum of the converted bytes
+ */
+static uint8_t TEST_ConvertFields(const uint8_t *const image,
+                                  uint8_t (*convert)(const uint8_t *const str, uint8_t *const bytes,
+                                                     const uint16_t count));
+
+
+/*
+ * @brief:     Checks SREC_HexToBytes against SREC_convertStrToDec of the baseline on the data
+ *             fields of one record type, then prints the bytes/s of both
+ * @param[in]  size: Number of characters of the image
+ * @param[in]  type: Record type (1..3)
+ * @return:    0 if both give the same bytes, 1 otherwise
+ */
+static uint32_t TEST_MeasureKernel(const uint32_t size, const uint8_t type);
+
+
+/*
+ * @brief:     Runs an entry point over the image until TEST_MIN_TIME_NS has passed
+ * @param[in]  entry: The entry point
+ * @param[in]  size: Number of characters of the image
+ * @param[out] digest: Summary of the records of the first run
+ * @param[in]  reads: Characters of the image read per character, printed if not negative
+ * @return:    None
+ */
+static void TEST_Measure(const Test_Entry_t *const entry, const uint32_t size,
+                         Test_Digest_t *const digest, const double reads);
+
+
+/*
+ * @brief:  Gets the time of a monotonic clock
+ * @return: The time in nanoseconds
+ */
+static uint64_t TEST_Now(void);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* Entry points checked against the reference decoder, then timed */
+static const Test_Entry_t s_entries[] =
+{
+    { "REF_DecodeLine",  TEST_RunReference   },
+    { "SREC_DecodeChar",  TEST_RunDecodeChar  },
+    { "SREC_DecodeChars", TEST_RunDecodeChars },
+    { "Queue (burst)",    TEST_RunQueue       },
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+int main(void)
+{
+    Test_Digest_t reference;
+    Test_Digest_t digest;
+    uint32_t      size     = 0U;
+    uint32_t      index    = 0U;
+    uint32_t      failures = 0U;
+
+    /* Every byteCount of S1/S2/S3 with faulty copies, checked against the reference decoder */
+    size = CORPUS_Generate(s_image, sizeof(s_image), TEST_SEED, 255U, CORPUS_FAULT_ALL);
+    TEST_RunReference(s_image, size, &reference);
+    printf("corpus: %u characters, %u records, %u rejected\n",
+           (unsigned)size, (unsigned)reference.records, (unsigned)reference.errors);
+
+    for (index = 1U; index < (sizeof(s_entries) / sizeof(s_entries[0U])); ++index)
+    {
+        s_entries[index].run(s_image, size, &digest);
+        if (0 != memcmp(&digest, &reference, sizeof(digest)))
+        {
+            printf("FAIL %s: %u records, %u rejected\n", s_entries[index].name,
+                   (unsigned)digest.records, (unsigned)digest.errors);
+            failures++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    /* Records cut across bursts at every offset */
+    for (s_burst = 1U; s_burst <= TEST_MAX_BURST; ++s_burst)
+    {
+        TEST_RunDecodeChars(s_image, size, &digest);
+        if (0 != memcmp(&digest, &reference, sizeof(digest)))
+        {
+            printf("FAIL SREC_DecodeChars with bursts of %u characters\n", (unsigned)s_burst);
+            failures++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    s_burst = TEST_BURST;
+
+    /* Throughput of every entry point on the valid image */
+    size = CORPUS_Generate(s_image, sizeof(s_image), TEST_SEED, 255U, CORPUS_FAULT_NONE);
+    printf("\n%-18s %14s %14s\n", "entry point", "records/s", "bytes/s");
+    for (index = 0U; index < (sizeof(s_entries) / sizeof(s_entries[0U])); ++index)
+    {
+        TEST_Measure(&s_entries[index], size, &digest, -1.0);
+    }
+    {
+        const Test_Entry_t kernel = { "SREC_HexToBytes", TEST_RunHexToBytes };
+        TEST_Measure(&kernel, size, &digest, -1.0);
+    }
+
+    /* Single pass against the five checks of the baseline, on records the baseline can hold */
+    size = CORPUS_Generate(s_image, sizeof(s_image), TEST_SEED, TEST_BASE_BYTE_COUNT, CORPUS_CRLF);
+    TEST_RunReference(s_image, size, &reference);
+    printf("\nsingle pass against the baseline, byteCount up to %u\n", (unsigned)TEST_BASE_BYTE_COUNT);
+    printf("%-18s %14s %14s %14s\n", "entry point", "records/s", "bytes/s", "reads/char");
+    {
+        const Test_Entry_t baseline = { "BASE_DecodeLine", TEST_RunBaseline };
+
+        s_baseDecode = BASE_DecodeLineCounted;
+        g_baseReads  = 0U;
+        TEST_RunBaseline(s_image, size, &digest);
+        s_baseDecode = BASE_DecodeLine;
+        if (0 != memcmp(&digest, &reference, sizeof(digest)))
+        {
+            printf("FAIL BASE_DecodeLine: %u records, %u rejected\n",
+                   (unsigned)digest.records, (unsigned)digest.errors);
+            failures++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        TEST_Measure(&baseline, size, &digest, (double)g_baseReads / size);
+    }
+    /* SREC_DecodeChar is handed each character once, and has no pointer into the line */
+    TEST_Measure(&s_entries[1U], size, &digest, 1.0);
+
+    /* Hex kernel against the conversion of the baseline, on the data fields of each record type */
+    size = CORPUS_Generate(s_image, sizeof(s_image), TEST_SEED, 255U, CORPUS_FAULT_NONE);
+    printf("\nhex kernel against the baseline, characters/s of the data fields\n");
+    printf("%-18s %14s %14s %14s\n", "record type", "HexToBytes", "convertStrTo", "speedup");
+    for (index = 1U; index <= 3U; ++index)
+    {
+        failures += TEST_MeasureKernel(size, (uint8_t)index);
+    }
+
+    printf("\n%s\n", (0U == failures) ? "srec: PASS" : "srec: FAIL");
+
+    return (0U == failures) ? 0 : 1;
+}
+
+
+/*
+ * @brief: Adds a handed over record to a digest
+ */
+static void TEST_Fold(Test_Digest_t *const digest, const Srec_Status_t status,
+                      const Srec_Record_t *const record)
+{
+    uint8_t  fields[7U];
+    uint32_t index = 0U;
+
+    digest->records++;
+    if (SREC_OK == status)
+    {
+        fields[0U] = record->type;
+        fields[1U] = record->length;
+        fields[2U] = (uint8_t)(record->address >> 24U);
+        fields[3U] = (uint8_t)(record->address >> 16U);
+        fields[4U] = (uint8_t)(record->address >> 8U);
+        fields[5U] = (uint8_t)record->address;
+        fields[6U] = 0xA5U;
+        for (index = 0U; index < sizeof(fields); ++index)
+        {
+            digest->hash = (digest->hash ^ fields[index]) * 16777619U;
+        }
+        for (index = 0U; index < record->length; ++index)
+        {
+            digest->hash = (digest->hash ^ record->data[index]) * 16777619U;
+        }
+    }
+    else
+    {
+        digest->errors++;
+        digest->hash = (digest->hash ^ 0x5AU) * 16777619U;
+    }
+}
+
+
+/*
+ * @brief: Decodes the image line by line with the reference decoder
+ */
+static void TEST_RunReference(const uint8_t *const image, const uint32_t size,
+                              Test_Digest_t *const digest)
+{
+    Srec_Record_t record = { .data = s_data };
+    uint32_t      offset = 0U;
+    uint32_t      start  = 0U;
+    uint32_t      length = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+
+    offset = REF_NextLine(image, size, offset, &start, &length);
+    while (0U != offset)
+    {
+        TEST_Fold(digest, REF_DecodeLine(&image[start], length, &record), &record);
+        offset = REF_NextLine(image, size, offset, &start, &length);
+    }
+}
+
+
+/*
+ * @brief: Decodes the image line by line with the five checks of the baseline
+ */
+static void TEST_RunBaseline(const uint8_t *const image, const uint32_t size,
+                             Test_Digest_t *const digest)
+{
+    Srec_Record_t record = { .data = s_data };
+    uint32_t      offset = 0U;
+    uint32_t      start  = 0U;
+    uint32_t      length = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+
+    offset = REF_NextLine(image, size, offset, &start, &length);
+    while (0U != offset)
+    {
+        TEST_Fold(digest, s_baseDecode(&image[start], &record), &record);
+        offset = REF_NextLine(image, size, offset, &start, &length);
+    }
+}
+
+
+/*
+ * @brief: Feeds the image to SREC_DecodeChar one character at a time
+ */
+static void TEST_RunDecodeChar(const uint8_t *const image, const uint32_t size,
+                               Test_Digest_t *const digest)
+{
+    Srec_Decoder_t decoder;
+    Srec_Record_t  record = { .data = s_data };
+    Srec_Status_t  status = SREC_PENDING;
+    uint32_t       index  = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+    SREC_DecoderInit(&decoder);
+
+    for (index = 0U; index < size; ++index)
+    {
+        status = SREC_DecodeChar(&decoder, image[index], &record);
+        if (SREC_PENDING != status)
+        {
+            TEST_Fold(digest, status, &record);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+
+/*
+ * @brief: Feeds the image to SREC_DecodeChars in bursts of s_burst characters
+ */
+static void TEST_RunDecodeChars(const uint8_t *const image, const uint32_t size,
+                                Test_Digest_t *const digest)
+{
+    Srec_Decoder_t decoder;
+    Srec_Record_t  record = { .data = s_data };
+    Srec_Status_t  status   = SREC_PENDING;
+    uint32_t       offset   = 0U;
+    uint16_t       count    = 0U;
+    uint16_t       used     = 0U;
+    uint16_t       consumed = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+    SREC_DecoderInit(&decoder);
+
+    for (offset = 0U; offset < size; offset += count)
+    {
+        count = ((size - offset) < s_burst) ? (uint16_t)(size - offset) : s_burst;
+
+        /* The rest of the burst is fed again after each record, as MID_PushBurst does */
+        used = 0U;
+        while (used < count)
+        {
+            status = SREC_DecodeChars(&decoder, &image[offset + used], (uint16_t)(count - used),
+                                      &consumed, &record);
+            used   = (uint16_t)(used + consumed);
+            if (SREC_PENDING != status)
+            {
+                TEST_Fold(digest, status, &record);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+}
+
+
+/*
+ * @brief: Decodes the image in bursts straight into the queue
+ */
+static void TEST_RunQueue(const uint8_t *const image, const uint32_t size,
+                          Test_Digest_t *const digest)
+{
+    Srec_Decoder_t decoder;
+    Srec_Record_t  *p_Record = NULL;
+    Srec_Status_t  status    = SREC_PENDING;
+    uint32_t       offset    = 0U;
+    uint16_t       count     = 0U;
+    uint16_t       consumed  = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+    SREC_DecoderInit(&decoder);
+    Queue_Init(&s_queue);
+
+    while (offset < size)
+    {
+        p_Record = Queue_getRearSlot(&s_queue);
+        if (NULL != p_Record)
+        {
+            count  = ((size - offset) < TEST_BURST) ? (uint16_t)(size - offset) : TEST_BURST;
+            status = SREC_DecodeChars(&decoder, &image[offset], count, &consumed, p_Record);
+            offset += consumed;
+
+            if (SREC_PENDING != status)
+            {
+                /* Broken records go through the queue as well, the consumer reports them */
+                p_Record->status = status;
+                (void)Queue_enQueue(&s_queue);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            p_Record = Queue_deQueue(&s_queue);
+            TEST_Fold(digest, p_Record->status, p_Record);
+        }
+    }
+
+    p_Record = Queue_deQueue(&s_queue);
+    while (NULL != p_Record)
+    {
+        TEST_Fold(digest, p_Record->status, p_Record);
+        p_Record = Queue_deQueue(&s_queue);
+    }
+}
+
+
+/*
+ * @brief: Converts the bytes of every valid line of the image with SREC_HexToBytes
+ */
+static void TEST_RunHexToBytes(const uint8_t *const image, const uint32_t size,
+                               Test_Digest_t *const digest)
+{
+    uint8_t  bytes[256U];
+    uint8_t  error  = FALSE;
+    uint32_t offset = 0U;
+    uint32_t start  = 0U;
+    uint32_t length = 0U;
+
+    digest->records = 0U;
+    digest->errors  = 0U;
+    digest->hash    = 2166136261U;
+
+    offset = REF_NextLine(image, size, offset, &start, &length);
+    while (0U != offset)
+    {
+        /* Every byte after the record type, byteCount and checksum included */
+        digest->hash = (digest->hash ^ SREC_HexToBytes(&image[start + 2U], bytes,
+                                                       (uint16_t)((length - 2U) / 2U), &error))
+                       * 16777619U;
+        digest->records++;
+        digest->errors += error;
+        offset = REF_NextLine(image, size, offset, &start, &length);
+    }
+}
+
+
+/*
+ * @brief: SREC_HexToBytes with the signature of BASE_ConvertBytes
+ */
+static uint8_t TEST_HexToBytes(const uint8_t *const str, uint8_t *const bytes, const uint16_t count)
+{
+    uint8_t error = FALSE;
+
+    return SREC_HexToBytes(str, bytes, count, &error);
+}
+
+
+/*
+ * @brief: Finds the data fields of the valid records of one type
+ */
+static uint32_t TEST_FindFields(const uint8_t *const image, const uint32_t size, const uint8_t type)
+{
+    Srec_Record_t record = { .data = s_data };
+    uint32_t      chars  = 0U;
+    uint32_t      offset = 0U;
+    uint32_t      start  = 0U;
+    uint32_t      length = 0U;
+
+    s_numFields = 0U;
+    offset      = REF_NextLine(image, size, offset, &start, &length);
+    while ((0U != offset) && (s_numFields < TEST_MAX_FIELDS))
+    {
+        if ((SREC_OK == REF_DecodeLine(&image[start], length, &record)) && (type == record.type))
+        {
+            /* 'S', type, byteCount, then one address byte more than the type number */
+            s_fieldStart[s_numFields] = start + 4U + (2U * (type + 1U));
+            s_fieldCount[s_numFields] = record.length;
+            chars                    += 2U * record.length;
+            s_numFields++;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        offset = REF_NextLine(image, size, offset, &start, &length);
+    }
+
+    return chars;
+}
+
+
+/*
+ * @brief: Converts every data field found by TEST_FindFields
+ */
+static uint8_t TEST_ConvertFields(const uint8_t *const image,
+                                  uint8_t (*convert)(const uint8_t *const str, uint8_t *const bytes,
+                                                     const uint16_t count))
+{
+    uint32_t index = 0U;
+    uint8_t  sum   = 0U;
+
+    for (index = 0U; index < s_numFields; ++index)
+    {
+        sum += convert(&image[s_fieldStart[index]], s_data, s_fieldCount[index]);
+    }
+
+    return sum;
+}
+
+
+/*
+ * @brief: Checks SREC_HexToBytes against SREC_convertStrToDec of the baseline, then times both
+ */
+static uint32_t TEST_MeasureKernel(const uint32_t size, const uint8_t type)
+{
+    uint8_t  expected[SREC_MAX_DATA_LENGTH];
+    uint32_t chars    = TEST_FindFields(s_image, size, type);
+    uint32_t index    = 0U;
+    uint32_t runs     = 0U;
+    uint32_t retVal   = 0U;
+    uint64_t start    = 0U;
+    uint64_t elapsed  = 0U;
+    double   rate[2U] = { 0.0, 0.0 };
+    uint8_t  (*const converters[2U])(const uint8_t *const, uint8_t *const, const uint16_t) =
+    {
+        TEST_HexToBytes, BASE_ConvertBytes
+    };
+    volatile uint8_t sink = 0U;
+
+    for (index = 0U; index < s_numFields; ++index)
+    {
+        (void)BASE_ConvertBytes(&s_image[s_fieldStart[index]], expected, s_fieldCount[index]);
+        (void)TEST_HexToBytes(&s_image[s_fieldStart[index]], s_data, s_fieldCount[index]);
+        if (0 != memcmp(expected, s_data, s_fieldCount[index]))
+        {
+            retVal = 1U;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    for (index = 0U; index < 2U; ++index)
+    {
+        runs  = 0U;
+        start = TEST_Now();
+        do
+        {
+            sink = (uint8_t)(sink + TEST_ConvertFields(s_image, converters[index]));
+            runs++;
+            elapsed = TEST_Now() - start;
+        } while (elapsed < TEST_MIN_TIME_NS);
+        rate[index] = ((double)chars * runs) / ((double)elapsed / 1e9);
+    }
+
+    printf("S%-17u %14.0f %14.0f %13.2fx%s\n", (unsigned)type, rate[0U], rate[1U],
+           rate[0U] / rate[1U], (0U == retVal) ? "" : "  FAIL");
+
+    return retVal;
+}
+
+
+/*
+ * @brief: Runs an entry point over the image until TEST_MIN_TIME_NS has passed
+ */
+static void TEST_Measure(const Test_Entry_t *const entry, const uint32_t size,
+                         Test_Digest_t *const digest, const double reads)
+{
+    Test_Digest_t dummy;
+    uint64_t      start   = 0U;
+    uint64_t      elapsed = 0U;
+    uint32_t      runs    = 0U;
+    double        seconds = 0.0;
+
+    entry->run(s_image, size, digest);
+
+    start = TEST_Now();
+    do
+    {
+        entry->run(s_image, size, &dummy);
+        runs++;
+        elapsed = TEST_Now() - start;
+    } while (elapsed < TEST_MIN_TIME_NS);
+
+    seconds = (double)elapsed / 1e9;
+    printf("%-18s %14.0f %14.0f", entry->name,
+           ((double)digest->records * runs) / seconds, ((double)size * runs) / seconds);
+    if (reads >= 0.0)
+    {
+        printf(" %14.2f", reads);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+    printf("\n");
+}
+
+
+/*
+ * @brief: Gets the time of a monotonic clock
+ */
+static uint64_t TEST_Now(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
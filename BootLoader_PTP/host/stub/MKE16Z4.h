@@ -0,0 +1,64 @@
+/*
+ * MKE16Z4.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_MKE16Z4_H_
+#define _INC_MKE16Z4_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Host stand-ins for the CMSIS intrinsics used by the middle layer */
+#define __DMB()                __sync_synchronize()
+#define __DSB()                __sync_synchronize()
+#define __ISB()                __sync_synchronize()
+#define __disable_irq()
+#define __enable_irq()
+
+/* Indexes of the clock gates in PCC->CLKCFG */
+#define PCC_PORTA_INDEX        73U
+#define PCC_PORTB_INDEX        74U
+#define PCC_PORTC_INDEX        75U
+#define PCC_PORTD_INDEX        76U
+#define PCC_PORTE_INDEX        77U
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+/* Interrupts of the peripherals the transports use, g_hostNvic keeps one bit for each */
+typedef enum
+{
+    LPI2C0_IRQn     = 24,
+    LPSPI0_IRQn     = 25,
+    MSCAN_Rx_IRQn   = 30,
+    MSCAN_ORed_IRQn = 31,
+    LPUART0_IRQn    = 12,
+    LPUART1_IRQn    = 13,
+    LPUART2_IRQn    = 14,
+} IRQn_Type;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern uint32_t g_hostNvic;  /* Bit n set while interrupt n is enabled, see dri_host.c */
+extern uint32_t SystemCoreClock;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+
+#endif /* _INC_MKE16Z4_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
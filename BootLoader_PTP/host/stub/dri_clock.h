@@ -0,0 +1,38 @@
+/*
+ * dri_clock.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_CLOCK_H_
+#define _INC_DRI_CLOCK_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_def.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern uint8_t g_hostClock[128];  /* TRUE while the clock of the PCC index is enabled */
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+static inline void DRI_CLOCK_EnableClock(const uint32_t PCC_MODULE_INDEX)
+{
+    g_hostClock[PCC_MODULE_INDEX] = TRUE;
+}
+
+static inline void DRI_CLOCK_DisableClock(const uint32_t PCC_MODULE_INDEX)
+{
+    g_hostClock[PCC_MODULE_INDEX] = FALSE;
+}
+
+#endif /* _INC_DRI_CLOCK_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
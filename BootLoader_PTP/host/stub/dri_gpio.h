@@ -0,0 +1,84 @@
+/*
+ * dri_gpio.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_GPIO_H_
+#define _INC_DRI_GPIO_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_def.h"
+#include "dri_port.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define GPIOA                 (&g_hostGpio[0])
+#define GPIOB                 (&g_hostGpio[1])
+#define GPIOC                 (&g_hostGpio[2])
+#define GPIOD                 (&g_hostGpio[3])
+#define GPIOE                 (&g_hostGpio[4])
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+typedef uint8_t GPIO_Pin_t;
+
+typedef enum
+{
+    GPIO_PIN_RESET,
+    GPIO_PIN_SET
+} GPIO_Pin_State_t;
+
+typedef enum
+{
+    GPIO_INPUT,
+    GPIO_OUTPUT
+} GPIO_Direction_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Output and direction registers of a GPIO, an input reads its PDIR as set by the test
+ */
+typedef struct
+{
+    uint32_t PDOR;
+    uint32_t PDIR;
+    uint32_t PDDR;
+} GPIO_Type;
+
+typedef struct
+{
+    GPIO_Direction_t     Direction;
+    GPIO_Pin_State_t     OutputLogic;
+} GPIO_InitTypeDef;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern GPIO_Type g_hostGpio[5];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+DRI_StatusTypeDef DRI_GPIO_WritePin(GPIO_Type *const GPIOx,
+        const GPIO_Pin_t Pin, const GPIO_Pin_State_t State);
+
+GPIO_Pin_State_t DRI_GPIO_ReadPin(const GPIO_Type *const GPIOx,
+        const GPIO_Pin_t Pin);
+
+DRI_StatusTypeDef DRI_GPIO_Init(GPIO_Type *const GPIOx, const GPIO_Pin_t Pin,
+        const GPIO_InitTypeDef *const GPIO_Init);
+
+#endif /* _INC_DRI_GPIO_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,27 @@
+/*
+ * dri_lpi2c.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_LPI2C_H_
+#define _INC_DRI_LPI2C_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+/* The LPI2C transport is not built on the host */
+typedef struct LPI2C_Type LPI2C_Type;
+
+#endif /* _INC_DRI_LPI2C_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
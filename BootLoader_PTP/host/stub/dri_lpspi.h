@@ -0,0 +1,138 @@
+/*
+ * dri_lpspi.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_LPSPI_H_
+#define _INC_DRI_LPSPI_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <string.h>
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define LPSPI0                (&g_hostLpspi0)
+#define LPSPI_FIFO_SIZE       4U      /* Words of the receive and transmit FIFOs of the MKE16Z4 */
+
+#define LPSPI_SR_TEF_MASK     0x0800U /* Transmit error: a frame was clocked out of an empty transmit FIFO */
+#define LPSPI_SR_REF_MASK     0x1000U /* Receive error: a frame was received into a full receive FIFO */
+#define LPSPI_IER_RDIE_MASK   0x0002U
+#define LPSPI_IER_REIE_MASK   0x1000U
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+typedef enum
+{
+    LPSPI_CLOCK_IDLE_LOW  = 0U,
+    LPSPI_CLOCK_IDLE_HIGH = 1U
+} LPSPI_Clock_Polarity_t;
+
+typedef enum
+{
+    LPSPI_CAPTURE_LEADING  = 0U,
+    LPSPI_CAPTURE_TRAILING = 1U
+} LPSPI_Clock_Phase_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: LPSPI of the host: the status and interrupt enable registers, and both FIFOs.
+ *         The master side is HOST_lpspiTransfer of dri_host.c
+ */
+typedef struct
+{
+    uint32_t SR;
+    uint32_t IER;
+    uint8_t  enabled;                    /* TRUE between DRI_LPSPI_SlaveInit and DRI_LPSPI_DeInit */
+    uint8_t  rxFifo[LPSPI_FIFO_SIZE];
+    uint8_t  rxCount;
+    uint8_t  txFifo[LPSPI_FIFO_SIZE];
+    uint8_t  txCount;
+    uint32_t txOverflows;                /* Words written to a full transmit FIFO, and lost */
+} LPSPI_Type;
+
+typedef struct
+{
+    LPSPI_Clock_Polarity_t ClockPolarity;
+    LPSPI_Clock_Phase_t    ClockPhase;
+    uint8_t                FrameSize;
+    uint8_t                ChipSelect;
+    uint8_t                LSBFirst;
+    uint8_t                RxWatermark;
+    uint8_t                TxWatermark;
+} LPSPI_SlaveInitTypeDef;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern LPSPI_Type g_hostLpspi0;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void DRI_LPSPI_SlaveInit(LPSPI_Type *const LPSPIx, const LPSPI_SlaveInitTypeDef *const LPSPI_Init);
+
+void DRI_LPSPI_DeInit(LPSPI_Type *const LPSPIx);
+
+static inline void LPSPI_EnableInterrupts(LPSPI_Type *const LPSPIx, const uint32_t mask)
+{
+    LPSPIx->IER |= mask;
+}
+
+/* The flags are cleared by writing 1 */
+static inline void LPSPI_ClearStatusFlags(LPSPI_Type *const LPSPIx, const uint32_t mask)
+{
+    LPSPIx->SR &= ~mask;
+}
+
+static inline uint8_t LPSPI_ReceiveEmpty(const LPSPI_Type *const LPSPIx)
+{
+    return (0U == LPSPIx->rxCount) ? TRUE : FALSE;
+}
+
+/* Reading RDR takes the oldest word out of the receive FIFO */
+static inline uint32_t LPSPI_ReceiveWord(LPSPI_Type *const LPSPIx)
+{
+    uint32_t data = LPSPIx->rxFifo[0];
+
+    if (0U != LPSPIx->rxCount)
+    {
+        LPSPIx->rxCount--;
+        (void)memmove(&LPSPIx->rxFifo[0], &LPSPIx->rxFifo[1], LPSPIx->rxCount);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return data;
+}
+
+/* Writing TDR to a full transmit FIFO is ignored */
+static inline void LPSPI_TransmitWord(LPSPI_Type *const LPSPIx, const uint32_t data)
+{
+    if (LPSPIx->txCount < LPSPI_FIFO_SIZE)
+    {
+        LPSPIx->txFifo[LPSPIx->txCount++] = (uint8_t)data;
+    }
+    else
+    {
+        LPSPIx->txOverflows++;
+    }
+}
+
+#endif /* _INC_DRI_LPSPI_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
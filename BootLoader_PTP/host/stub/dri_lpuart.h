@@ -0,0 +1,27 @@
+/*
+ * dri_lpuart.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_LPUART_H_
+#define _INC_DRI_LPUART_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+/* Only named by HAL_Port_t of hal.h, the LPUART transport is not built on the host */
+typedef struct LPUART_Type LPUART_Type;
+
+#endif /* _INC_DRI_LPUART_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
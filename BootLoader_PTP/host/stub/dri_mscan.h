@@ -0,0 +1,108 @@
+/*
+ * dri_mscan.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_MSCAN_H_
+#define _INC_DRI_MSCAN_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_port.h"
+#include "dri_clock.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define MSCAN                     (&g_hostMscan)
+#define DRI_MSCAN_MAX_DATA        8U      /* Data bytes of a classic CAN frame */
+#define MSCAN_TX_BUFFERS_MASK     0x07U   /* TXE bits of the three transmit buffers */
+#define MSCAN_TX_BUFFERS          3U
+#define MSCAN_RX_FIFO_SIZE        5U      /* Foreground buffer and the four behind it */
+
+#define MSCAN_CANRFLG_RXF_MASK    0x01U
+#define MSCAN_CANRFLG_OVRIF_MASK  0x02U
+#define MSCAN_CANRIER_RXFIE_MASK  0x01U
+#define MSCAN_CANRIER_OVRIE_MASK  0x02U
+
+/* Kept in CANRFLG until software writes it, see HOST_mscanSync */
+#define HOST_MSCAN_UNWRITTEN      0x100U
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+typedef struct
+{
+    uint8_t  Prescaler;
+    uint8_t  SyncJumpWidth;
+    uint8_t  TimeSegment1;
+    uint8_t  TimeSegment2;
+    uint16_t FilterId;
+    uint8_t  Loopback;
+} MSCAN_InitTypeDef;
+
+typedef struct
+{
+    uint16_t id;                       /* 11-bit identifier */
+    uint8_t  length;                   /* Number of valid bytes in data */
+    uint8_t  data[DRI_MSCAN_MAX_DATA];
+} MSCAN_Frame_t;
+
+/*
+ * @brief: MSCAN of the host: the flag and interrupt enable registers the transport uses,
+ *         the receive FIFO and the transmit buffers. The bus side is in dri_host.c
+ */
+typedef struct
+{
+    uint32_t      CANRFLG;             /* RXF and OVRIF, write 1 to clear OVRIF */
+    uint8_t       CANRIER;
+    uint8_t       CANTFLG;             /* TXE: bit n set while transmit buffer n is empty */
+    uint8_t       CANTIER;
+    uint8_t       enabled;             /* TRUE between DRI_MSCAN_Init and DRI_MSCAN_DeInit */
+    uint16_t      filterId;
+    MSCAN_Frame_t rxFifo[MSCAN_RX_FIFO_SIZE];
+    uint8_t       rxCount;
+    MSCAN_Frame_t txBuffer[MSCAN_TX_BUFFERS];
+    uint8_t       txPriority[MSCAN_TX_BUFFERS];
+} MSCAN_Type;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern MSCAN_Type g_hostMscan;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+void DRI_MSCAN_Init(MSCAN_Type *const MSCANx, const MSCAN_InitTypeDef *const MSCAN_Init);
+
+void DRI_MSCAN_DeInit(MSCAN_Type *const MSCANx);
+
+void DRI_MSCAN_ReadFrame(MSCAN_Type *const MSCANx, MSCAN_Frame_t *const frame);
+
+DRI_StatusTypeDef DRI_MSCAN_WriteFrame(MSCAN_Type *const MSCANx, const MSCAN_Frame_t *const frame,
+        const uint8_t priority);
+
+static inline uint8_t MSCAN_ReceiveFull(const MSCAN_Type *const MSCANx)
+{
+    return (0U != (MSCANx->CANRFLG & MSCAN_CANRFLG_RXF_MASK)) ? TRUE : FALSE;
+}
+
+static inline uint8_t MSCAN_GetEmptyTransmit(const MSCAN_Type *const MSCANx)
+{
+    return MSCANx->CANTFLG & MSCAN_TX_BUFFERS_MASK;
+}
+
+static inline void MSCAN_SetTransmitInterrupts(MSCAN_Type *const MSCANx, const uint8_t mask)
+{
+    MSCANx->CANTIER = mask & MSCAN_TX_BUFFERS_MASK;
+}
+
+#endif /* _INC_DRI_MSCAN_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,84 @@
+/*
+ * dri_port.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_DRI_PORT_H_
+#define _INC_DRI_PORT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dri_def.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define PORTA                 (&g_hostPort[0])
+#define PORTB                 (&g_hostPort[1])
+#define PORTC                 (&g_hostPort[2])
+#define PORTD                 (&g_hostPort[3])
+#define PORTE                 (&g_hostPort[4])
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+typedef enum
+{
+    PORT_PIN_DISABLED = 0U,
+    PORT_MUX_ALT1     = 1U,
+    PORT_MUX_GPIO     = 1U,
+    PORT_MUX_ALT2     = 2U,
+    PORT_MUX_ALT3     = 3U,
+    PORT_MUX_ALT4     = 4U,
+    PORT_MUX_ALT5     = 5U,
+    PORT_MUX_ALT6     = 6U,
+    PORT_MUX_ALT7     = 7U
+} Port_Mux_t;
+
+typedef enum
+{
+    PORT_PULL_NONE = 0U,
+    PORT_PULL_DOWN = 2U,
+    PORT_PULL_UP   = 3U
+} Port_Pull_Resistor_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: What the host keeps of a PORT: the function given to each pin
+ */
+typedef struct
+{
+    Port_Mux_t mux[32];
+} PORT_Type;
+
+typedef struct
+{
+    Port_Mux_t              Mux;
+    Port_Pull_Resistor_t    Pull;
+} PORT_InitTypeDef;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+extern PORT_Type g_hostPort[5];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+static inline void DRI_PORT_Pin_Init(PORT_Type *const PORTx, const uint8_t Pin,
+        const PORT_InitTypeDef *const PORT_Init)
+{
+    PORTx->mux[Pin] = PORT_Init->Mux;
+}
+
+#endif /* _INC_DRI_PORT_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
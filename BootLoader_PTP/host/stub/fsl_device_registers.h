@@ -0,0 +1,26 @@
+/*
+ * fsl_device_registers.h
+ *
+ *  Created on: May 11, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_FSL_DEVICE_REGISTERS_H_
+#define _INC_FSL_DEVICE_REGISTERS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKE16Z4.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Features of the MKE16Z4 used by the middle layer */
+#define FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE  (1024)
+
+#endif /* _INC_FSL_DEVICE_REGISTERS_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
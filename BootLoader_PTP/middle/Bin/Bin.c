@@ -0,0 +1,234 @@
+/*
+ * Bin.c
+ *
+ *  Created on: May 10, 2024
+ *      Author: Phong Pham-Thanh
+ *      Email:  Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "Bin.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define BIN_CRC_INIT    0xFFFFFFFFU  /* Initial value (and final XOR) of the CRC-32 */
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+
+/* CRC-32 (reflected polynomial 0xEDB88320) of every nibble, the CRC is updated 4 bits at a time */
+static const uint32_t s_crcTable[16U] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Check and apply the header of the image
+ * @param[out] decoder: Pointer to the decoder context
+ * @return:    SREC_PENDING if the data can be received, otherwise the status code of the failed check
+ */
+static Srec_Status_t BIN_CompleteHeader(Bin_Decoder_t *const decoder);
+
+
+/*
+ * @name:  BIN_DecoderInit
+ * ----------------------------
+ * @brief: Reset the decoder so that it waits for the magic byte of a new image
+ */
+void BIN_DecoderInit(Bin_Decoder_t *const decoder)
+{
+    if (NULL != decoder)
+    {
+        decoder->state       = BIN_DECODE_START;
+        decoder->sum         = 0U;
+        decoder->numBytes    = 0U;
+        decoder->chunkLength = 0U;
+        decoder->value       = 0U;
+        decoder->address     = 0U;
+        decoder->remaining   = 0U;
+        decoder->crc         = BIN_CRC_INIT;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @name:  BIN_DecoderIsIdle
+ * ----------------------------
+ * @brief: Check if the decoder is outside of an image
+ */
+uint8_t BIN_DecoderIsIdle(const Bin_Decoder_t *const decoder)
+{
+    return ((BIN_DECODE_START == decoder->state) || (BIN_DECODE_SKIP == decoder->state)) ? TRUE : FALSE;
+}
+
+
+/*
+ * @name:  BIN_DecodeChar
+ * ----------------------------
+ * @brief: Feed one received byte of a binary image into the decoder
+ */
+Srec_Status_t BIN_DecodeChar(Bin_Decoder_t *const decoder, const uint8_t character,
+                             Srec_Record_t *const record)
+{
+    Srec_Status_t status = SREC_PENDING;
+
+    switch (decoder->state)
+    {
+        case BIN_DECODE_START:
+            if (BIN_MAGIC == character)
+            {
+                decoder->sum      = 0U;
+                decoder->numBytes = 0U;
+                decoder->value    = 0U;
+                decoder->crc      = BIN_CRC_INIT;
+                decoder->state    = BIN_DECODE_HEADER;
+            }
+            else
+            {
+                status = SREC_ERROR_START;
+            }
+            break;
+
+        case BIN_DECODE_HEADER:
+            decoder->sum  += character;
+            decoder->value = (decoder->value << 8U) | character;
+            decoder->numBytes++;
+
+            if (4U == decoder->numBytes)
+            {
+                decoder->address = decoder->value;
+            }
+            else if (8U == decoder->numBytes)
+            {
+                decoder->remaining = decoder->value;
+            }
+            else if (BIN_HEADER_LENGTH == decoder->numBytes)
+            {
+                status = BIN_CompleteHeader(decoder);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        case BIN_DECODE_DATA:
+            if (0U == decoder->chunkLength)
+            {
+                record->type    = BIN_DATA_RECORD_TYPE;
+                record->address = decoder->address;
+                record->length  = 0U;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            record->data[record->length++] = character;
+
+            decoder->crc = (decoder->crc >> 4U) ^ s_crcTable[(decoder->crc ^ character) & 0x0FU];
+            decoder->crc = (decoder->crc >> 4U) ^ s_crcTable[(decoder->crc ^ (character >> 4U)) & 0x0FU];
+            decoder->chunkLength++;
+            decoder->address++;
+            decoder->remaining--;
+
+            if (0U == decoder->remaining)
+            {
+                decoder->numBytes = 0U;
+                decoder->value    = 0U;
+                decoder->state    = BIN_DECODE_TRAILER;
+                status = SREC_OK;
+            }
+            else if (BIN_CHUNK_LENGTH == decoder->chunkLength)
+            {
+                status = SREC_OK;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        case BIN_DECODE_TRAILER:
+            decoder->value = (decoder->value << 8U) | character;
+            decoder->numBytes++;
+
+            if (BIN_TRAILER_LENGTH == decoder->numBytes)
+            {
+                /* The image has no entry point of its own, the reset vector is used */
+                record->type    = BIN_TERMINATION_RECORD_TYPE;
+                record->address = 0U;
+                record->length  = 0U;
+                status = (decoder->value == (decoder->crc ^ BIN_CRC_INIT)) ? SREC_OK : SREC_ERROR_CHECKSUM;
+                decoder->state  = BIN_DECODE_START;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        case BIN_DECODE_SKIP:
+        default:
+            /* Do Nothing */
+            break;
+    }
+
+    if (SREC_OK == status)
+    {
+        /* The next data byte begins a new record */
+        decoder->chunkLength = 0U;
+    }
+    else if (SREC_PENDING != status)
+    {
+        /* There is no line to resynchronize on in a binary image */
+        decoder->state = BIN_DECODE_SKIP;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Check and apply the header of the image
+ */
+static Srec_Status_t BIN_CompleteHeader(Bin_Decoder_t *const decoder)
+{
+    Srec_Status_t status = SREC_PENDING;
+
+    if (0xFFU != decoder->sum)
+    {
+        status = SREC_ERROR_CHECKSUM;
+    }
+    else if (0U == decoder->remaining)
+    {
+        status = SREC_ERROR_BYTE_COUNT;
+    }
+    else
+    {
+        decoder->chunkLength = 0U;
+        decoder->state       = BIN_DECODE_DATA;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
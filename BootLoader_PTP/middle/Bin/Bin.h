@@ -0,0 +1,111 @@
+/*
+ * Bin.h
+ *
+ *  Created on: May 10, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_BIN_H_
+#define _INC_BIN_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "Srec.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define BIN_MAGIC                      0xB5U  /* First byte of a binary image, never the start of a text record */
+#define BIN_HEADER_LENGTH              9U     /* Address (4), length (4) and checksum (1), big-endian */
+#define BIN_TRAILER_LENGTH             4U     /* CRC-32 of the data, big-endian */
+#define BIN_CHUNK_LENGTH               128U   /* Number of data bytes given to one record */
+#define BIN_DATA_RECORD_TYPE           3U     /* Record type given to a chunk of data (32-bit address) */
+#define BIN_TERMINATION_RECORD_TYPE    7U     /* Record type given to the end of the image */
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+
+/*
+ * @brief: States of the byte-at-a-time binary image decoder
+ */
+typedef enum
+{
+    BIN_DECODE_START = 0U,    /* Waiting for the magic byte */
+    BIN_DECODE_HEADER,        /* Receiving the header */
+    BIN_DECODE_DATA,          /* Receiving the data */
+    BIN_DECODE_TRAILER,       /* Receiving the CRC-32 of the data */
+    BIN_DECODE_SKIP,          /* Dropping everything after an error */
+} Bin_Decode_State_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Context of the byte-at-a-time binary image decoder
+ */
+typedef struct
+{
+    Bin_Decode_State_t state;
+    uint8_t            sum;            /* Running sum of the header bytes */
+    uint8_t            numBytes;       /* Number of header or trailer bytes received so far */
+    uint8_t            chunkLength;    /* Number of data bytes in the current record */
+    uint32_t           value;          /* Header or trailer field being received */
+    uint32_t           address;        /* Address of the next data byte */
+    uint32_t           remaining;      /* Number of data bytes still expected */
+    uint32_t           crc;            /* Running CRC-32 of the data */
+} Bin_Decoder_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       BIN_DecoderInit
+ * ----------------------------
+ * @brief:      Reset the decoder so that it waits for the magic byte of a new image
+ * @param[out]: decoder: Pointer to the decoder context
+ * @return:     None
+ */
+void BIN_DecoderInit(Bin_Decoder_t *const decoder);
+
+
+/*
+ * @name:       BIN_DecoderIsIdle
+ * ----------------------------
+ * @brief:      Check if the decoder is outside of an image
+ * @param[in]:  decoder: Pointer to the decoder context
+ * @return:     TRUE if no image is being received, FALSE otherwise
+ */
+uint8_t BIN_DecoderIsIdle(const Bin_Decoder_t *const decoder);
+
+
+/*
+ * @name:       BIN_DecodeChar
+ * ----------------------------
+ * @brief:      Feed one received byte of a binary image into the decoder.
+ *              The image is BIN_MAGIC, a header giving the load address and the number
+ *              of data bytes, the raw data bytes, then the CRC-32 of the data bytes.
+ *              The data is cut into records of type BIN_DATA_RECORD_TYPE holding up to
+ *              BIN_CHUNK_LENGTH bytes, and the CRC-32 gives a record of type
+ *              BIN_TERMINATION_RECORD_TYPE
+ * @param[out]: decoder: Pointer to the decoder context
+ * @param[in]:  character: The received byte
+ * @param[out]: record: The record being filled in
+ * @return:     SREC_PENDING while no record is complete,
+ *              SREC_OK as soon as a record is complete,
+ *              otherwise the status code of the failed check
+ * @note:       The sum of the header bytes, checksum included, must be 0xFF as in a SREC record.
+ *              After an error every byte is dropped until the decoder is initialized again
+ */
+Srec_Status_t BIN_DecodeChar(Bin_Decoder_t *const decoder, const uint8_t character,
+                             Srec_Record_t *const record);
+
+#endif /* _INC_BIN_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,345 @@
+/*
+ * Ihex.c
+ *
+ *  Created on: May 10, 2024
+ *      Author: Phong Pham-Thanh
+ *      Email:  Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "Ihex.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define IHEX_TYPE_DATA                 0x00U  /* Data */
+#define IHEX_TYPE_END_OF_FILE          0x01U  /* End Of File */
+#define IHEX_TYPE_EXTENDED_SEGMENT     0x02U  /* Extended Segment Address */
+#define IHEX_TYPE_EXTENDED_LINEAR      0x04U  /* Extended Linear Address */
+#define IHEX_TYPE_START_LINEAR         0x05U  /* Start Linear Address */
+
+#define IHEX_HEADER_LENGTH             4U     /* byteCount, 2 offset bytes and type */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Check the type field of a record against its byteCount field
+ * @param[in]  decoder: Pointer to the decoder context
+ * @return:    SREC_PENDING if the record can be received, otherwise the status code of the failed check
+ */
+static Srec_Status_t IHEX_CheckType(const Ihex_Decoder_t *const decoder);
+
+
+/*
+ * @brief:     Apply a record whose checksum is valid
+ * @param[out] decoder: Pointer to the decoder context
+ * @param[out] record: The record being filled in
+ * @return:    SREC_OK if the record has to be handed over, SREC_CONSUMED if it has been kept
+ */
+static Srec_Status_t IHEX_CompleteRecord(Ihex_Decoder_t *const decoder, Srec_Record_t *const record);
+
+
+/*
+ * @name:  IHEX_DecoderInit
+ * ----------------------------
+ * @brief: Reset the decoder so that it waits for the first record of a new image
+ */
+void IHEX_DecoderInit(Ihex_Decoder_t *const decoder)
+{
+    if (NULL != decoder)
+    {
+        IHEX_DecoderResync(decoder);
+        decoder->baseAddress = 0U;
+        decoder->entryPoint  = 0U;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @name:  IHEX_DecoderResync
+ * ----------------------------
+ * @brief: Drop the record being received, keeping the base address and the entry point
+ */
+void IHEX_DecoderResync(Ihex_Decoder_t *const decoder)
+{
+    if (NULL != decoder)
+    {
+        decoder->state      = IHEX_DECODE_START;
+        decoder->high       = 0U;
+        decoder->sum        = 0U;
+        decoder->byteCount  = 0U;
+        decoder->recordType = 0U;
+        decoder->numBytes   = 0U;
+        decoder->value      = 0U;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+
+/*
+ * @name:  IHEX_DecoderIsIdle
+ * ----------------------------
+ * @brief: Check if the decoder is between two records
+ */
+uint8_t IHEX_DecoderIsIdle(const Ihex_Decoder_t *const decoder)
+{
+    return (IHEX_DECODE_START == decoder->state) ? TRUE : FALSE;
+}
+
+
+/*
+ * @name:  IHEX_DecodeChar
+ * ----------------------------
+ * @brief: Feed one received character into the Intel HEX decoder
+ */
+Srec_Status_t IHEX_DecodeChar(Ihex_Decoder_t *const decoder, const uint8_t character,
+                              Srec_Record_t *const record)
+{
+    Srec_Status_t status    = SREC_PENDING;
+    uint8_t       nibble    = 0U;
+    uint8_t       byteValue = 0U;
+
+    switch (decoder->state)
+    {
+        case IHEX_DECODE_START:
+            if (':' == character)
+            {
+                record->address   = 0U;
+                record->length    = 0U;
+                decoder->sum      = 0U;
+                decoder->numBytes = 0U;
+                decoder->value    = 0U;
+                decoder->state    = IHEX_DECODE_HIGH;
+            }
+            else if (('\r' != character) && ('\n' != character))
+            {
+                status = SREC_ERROR_START;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        case IHEX_DECODE_HIGH:
+            nibble = g_srecHexTable[character];
+            if (0U == (nibble & SREC_HEX_INVALID))
+            {
+                decoder->high  = nibble;
+                decoder->state = IHEX_DECODE_LOW;
+            }
+            else if (('\r' == character) || ('\n' == character))
+            {
+                status = SREC_ERROR_BYTE_COUNT; /* The line ended before its checksum */
+            }
+            else
+            {
+                status = SREC_ERROR_SYNTAX;
+            }
+            break;
+
+        case IHEX_DECODE_LOW:
+            nibble = g_srecHexTable[character];
+            if (0U == (nibble & SREC_HEX_INVALID))
+            {
+                byteValue     = (uint8_t)((decoder->high << 4U) | nibble);
+                decoder->sum += byteValue;
+
+                if (0U == decoder->numBytes)
+                {
+                    decoder->byteCount = byteValue;
+                }
+                else if (decoder->numBytes < (IHEX_HEADER_LENGTH - 1U))
+                {
+                    /* Offset of the record, turned into an address once the type is known */
+                    record->address = (record->address << 8U) | byteValue;
+                }
+                else if (decoder->numBytes == (IHEX_HEADER_LENGTH - 1U))
+                {
+                    decoder->recordType = byteValue;
+                    status = IHEX_CheckType(decoder);
+                    if (IHEX_TYPE_DATA == byteValue)
+                    {
+                        record->type     = IHEX_DATA_RECORD_TYPE;
+                        record->address += decoder->baseAddress;
+                    }
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+                }
+                else if (decoder->numBytes < (IHEX_HEADER_LENGTH + decoder->byteCount))
+                {
+                    if (IHEX_TYPE_DATA == decoder->recordType)
+                    {
+                        record->data[record->length++] = byteValue;
+                    }
+                    else
+                    {
+                        decoder->value = (decoder->value << 8U) | byteValue;
+                    }
+                }
+                else
+                {
+                    /* The checksum byte has landed: the checksum is the two's complement of the
+                     * sum of all other bytes, so the sum of every byte of a valid record is 0x00 */
+                    status = (0U == decoder->sum) ? IHEX_CompleteRecord(decoder, record) : SREC_ERROR_CHECKSUM;
+                    decoder->state = IHEX_DECODE_START;
+                }
+
+                if (IHEX_DECODE_LOW == decoder->state)
+                {
+                    decoder->numBytes++;
+                    decoder->state = IHEX_DECODE_HIGH;
+                }
+                else
+                {
+                    /* Do Nothing */
+                }
+            }
+            else
+            {
+                status = SREC_ERROR_SYNTAX;
+            }
+            break;
+
+        case IHEX_DECODE_SKIP:
+            if ('\n' == character)
+            {
+                decoder->state = IHEX_DECODE_START;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        default:
+            decoder->state = IHEX_DECODE_START;
+            break;
+    }
+
+    if ((SREC_OK == status) || (SREC_CONSUMED == status))
+    {
+        decoder->state = IHEX_DECODE_START;
+    }
+    else if (SREC_PENDING != status)
+    {
+        /* Drop the rest of the bad line, unless the bad character has already ended it */
+        decoder->state = ('\n' == character) ? IHEX_DECODE_START : IHEX_DECODE_SKIP;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Check the type field of a record against its byteCount field
+ */
+static Srec_Status_t IHEX_CheckType(const Ihex_Decoder_t *const decoder)
+{
+    Srec_Status_t status    = SREC_PENDING;
+    uint8_t       byteCount = 0U;
+
+    switch (decoder->recordType)
+    {
+        case IHEX_TYPE_DATA:
+            if (decoder->byteCount > SREC_MAX_DATA_LENGTH)
+            {
+                /* The data field would not fit in the data buffer of the record */
+                status = SREC_ERROR_BYTE_COUNT;
+            }
+            else
+            {
+                byteCount = decoder->byteCount;
+            }
+            break;
+
+        case IHEX_TYPE_END_OF_FILE:
+            byteCount = 0U;
+            break;
+
+        case IHEX_TYPE_EXTENDED_SEGMENT:
+        case IHEX_TYPE_EXTENDED_LINEAR:
+            byteCount = 2U;
+            break;
+
+        case IHEX_TYPE_START_LINEAR:
+            byteCount = 4U;
+            break;
+
+        default:
+            status = SREC_ERROR_TYPE;
+            break;
+    }
+
+    if ((SREC_PENDING == status) && (byteCount != decoder->byteCount))
+    {
+        status = SREC_ERROR_BYTE_COUNT;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Apply a record whose checksum is valid
+ */
+static Srec_Status_t IHEX_CompleteRecord(Ihex_Decoder_t *const decoder, Srec_Record_t *const record)
+{
+    Srec_Status_t status = SREC_CONSUMED;
+
+    switch (decoder->recordType)
+    {
+        case IHEX_TYPE_DATA:
+            status = SREC_OK;
+            break;
+
+        case IHEX_TYPE_END_OF_FILE:
+            record->type    = IHEX_TERMINATION_RECORD_TYPE;
+            record->address = decoder->entryPoint;
+            status = SREC_OK;
+            break;
+
+        case IHEX_TYPE_EXTENDED_SEGMENT:
+            decoder->baseAddress = decoder->value << 4U;
+            break;
+
+        case IHEX_TYPE_EXTENDED_LINEAR:
+            decoder->baseAddress = decoder->value << 16U;
+            break;
+
+        case IHEX_TYPE_START_LINEAR:
+            decoder->entryPoint = decoder->value;
+            break;
+
+        default:
+            /* Do Nothing */
+            break;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
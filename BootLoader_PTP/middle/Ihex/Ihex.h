@@ -0,0 +1,121 @@
+/*
+ * Ihex.h
+ *
+ *  Created on: May 10, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_IHEX_H_
+#define _INC_IHEX_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "Srec.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define IHEX_DATA_RECORD_TYPE          3U  /* Record type given to a data record (32-bit address) */
+#define IHEX_TERMINATION_RECORD_TYPE   7U  /* Record type given to the End Of File record */
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+
+/*
+ * @brief: States of the byte-at-a-time Intel HEX decoder
+ */
+typedef enum
+{
+    IHEX_DECODE_START = 0U,   /* Waiting for the ':' of the next record */
+    IHEX_DECODE_HIGH,         /* Waiting for the high nibble of a byte */
+    IHEX_DECODE_LOW,          /* Waiting for the low nibble of a byte */
+    IHEX_DECODE_SKIP,         /* Dropping the rest of a bad line until its newline */
+} Ihex_Decode_State_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Context of the byte-at-a-time Intel HEX decoder
+ */
+typedef struct
+{
+    Ihex_Decode_State_t state;
+    uint8_t             high;           /* High nibble of the byte being received */
+    uint8_t             sum;            /* Running sum of the bytes received so far */
+    uint8_t             byteCount;      /* byteCount field of the record being received */
+    uint8_t             recordType;     /* Type field of the record being received */
+    uint16_t            numBytes;       /* Number of bytes received so far, byteCount included */
+    uint32_t            value;          /* Data field of an address record */
+    uint32_t            baseAddress;    /* Base address set by the last 02 or 04 record */
+    uint32_t            entryPoint;     /* Start address set by the last 05 record */
+} Ihex_Decoder_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       IHEX_DecoderInit
+ * ----------------------------
+ * @brief:      Reset the decoder so that it waits for the first record of a new image
+ * @param[out]: decoder: Pointer to the decoder context
+ * @return:     None
+ */
+void IHEX_DecoderInit(Ihex_Decoder_t *const decoder);
+
+
+/*
+ * @name:       IHEX_DecoderResync
+ * ----------------------------
+ * @brief:      Drop the record being received so that the decoder waits for the next one,
+ *              keeping the base address and the entry point of the image
+ * @param[out]: decoder: Pointer to the decoder context
+ * @return:     None
+ */
+void IHEX_DecoderResync(Ihex_Decoder_t *const decoder);
+
+
+/*
+ * @name:       IHEX_DecoderIsIdle
+ * ----------------------------
+ * @brief:      Check if the decoder is between two records
+ * @param[in]:  decoder: Pointer to the decoder context
+ * @return:     TRUE if no record is being received, FALSE otherwise
+ */
+uint8_t IHEX_DecoderIsIdle(const Ihex_Decoder_t *const decoder);
+
+
+/*
+ * @name:       IHEX_DecodeChar
+ * ----------------------------
+ * @brief:      Feed one received character into the Intel HEX decoder.
+ *              Records are decoded into the same binary form as the SREC records:
+ *              - 00 (Data) gives a record of type IHEX_DATA_RECORD_TYPE, whose address is
+ *                the base address plus the offset of the record
+ *              - 01 (End Of File) gives a record of type IHEX_TERMINATION_RECORD_TYPE,
+ *                whose address is the start address of the last 05 record (0 if none)
+ *              - 02 (Extended Segment Address), 04 (Extended Linear Address) and
+ *                05 (Start Linear Address) are kept by the decoder and give no record
+ * @param[out]: decoder: Pointer to the decoder context
+ * @param[in]:  character: The received character
+ * @param[out]: record: The record being filled in
+ * @return:     SREC_PENDING while no record is complete,
+ *              SREC_OK as soon as the checksum byte of a valid 00 or 01 record is received,
+ *              SREC_CONSUMED for a valid 02, 04 or 05 record,
+ *              otherwise the status code of the failed check
+ * @note:       Newlines between records are ignored. After an error, the rest of the
+ *              line is dropped and decoding resumes with the next record
+ */
+Srec_Status_t IHEX_DecodeChar(Ihex_Decoder_t *const decoder, const uint8_t character,
+                              Srec_Record_t *const record);
+
+#endif /* _INC_IHEX_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,307 @@
+/*
+ * Planner.c
+ *
+ *  Created on: May 17, 2024
+ *      Author: Phong Pham-Thanh
+ *      Email:  Phong.PT.HUST@gmail.com
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "Planner.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define PLANNER_WORD_FULL    0x0FU  /* Mask of a word whose four bytes have been written */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ * @brief:     Program a whole word, erasing its sector first if it has not been erased yet
+ * @param[out] planner: Pointer to the planner context
+ * @param[in]  address: Address of the word
+ * @param[in]  data: Pointer to the four bytes of the word
+ * @return:    PLANNER_OK, PLANNER_ERROR_OVERLAP if the word has already been programmed,
+ *             PLANNER_ERROR_ERASE if its sector could not be erased
+ */
+static Planner_Status_t PLANNER_ProgramWord(Planner_t *const planner, const uint32_t address,
+                                            const uint8_t *const data);
+
+
+/*
+ * @brief:     Write some of the bytes of a word through the cache
+ * @param[out] planner: Pointer to the planner context
+ * @param[in]  address: Address of the word
+ * @param[in]  first: Index of the first byte to be written in the word
+ * @param[in]  data: Pointer to the bytes to be written
+ * @param[in]  count: Number of bytes to be written
+ * @return:    PLANNER_OK, PLANNER_ERROR_OVERLAP if one of the bytes has already been written
+ */
+static Planner_Status_t PLANNER_WriteBytes(Planner_t *const planner, const uint32_t address,
+                                           const uint8_t first, const uint8_t *const data,
+                                           const uint8_t count);
+
+
+/*
+ * @brief:     Find the cache entry of a word
+ * @param[in]  planner: Pointer to the planner context
+ * @param[in]  address: Address of the word
+ * @return:    Index of the entry, PLANNER_CACHE_SIZE if the word is not in the cache
+ */
+static uint8_t PLANNER_FindWord(const Planner_t *const planner, const uint32_t address);
+
+
+/*
+ * @name:  PLANNER_Init
+ * ----------------------------
+ * @brief: Start following a region of flash memory, nothing is erased yet
+ */
+Planner_Status_t PLANNER_Init(Planner_t *const planner, const uint32_t baseAddress,
+                              const uint32_t numSectors)
+{
+    Planner_Status_t status = PLANNER_OK;
+
+    (void)memset(planner, 0, sizeof(Planner_t));
+
+    if (numSectors <= PLANNER_MAX_SECTORS)
+    {
+        planner->baseAddress = baseAddress;
+        planner->endAddress  = baseAddress + (numSectors * PLANNER_SECTOR_SIZE);
+    }
+    else
+    {
+        /* An empty region refuses every write */
+        planner->baseAddress = baseAddress;
+        planner->endAddress  = baseAddress;
+        status = PLANNER_ERROR_RANGE;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  PLANNER_Write
+ * ----------------------------
+ * @brief: Write a block of data anywhere in the region, in any order
+ */
+Planner_Status_t PLANNER_Write(Planner_t *const planner, const uint32_t address,
+                               const uint8_t *const data, const uint32_t length)
+{
+    Planner_Status_t status   = PLANNER_OK;
+    uint32_t         offset   = 0U;
+    uint32_t         byteAddr = 0U;
+    uint8_t          first    = 0U;
+    uint8_t          count    = 0U;
+
+    if ((address < planner->baseAddress) || (address > planner->endAddress)
+            || (length > (planner->endAddress - address)))
+    {
+        status = PLANNER_ERROR_RANGE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    while ((offset < length) && (PLANNER_OK == status))
+    {
+        byteAddr = address + offset;
+        first    = (uint8_t)(byteAddr & 3U);
+        count    = ((length - offset) < (4U - first)) ? (uint8_t)(length - offset) : (4U - first);
+
+        if ((4U == count) && (PLANNER_CACHE_SIZE == PLANNER_FindWord(planner, byteAddr)))
+        {
+            status = PLANNER_ProgramWord(planner, byteAddr, &data[offset]);
+        }
+        else
+        {
+            status = PLANNER_WriteBytes(planner, byteAddr - first, first, &data[offset], count);
+        }
+
+        offset += count;
+    }
+
+    return status;
+}
+
+
+/*
+ * @name:  PLANNER_Flush
+ * ----------------------------
+ * @brief: Program the words that are still partly written
+ */
+Planner_Status_t PLANNER_Flush(Planner_t *const planner)
+{
+    Planner_Status_t status = PLANNER_OK;
+    uint8_t          index  = 0U;
+
+    for (index = 0U; (index < PLANNER_CACHE_SIZE) && (PLANNER_OK == status); ++index)
+    {
+        if (0U != planner->cache[index].mask)
+        {
+            status = PLANNER_ProgramWord(planner, planner->cache[index].address, planner->cache[index].data);
+            planner->cache[index].mask = 0U;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Program a whole word, erasing its sector first if it has not been erased yet
+ */
+static Planner_Status_t PLANNER_ProgramWord(Planner_t *const planner, const uint32_t address,
+                                            const uint8_t *const data)
+{
+    Planner_Status_t status = PLANNER_OK;
+    uint32_t         word   = (address - planner->baseAddress) / 4U;
+    uint32_t         sector = word / PLANNER_WORDS_PER_SECTOR;
+
+    if (0U != (planner->programmedWords[word / 32U] & (1UL << (word % 32U))))
+    {
+        status = PLANNER_ERROR_OVERLAP;
+    }
+    else
+    {
+        if (0U == (planner->erasedSectors & (1UL << sector)))
+        {
+            if (0U == Erase_Sector(planner->baseAddress + (sector * PLANNER_SECTOR_SIZE)))
+            {
+                planner->erasedSectors |= (1UL << sector);
+            }
+            else
+            {
+                status = PLANNER_ERROR_ERASE;
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if (PLANNER_OK == status)
+        {
+            Program_LongWord(address, data);
+            planner->programmedWords[word / 32U] |= (1UL << (word % 32U));
+        }
+        else
+        {
+            /* Do Nothing: the word is not programmed into a sector that is not blank */
+        }
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Write some of the bytes of a word through the cache
+ */
+static Planner_Status_t PLANNER_WriteBytes(Planner_t *const planner, const uint32_t address,
+                                           const uint8_t first, const uint8_t *const data,
+                                           const uint8_t count)
+{
+    Planner_Status_t status = PLANNER_OK;
+    Planner_Word_t   *entry = NULL;
+    uint8_t          index  = PLANNER_FindWord(planner, address);
+    uint8_t          mask   = (uint8_t)(((1U << count) - 1U) << first);
+    uint32_t         word   = (address - planner->baseAddress) / 4U;
+
+    if (PLANNER_CACHE_SIZE == index)
+    {
+        if (0U != (planner->programmedWords[word / 32U] & (1UL << (word % 32U))))
+        {
+            status = PLANNER_ERROR_OVERLAP;
+        }
+        else
+        {
+            /* Take a free entry, or make room by programming the oldest partial word */
+            index = 0U;
+            while ((index < PLANNER_CACHE_SIZE) && (0U != planner->cache[index].mask))
+            {
+                index++;
+            }
+
+            if (PLANNER_CACHE_SIZE == index)
+            {
+                index  = planner->nextEvict;
+                status = PLANNER_ProgramWord(planner, planner->cache[index].address, planner->cache[index].data);
+                planner->nextEvict = (uint8_t)((index + 1U) % PLANNER_CACHE_SIZE);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+
+            planner->cache[index].address = address;
+            planner->cache[index].mask    = 0U;
+            (void)memset(planner->cache[index].data, 0xFF, sizeof(planner->cache[index].data));
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (PLANNER_OK == status)
+    {
+        entry = &planner->cache[index];
+
+        if (0U != (entry->mask & mask))
+        {
+            status = PLANNER_ERROR_OVERLAP;
+        }
+        else
+        {
+            (void)memcpy(&entry->data[first], data, count);
+            entry->mask |= mask;
+
+            if (PLANNER_WORD_FULL == entry->mask)
+            {
+                entry->mask = 0U;
+                status = PLANNER_ProgramWord(planner, entry->address, entry->data);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: Find the cache entry of a word
+ */
+static uint8_t PLANNER_FindWord(const Planner_t *const planner, const uint32_t address)
+{
+    uint8_t index = 0U;
+
+    while ((index < PLANNER_CACHE_SIZE)
+            && ((0U == planner->cache[index].mask) || (address != planner->cache[index].address)))
+    {
+        index++;
+    }
+
+    return index;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
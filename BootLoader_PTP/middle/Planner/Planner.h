@@ -0,0 +1,122 @@
+/*
+ * Planner.h
+ *
+ *  Created on: May 17, 2024
+ *      Author: Phong Pham-Thanh
+ *       Email: Phong.PT.HUST@gmail.com
+ */
+
+#ifndef _INC_PLANNER_H_
+#define _INC_PLANNER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "fsl_device_registers.h"
+#include "flash.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define PLANNER_SECTOR_SIZE         FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE
+#define PLANNER_WORDS_PER_SECTOR    (PLANNER_SECTOR_SIZE / 4U)
+#define PLANNER_MAX_SECTORS         16U  /* Largest region the planner can follow (32 at most) */
+#define PLANNER_CACHE_SIZE          8U   /* Number of partly written words kept in RAM */
+
+/*******************************************************************************
+ * Typedef enums
+ ******************************************************************************/
+
+/*
+ * @brief: Status codes of the write planner
+ */
+typedef enum
+{
+    PLANNER_OK = 0U,
+    PLANNER_ERROR_RANGE,      /* The data does not lie inside the region */
+    PLANNER_ERROR_OVERLAP,    /* The data lands on bytes that have already been written */
+    PLANNER_ERROR_ERASE,      /* The sector of the data could not be erased */
+} Planner_Status_t;
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Word of flash whose bytes have not all been written yet
+ */
+typedef struct
+{
+    uint32_t address;         /* Address of the word */
+    uint8_t  mask;            /* Bit n is set when byte n has been written, 0 for a free entry */
+    uint8_t  data[4U];        /* Content of the word, 0xFF for the bytes not written */
+} Planner_Word_t;
+
+
+/*
+ * @brief: Context of the write planner.
+ *         A sector of the region is erased right before its first word is programmed,
+ *         and every programmed word is marked so that it is never programmed twice
+ */
+typedef struct
+{
+    uint32_t       baseAddress;                 /* First address of the region */
+    uint32_t       endAddress;                  /* Address just past the region */
+    uint32_t       erasedSectors;               /* Bit n is set when sector n has been erased */
+    uint32_t       programmedWords[(PLANNER_MAX_SECTORS * PLANNER_WORDS_PER_SECTOR) / 32U];
+    uint8_t        nextEvict;                   /* Entry of the cache to be flushed when it is full */
+    Planner_Word_t cache[PLANNER_CACHE_SIZE];
+} Planner_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*
+ * @name:       PLANNER_Init
+ * ----------------------------
+ * @brief:      Start following a region of flash memory, nothing is erased yet
+ * @param[out]: planner: Pointer to the planner context
+ * @param[in]:  baseAddress: First address of the region, aligned on a sector
+ * @param[in]:  numSectors: Number of sectors in the region
+ * @return:     PLANNER_OK, PLANNER_ERROR_RANGE if the region is larger than PLANNER_MAX_SECTORS
+ */
+Planner_Status_t PLANNER_Init(Planner_t *const planner, const uint32_t baseAddress,
+                              const uint32_t numSectors);
+
+
+/*
+ * @name:       PLANNER_Write
+ * ----------------------------
+ * @brief:      Write a block of data anywhere in the region, in any order.
+ *              Whole words are programmed at once, the bytes of a word that is only
+ *              partly covered are kept until the rest of the word is written
+ * @param[out]: planner: Pointer to the planner context
+ * @param[in]:  address: Address of the first byte
+ * @param[in]:  data: Pointer to the bytes to be written
+ * @param[in]:  length: Number of bytes to be written
+ * @return:     PLANNER_OK, otherwise the status code of the failed check
+ * @note:       When more than PLANNER_CACHE_SIZE words are partly written at the same time,
+ *              the oldest one is programmed with 0xFF in its missing bytes, and writing
+ *              these bytes later is reported as an overlap
+ */
+Planner_Status_t PLANNER_Write(Planner_t *const planner, const uint32_t address,
+                               const uint8_t *const data, const uint32_t length);
+
+
+/*
+ * @name:       PLANNER_Flush
+ * ----------------------------
+ * @brief:      Program the words that are still partly written, the missing bytes
+ *              keep the erased value of the flash (0xFF)
+ * @param[out]: planner: Pointer to the planner context
+ * @return:     PLANNER_OK, otherwise the status code of the failed check
+ */
+Planner_Status_t PLANNER_Flush(Planner_t *const planner);
+
+#endif /* _INC_PLANNER_H_ */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
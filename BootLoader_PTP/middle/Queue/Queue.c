@@ -15,6 +15,17 @@
  * Prototypes
  ******************************************************************************/
 
+/*
+ * @brief:     Find room for the data field of the next record
+ * @param[in]  Queue: Pointer to the circular queue structure
+ * @param[in]  head: Head index of the queue
+ * @param[in]  tail: Tail index of the queue, as seen by the producer
+ * @return:    Offset in DataArr of SREC_MAX_DATA_LENGTH free contiguous bytes,
+ *             QUEUE_DATA_SIZE if there is not enough room
+ */
+static uint16_t Queue_findDataRoom(const CircularQueue_t *const Queue,
+                                   const uint8_t head, const uint8_t tail);
+
 /*
  * @name:  Queue_Init
  * ----------------------------
@@ -22,22 +33,12 @@
  */
 void Queue_Init(CircularQueue_t *const Queue)
 {
-    uint8_t  row  = 0U;
-    uint32_t col  = 0U;
-
     if (NULL != Queue)
     {
-        Queue->front    = -1;
-        Queue->rear     = -1;
-        Queue->capacity = 0U;
-        Queue->size     = QUEUE_MAX_SIZE;
-        for (row = 0U; row < QUEUE_MAX_SIZE; ++row)
-        {
-            for (col = 0U; col < LINE_MAX_CHAR; ++col)
-            {
-                Queue->QueueArr[row][col] = 0U;
-            }
-        }
+        Queue->head    = 0U;
+        Queue->tail    = 0U;
+        Queue->dataEnd = 0U;
+        (void)memset(Queue->QueueArr, 0, sizeof(Queue->QueueArr));
     }
     else
     {
@@ -57,10 +58,9 @@ void Queue_DeInit(CircularQueue_t *const Queue)
 {
     if (NULL != Queue)
     {
-        Queue->front    = -1;
-        Queue->rear     = -1;
-        Queue->size     = 0U;
-        Queue->capacity = 0U;
+        Queue->head    = 0U;
+        Queue->tail    = 0U;
+        Queue->dataEnd = 0U;
     }
     else
     {
@@ -80,7 +80,7 @@ uint8_t Queue_isFull(const CircularQueue_t *const Queue)
 
     if (NULL != Queue)
     {
-        if (Queue->capacity == Queue->size)
+        if ((uint8_t)(Queue->head - Queue->tail) >= QUEUE_MAX_SIZE)
         {
             status = TRUE;
         }
@@ -109,7 +109,7 @@ uint8_t Queue_isEmpty(const CircularQueue_t *const Queue)
 
     if (NULL != Queue)
     {
-        if (Queue->capacity == 0U)
+        if (Queue->head == Queue->tail)
         {
             status = TRUE;
         }
@@ -128,37 +128,124 @@ uint8_t Queue_isEmpty(const CircularQueue_t *const Queue)
 
 
 /*
- * @name:  Queue_enQueue
+ * @name:  Queue_getCount
+ * ----------------------------
+ * @brief: Get the number of records in the circular queue
+ */
+uint8_t Queue_getCount(const CircularQueue_t *const Queue)
+{
+    return (uint8_t)(Queue->head - Queue->tail);
+}
+
+
+/*
+ * @name:  Queue_getFreeBytes
  * ----------------------------
- * @brief: Enqueue a byte into the circular queue
+ * @brief: Get the number of bytes of DataArr not used by the records of the queue
  */
-int8_t Queue_enQueue(CircularQueue_t *const Queue, const uint8_t byteData)
+uint16_t Queue_getFreeBytes(const CircularQueue_t *const Queue)
 {
-    static uint16_t s_col = 0U;
-    static uint8_t  s_row = 0U;
-    int8_t retVal         = 0U;
+    uint16_t            freeBytes = QUEUE_DATA_SIZE;
+    uint8_t             head      = Queue->head;  /* Both sides may call this, so only the indices */
+    uint8_t             tail      = Queue->tail;  /* and the records they publish are used */
+    const Srec_Record_t *p_Last   = NULL;
+    uint16_t            dataBegin = 0U;
+    uint16_t            lastBegin = 0U;
+    uint16_t            dataEnd   = 0U;
+
+    if (head != tail)
+    {
+        p_Last    = &(Queue->QueueArr[(uint8_t)(head - 1U) & QUEUE_INDEX_MASK]);
+        dataBegin = (uint16_t)(Queue->QueueArr[tail & QUEUE_INDEX_MASK].data - Queue->DataArr);
+        lastBegin = (uint16_t)(p_Last->data - Queue->DataArr);
+        dataEnd   = lastBegin + p_Last->length;
+
+        if (lastBegin >= dataBegin)
+        {
+            /* Used bytes are [dataBegin, dataEnd) */
+            freeBytes = (uint16_t)(QUEUE_DATA_SIZE - dataEnd + dataBegin);
+        }
+        else
+        {
+            /* Used bytes have wrapped around: the only free bytes are [dataEnd, dataBegin) */
+            freeBytes = (uint16_t)(dataBegin - dataEnd);
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return freeBytes;
+}
+
+
+/*
+ * @name:  Queue_getRearSlot
+ * ----------------------------
+ * @brief: Get the free slot behind the rear of the queue
+ */
+Srec_Record_t* Queue_getRearSlot(CircularQueue_t *const Queue)
+{
+    Srec_Record_t *slotAddress = NULL;
+    uint16_t      dataOffset   = QUEUE_DATA_SIZE;
+    uint8_t       head         = 0U;
+    uint8_t       tail         = 0U;
 
     if (NULL != Queue)
     {
-        /* The row which the new byte will be stored */
-        s_row = (Queue->rear + 1U) % (Queue->size);
+        /* Take the tail once: the consumer may move it at any time, which only frees more room */
+        head = Queue->head;
+        tail = Queue->tail;
 
+        if ((uint8_t)(head - tail) < QUEUE_MAX_SIZE)
+        {
+            dataOffset = Queue_findDataRoom(Queue, head, tail);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if (dataOffset < QUEUE_DATA_SIZE)
+        {
+            slotAddress       = &(Queue->QueueArr[head & QUEUE_INDEX_MASK]);
+            slotAddress->data = &(Queue->DataArr[dataOffset]);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return slotAddress;
+}
+
+
+/*
+ * @name:  Queue_enQueue
+ * ----------------------------
+ * @brief: Enqueue the record held in the slot returned by Queue_getRearSlot
+ */
+int8_t Queue_enQueue(CircularQueue_t *const Queue)
+{
+    int8_t        retVal  = 0U;
+    Srec_Record_t *p_Slot = NULL;
+
+    if (NULL != Queue)
+    {
         if (!Queue_isFull(Queue))
         {
-            Queue->QueueArr[s_row][s_col++] = byteData; /* Enqueue the byte into the queue */
-            if (byteData == 0x0A) /* Check if receive the new line char ('\n') */
-            {
-                Queue->capacity++;
-                s_col = 0U; /* Reset the column index to 0 */
-                Queue->rear = (Queue->rear + 1U) % Queue->size; /* Update the rear index */
-            }
+            p_Slot         = &(Queue->QueueArr[Queue->head & QUEUE_INDEX_MASK]);
+            Queue->dataEnd = (uint16_t)(p_Slot->data - Queue->DataArr) + p_Slot->length;
 
-            /* If this condition is true, it means there is one element in the queue.
-             * Therefore update the front to 0 */
-            if ((-1 == Queue->front) && (Queue->rear == 0U))
-            {
-                Queue->front = 0U; /* Front = rear = 0 informs there is a element in the queue */
-            }
+            /* The record must be complete in memory before the consumer can see it */
+            __DMB();
+            Queue->head++;
         }
         else
         {
@@ -176,21 +263,21 @@ int8_t Queue_enQueue(CircularQueue_t *const Queue, const uint8_t byteData)
 /*
  * @name:  Queue_deQueue
  * ----------------------------
- * @brief: Dequeue a line from the circular queue
+ * @brief: Dequeue a record from the circular queue
  */
 void* Queue_deQueue(CircularQueue_t *const Queue)
 {
-    void *lineAddress = NULL;
+    void *recordAddress = NULL;
 
     if (NULL != Queue)
     {
         if (!Queue_isEmpty(Queue))
         {
-            lineAddress = &(Queue->QueueArr[Queue->front][0U]);
-            Queue->front = (Queue->front + 1U) % Queue->size;
-            NVIC_DisableIRQ(LPUART0_IRQn);           /* Disable interrupt */
-            Queue->capacity--;
-            NVIC_EnableIRQ(LPUART0_IRQn);           /*  Enable interrupt again */
+            recordAddress = &(Queue->QueueArr[Queue->tail & QUEUE_INDEX_MASK]);
+
+            /* Every read of the record must be done before its slot goes back to the producer */
+            __DMB();
+            Queue->tail++;
         }
         else
         {
@@ -202,7 +289,7 @@ void* Queue_deQueue(CircularQueue_t *const Queue)
         /* Do Nothing */
     }
 
-    return lineAddress;
+    return recordAddress;
 }
 
 
@@ -213,13 +300,13 @@ void* Queue_deQueue(CircularQueue_t *const Queue)
  */
 void* Queue_peekQueue(CircularQueue_t *const Queue)
 {
-    void *lineAddress = NULL;
+    void *recordAddress = NULL;
 
     if (NULL != Queue)
     {
         if (!Queue_isEmpty(Queue))
         {
-            lineAddress = &(Queue->QueueArr[Queue->front][0U]);
+            recordAddress = &(Queue->QueueArr[Queue->tail & QUEUE_INDEX_MASK]);
         }
         else
         {
@@ -231,8 +318,60 @@ void* Queue_peekQueue(CircularQueue_t *const Queue)
         /* Do Nothing */
     }
 
-    return lineAddress;
+    return recordAddress;
+}
+
+
+/*
+ * @brief: Find room for the data field of the next record
+ */
+static uint16_t Queue_findDataRoom(const CircularQueue_t *const Queue,
+                                   const uint8_t head, const uint8_t tail)
+{
+    uint16_t offset    = QUEUE_DATA_SIZE;
+    uint16_t dataBegin = 0U;
+    uint16_t lastBegin = 0U;
+
+    if (head == tail)
+    {
+        /* The whole buffer is free, keep going forward unless the end is too close */
+        offset = ((QUEUE_DATA_SIZE - Queue->dataEnd) >= SREC_MAX_DATA_LENGTH) ? Queue->dataEnd : 0U;
+    }
+    else
+    {
+        dataBegin = (uint16_t)(Queue->QueueArr[tail & QUEUE_INDEX_MASK].data - Queue->DataArr);
+        lastBegin = (uint16_t)(Queue->QueueArr[(uint8_t)(head - 1U) & QUEUE_INDEX_MASK].data - Queue->DataArr);
+
+        if (lastBegin >= dataBegin)
+        {
+            /* Used bytes are [dataBegin, dataEnd): free room at the end, then at the beginning */
+            if ((QUEUE_DATA_SIZE - Queue->dataEnd) >= SREC_MAX_DATA_LENGTH)
+            {
+                offset = Queue->dataEnd;
+            }
+            else if (dataBegin >= SREC_MAX_DATA_LENGTH)
+            {
+                offset = 0U;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else if ((uint16_t)(dataBegin - Queue->dataEnd) >= SREC_MAX_DATA_LENGTH)
+        {
+            /* Used bytes have wrapped around: the only free room is [dataEnd, dataBegin) */
+            offset = Queue->dataEnd;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return offset;
 }
+
 /*******************************************************************************
  * EOF
  ******************************************************************************/
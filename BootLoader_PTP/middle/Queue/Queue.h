@@ -16,24 +16,52 @@
 #include <stdio.h>
 #include "MKE16Z4.h"
 #include "dri_def.h"
+#include "Srec.h"
 
 /*******************************************************************************
  * Defines
  ******************************************************************************/
-#define QUEUE_MAX_SIZE         4U
-#define LINE_MAX_CHAR          100U
+/* Both sizes can be set at build time and must be powers of two */
+#ifndef QUEUE_MAX_SIZE
+#define QUEUE_MAX_SIZE         8U       /* Maximum number of records in the queue */
+#endif
+#ifndef QUEUE_DATA_SIZE
+#define QUEUE_DATA_SIZE        1024U    /* Bytes shared by the data fields of the records */
+#endif
+
+#define QUEUE_INDEX_MASK       (QUEUE_MAX_SIZE - 1U)  /* Wraps a record index around the queue */
+
+#if ((QUEUE_MAX_SIZE & QUEUE_INDEX_MASK) != 0U) || ((QUEUE_DATA_SIZE & (QUEUE_DATA_SIZE - 1U)) != 0U)
+#error "QUEUE_MAX_SIZE and QUEUE_DATA_SIZE must be powers of two"
+#endif
+
+#if (QUEUE_MAX_SIZE > 128U)
+#error "QUEUE_MAX_SIZE must fit the free-running 8-bit head and tail indices"
+#endif
+
+#if (QUEUE_DATA_SIZE < (2U * SREC_MAX_DATA_LENGTH))
+#error "QUEUE_DATA_SIZE must hold at least two records of SREC_MAX_DATA_LENGTH bytes"
+#endif
 
 /*******************************************************************************
  * Typedef structs
  ******************************************************************************/
 
+/*
+ * @brief: Single-producer/single-consumer circular queue of decoded records.
+ *         The producer (receive ISR) only writes head and dataEnd, the consumer (main loop)
+ *         only writes tail, so neither side ever has to mask the interrupts of the other.
+ *         head and tail are free-running: the number of records is head - tail.
+ *         The data field of each record is stored in DataArr, right behind the data of the
+ *         previous record, so that short records take no more room than they need
+ */
 typedef struct
 {
-    int8_t  front;
-    int8_t  rear;
-    int8_t  size;
-    uint8_t capacity;
-    uint8_t QueueArr[QUEUE_MAX_SIZE][LINE_MAX_CHAR];
+    volatile uint8_t head;                   /* Number of records enqueued, written by the producer */
+    volatile uint8_t tail;                   /* Number of records dequeued, written by the consumer */
+    uint16_t         dataEnd;                /* Offset just past the data of the last record */
+    Srec_Record_t    QueueArr[QUEUE_MAX_SIZE];
+    uint8_t          DataArr[QUEUE_DATA_SIZE];
 } CircularQueue_t;
 
 /*******************************************************************************
@@ -84,25 +112,59 @@ uint8_t Queue_isFull(const CircularQueue_t *const Queue);
 uint8_t Queue_isEmpty(const CircularQueue_t *const Queue);
 
 
+/*
+ * @name:      Queue_getCount
+ * ----------------------------
+ * @brief:     Get the number of records in the circular queue
+ * @param[in]  Queue: Pointer to the circular queue structure
+ * @return:    Number of records
+ * @note:      None
+ */
+uint8_t Queue_getCount(const CircularQueue_t *const Queue);
+
+
+/*
+ * @name:      Queue_getFreeBytes
+ * ----------------------------
+ * @brief:     Get the number of bytes of DataArr not used by the records of the queue
+ * @param[in]  Queue: Pointer to the circular queue structure
+ * @return:    Number of free bytes, whether they are contiguous or not
+ * @note:      None
+ */
+uint16_t Queue_getFreeBytes(const CircularQueue_t *const Queue);
+
+
+/*
+ * @name:      Queue_getRearSlot
+ * ----------------------------
+ * @brief:     Get the free slot behind the rear of the queue, so that a record can be
+ *             decoded into it in place before being enqueued
+ * @param[in]  Queue: Pointer to the circular queue structure
+ * @return:    Pointer to the free slot. Returns NULL if the queue is full
+ * @note:      Producer side. The data field of the slot has room for SREC_MAX_DATA_LENGTH
+ *             bytes, and stays at the same place until the slot is enqueued
+ */
+Srec_Record_t* Queue_getRearSlot(CircularQueue_t *const Queue);
+
+
 /*
  * @name:      Queue_enQueue
  * ----------------------------
- * @brief:     Enqueue a byte into the circular queue
+ * @brief:     Enqueue the record held in the slot returned by Queue_getRearSlot
  * @param[out] Queue: Pointer to the circular queue structure
- * @param[in]: byteData: The byte of data to be added to the queue
- * @return:    None
- * @note:      None
+ * @return:    0 if the record is enqueued, 1 if the queue is full
+ * @note:      Producer side
  */
-int8_t Queue_enQueue(CircularQueue_t *const Queue, const uint8_t byteData);
+int8_t Queue_enQueue(CircularQueue_t *const Queue);
 
 
 /*
  * @name:      Queue_deQueue
  * ----------------------------
- * @brief:     Dequeue a line from the circular queue
+ * @brief:     Dequeue a record from the circular queue
  * @param[out] Queue: Pointer to the circular queue structure
- * @return:    Pointer to the address of the dequeued line. Returns NULL if the queue is empty
- * @note:      None
+ * @return:    Pointer to the address of the dequeued record. Returns NULL if the queue is empty
+ * @note:      Consumer side. The record must no longer be used, its slot goes back to the producer
  */
 void* Queue_deQueue(CircularQueue_t *const Queue);
 
@@ -12,112 +12,212 @@
 #include "Srec.h"
 
 /*******************************************************************************
- * Variables
+ * Constants
  ******************************************************************************/
-static uint8_t S_record_Termination = FALSE; /* Indicates the encounter of an EOF (End of File)
-                                             record (Start Address (Termination))*/
+
+/* Number of address bytes carried by each record type (S0..S9), 0U marks an unsupported type */
+static const uint8_t s_addressLength[10U] =
+{
+    2U, 2U, 3U, 4U, 0U, 2U, 3U, 4U, 3U, 2U
+};
+
+/* Value of every character as a hexadecimal digit ('0'..'9', 'A'..'F').
+ * Any other character maps to SREC_HEX_INVALID, so the validity of several digits
+ * can be checked at once by OR-ing their values together */
+const uint8_t g_srecHexTable[256U] =
+{
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x00 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x10 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x20 */
+    0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x30 */
+    0x10U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x40 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x50 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x60 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x70 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x80 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0x90 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0xA0 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0xB0 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0xC0 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0xD0 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U,  /* 0xE0 */
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U  /* 0xF0 */
+};
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
+
 /*
- * @name:  SREC_checkSyntax
+ * @name:  SREC_DecoderInit
  * ----------------------------
- * @brief: Check the syntax of an SREC record line.
- *         This function verifies if the provided SREC record line contains valid characters.
- *         It checks whether each character in the line is either a digit ('0' to '9') or a hexadecimal digit ('A' to 'F').
+ * @brief: Reset the decoder so that it waits for the start of a new record
  */
-Srec_Status_t SREC_checkSyntax(const uint8_t *const srecLine)
+void SREC_DecoderInit(Srec_Decoder_t *const decoder)
 {
-    Srec_Status_t status = SREC_OK;
-    uint8_t       index  = 1U;
-    uint8_t       length = 0U;
-
-    if (srecLine != NULL)
+    if (NULL != decoder)
     {
-        length = SREC_lengthLineSrec(srecLine) - 2U;
-
-        for(index = 1U; index < length; ++index)
-        {
-            if (!(((srecLine[index] >= '0') && (srecLine[index] <= '9'))
-                    || ((srecLine[index] >= 'A') && (srecLine[index] <= 'F'))))
-                    {
-                        index  = length; /*Break out the loop*/
-                        status = SREC_ERROR;
-                    }
-                    else
-                    {
-                        /* Do Nothing */
-                    }
-        }
+        decoder->state         = SREC_DECODE_START;
+        decoder->high          = 0U;
+        decoder->sum           = 0U;
+        decoder->byteCount     = 0U;
+        decoder->addressLength = 0U;
+        decoder->numBytes      = 0U;
     }
     else
     {
-        status = SREC_ERROR;
+        /* Do Nothing */
     }
-
-    return status;
 }
 
 
 /*
- * @name:  SREC_Checksum
+ * @name:  SREC_DecoderIsIdle
  * ----------------------------
- * @brief: Calculate and verify the checksum of an SREC record
+ * @brief: Check if the decoder is between two records
  */
-Srec_Status_t SREC_Checksum(const uint8_t *const srecLine)
+uint8_t SREC_DecoderIsIdle(const Srec_Decoder_t *const decoder)
 {
-    Srec_Status_t status   = SREC_OK;
-    uint8_t       sum      = 0U;
-    uint8_t       index    = 0U;
-    uint8_t       checkSum = 0U;
-    uint8_t       length   = 0U;
-    uint8_t       tmp      = 0U;
-
-    if (NULL != srecLine)
-    {
-        length = SREC_lengthLineSrec(srecLine);
-        tmp    = (length - 6U) / 2U;
-
-        for (index = 1U; index <= tmp; ++index)
-        {
-            sum += SREC_convertStrToDec(&srecLine[(2U * index)]);
-        }
-
-        checkSum = SREC_convertStrToDec(&srecLine[(length - 4U)]);
-
-        ((uint8_t)(~sum) == checkSum) ? (status = SREC_OK) : (status = SREC_ERROR);
-    }
-    else
-    {
-        status = SREC_ERROR;
-    }
-
-    return status;
+    return (SREC_DECODE_START == decoder->state) ? TRUE : FALSE;
 }
 
 
 /*
- * @name:  SREC_CheckByteCount
+ * @name:  SREC_DecodeChar
  * ----------------------------
- * @brief: Check the byteCount field of an SREC record
+ * @brief: Feed one received character into the SREC decoder
  */
-Srec_Status_t SREC_CheckByteCount(const uint8_t *const srecLine)
+Srec_Status_t SREC_DecodeChar(Srec_Decoder_t *const decoder, const uint8_t character,
+                              Srec_Record_t *const record)
 {
-    Srec_Status_t status       = SREC_ERROR;
-    uint8_t       byteCount    = 0U;
-    uint8_t       byteCountCal = 0U;
+    Srec_Status_t status    = SREC_PENDING;
+    uint8_t       nibble    = 0U;
+    uint8_t       byteValue = 0U;
+
+    switch (decoder->state)
+    {
+        case SREC_DECODE_START:
+            if ('S' == character)
+            {
+                decoder->state = SREC_DECODE_TYPE;
+            }
+            else if (('\r' != character) && ('\n' != character))
+            {
+                status = SREC_ERROR_START;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        case SREC_DECODE_TYPE:
+            if ((character >= '0') && (character <= '9') && (0U != s_addressLength[character - '0']))
+            {
+                record->type           = character - '0';
+                record->address        = 0U;
+                record->length         = 0U;
+                decoder->addressLength = s_addressLength[record->type];
+                decoder->sum           = 0U;
+                decoder->numBytes      = 0U;
+                decoder->state         = SREC_DECODE_HIGH;
+            }
+            else
+            {
+                status = SREC_ERROR_TYPE;
+            }
+            break;
+
+        case SREC_DECODE_HIGH:
+            nibble = g_srecHexTable[character];
+            if (0U == (nibble & SREC_HEX_INVALID))
+            {
+                decoder->high  = nibble;
+                decoder->state = SREC_DECODE_LOW;
+            }
+            else if (('\r' == character) || ('\n' == character))
+            {
+                status = SREC_ERROR_BYTE_COUNT; /* The line ended before its checksum */
+            }
+            else
+            {
+                status = SREC_ERROR_SYNTAX;
+            }
+            break;
+
+        case SREC_DECODE_LOW:
+            nibble = g_srecHexTable[character];
+            if (0U == (nibble & SREC_HEX_INVALID))
+            {
+                byteValue     = (uint8_t)((decoder->high << 4U) | nibble);
+                decoder->sum += byteValue;
+
+                if (0U == decoder->numBytes)
+                {
+                    decoder->byteCount = byteValue;
+                    if ((byteValue <= decoder->addressLength)
+                            || ((byteValue - decoder->addressLength - 1U) > SREC_MAX_DATA_LENGTH))
+                    {
+                        status = SREC_ERROR_BYTE_COUNT;
+                    }
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+                }
+                else if (decoder->numBytes <= decoder->addressLength)
+                {
+                    record->address = (record->address << 8U) | byteValue;
+                }
+                else if (decoder->numBytes < decoder->byteCount)
+                {
+                    record->data[record->length++] = byteValue;
+                }
+                else
+                {
+                    /* The checksum byte has landed: the checksum is the one's complement of the
+                     * sum of all other bytes, so the sum of every byte of a valid record is 0xFF */
+                    status = (0xFFU == decoder->sum) ? SREC_OK : SREC_ERROR_CHECKSUM;
+                }
+
+                decoder->numBytes++;
+                decoder->state = SREC_DECODE_HIGH;
+            }
+            else
+            {
+                status = SREC_ERROR_SYNTAX;
+            }
+            break;
+
+        case SREC_DECODE_SKIP:
+            if ('\n' == character)
+            {
+                decoder->state = SREC_DECODE_START;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+            break;
+
+        default:
+            decoder->state = SREC_DECODE_START;
+            break;
+    }
 
-    if (NULL != srecLine)
+    if (SREC_OK == status)
     {
-        byteCount    = SREC_convertStrToDec(&srecLine[2U]) * 2U;
-        byteCountCal = SREC_lengthLineSrec(srecLine) - 6U;
-        (byteCount == byteCountCal) ? (status = SREC_OK) : (status = SREC_ERROR);
+        decoder->state = SREC_DECODE_START;
+    }
+    else if (SREC_PENDING != status)
+    {
+        /* Drop the rest of the bad line, unless the bad character has already ended it */
+        decoder->state = ('\n' == character) ? SREC_DECODE_START : SREC_DECODE_SKIP;
     }
     else
     {
-        status = SREC_ERROR;
+        /* Do Nothing */
     }
 
     return status;
@@ -125,121 +225,142 @@ Srec_Status_t SREC_CheckByteCount(const uint8_t *const srecLine)
 
 
 /*
- * @name: SREC_CheckRecordStart
+ * @name:  SREC_IsTermination
  * ----------------------------
- * @brief: Check the start field of an SREC record
+ * @brief: Check if a record is a Start Address (Termination) record (S7, S8 or S9)
  */
-Srec_Status_t SREC_CheckRecordStart(const uint8_t *const srecLine)
+uint8_t SREC_IsTermination(const Srec_Record_t *const record)
 {
-    Srec_Status_t status = SREC_ERROR;
-
-    if (NULL != srecLine)
-    {
-        (srecLine[0U] == 'S') ? (status = SREC_OK) : (status = SREC_ERROR);
-    }
-    else
-    {
-        status = SREC_ERROR;
-    }
-
-    return status;
+    return ((record->type >= 7U) && (record->type <= 9U)) ? TRUE : FALSE;
 }
 
 
 /*
- * @name:  SREC_CheckRecordStart
+ * @name:  SREC_DecodeChars
  * ----------------------------
- * @brief: Check the recordType field of an SREC record
+ * @brief: Feed a burst of received characters into the SREC decoder
  */
-Srec_Status_t SREC_CheckRecordType(const uint8_t *const srecLine)
+Srec_Status_t SREC_DecodeChars(Srec_Decoder_t *const decoder, const uint8_t *const chars,
+                               const uint16_t count, uint16_t *const consumed,
+                               Srec_Record_t *const record)
 {
-    Srec_Status_t status = SREC_ERROR;
-
-    if (NULL != srecLine)
+    Srec_Status_t status    = SREC_PENDING;
+    uint16_t      index     = 0U;
+    uint16_t      run       = 0U;
+    uint8_t       sum       = 0U;
+    uint8_t       hexError  = FALSE;
+    uint8_t       useKernel = TRUE;
+
+    while ((index < count) && (SREC_PENDING == status))
     {
-        switch (srecLine[1U])
+        hexError = TRUE;
+
+        /* Inside the data field, decode every complete pair of the burst with the kernel */
+        if ((TRUE == useKernel)
+                && (SREC_DECODE_HIGH == decoder->state)
+                && (decoder->numBytes > decoder->addressLength)
+                && (decoder->numBytes < decoder->byteCount)
+                && ((uint16_t)(count - index) >= 4U))
         {
-            case '0':  /* Header */
-            case '1':  /* Data */
-            case '2':  /* Data */
-            case '3':  /* Data */
-            case '5':  /* Count */
-            case '6':  /* Count */
-                status = SREC_OK;
-                break;
-            case '7':  /* Start Address (Termination) */
-            case '8':  /* Start Address (Termination) */
-            case '9':  /* Start Address (Termination) */
-                S_record_Termination = TRUE; /* Inform met record EOF (Start Address (Termination)) */
-                status = SREC_OK;
-                break;
-
-            default:
-                status = SREC_ERROR;
-                break;
+            run = decoder->byteCount - decoder->numBytes;
+            if (run > (uint16_t)((count - index) / 2U))
+            {
+                run = (uint16_t)((count - index) / 2U);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+
+            sum = SREC_HexToBytes(&chars[index], &record->data[record->length], run, &hexError);
+            if (FALSE == hexError)
+            {
+                decoder->sum      += sum;
+                decoder->numBytes += run;
+                record->length    += run;
+                index             += 2U * run;
+            }
+            else
+            {
+                /* The bad character lies within the run: the character path walks up to it
+                 * and reports it, without the kernel going over the same characters again */
+                useKernel = FALSE;
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if (TRUE == hexError)
+        {
+            status = SREC_DecodeChar(decoder, chars[index], record);
+            index++;
+        }
+        else
+        {
+            /* Do Nothing */
         }
     }
-    else
-    {
-        status = SREC_ERROR;
-    }
+
+    *consumed = index;
 
     return status;
 }
 
 
 /*
- * @brief: Check if an Termination record exists.
- * @return: 1 if an Termination record exists, otherwise 0.
- */
-uint8_t SREC_TerminationIsExist(void)
-{
-    return S_record_Termination;
-}
-
-/*
- * @name:  SREC_convertStrToDec
+ * @name:  SREC_HexToBytes
  * ----------------------------
- * @brief: Convert the first two characters of a string to an integer in decimal format
+ * @brief: Convert and validate a string of hexadecimal characters, four characters per step
  */
-int32_t SREC_convertStrToDec(const uint8_t* Str)
+uint8_t SREC_HexToBytes(const uint8_t *const str, uint8_t *const bytes,
+                        const uint16_t count, uint8_t *const error)
 {
-    uint8_t index  = 0U;
-    int32_t retVal = 0U;
-
-    if (Str != NULL)
-    {
-        for (index = 0U; index < 2U; ++index)
-        {
-            /* Convert the character-form numbers to corresponding integer-form numbers */
-            retVal += ((Str[index] >= 'A') ? (Str[index] - 'A' + 10U) : (Str[index] - '0')) << (4U * (1U - index));
-        }
-    }
-    else
+    const uint8_t *p_char = str;
+    uint16_t      index   = 0U;
+    uint8_t       flags   = 0U;
+    uint8_t       sum     = 0U;
+    uint8_t       n0      = 0U;
+    uint8_t       n1      = 0U;
+    uint8_t       n2      = 0U;
+    uint8_t       n3      = 0U;
+
+    /* Two bytes per step: the four table lookups are independent, and the validity of
+     * all four digits is folded into a single flag which is checked once at the end */
+    for (index = 0U; (index + 2U) <= count; index += 2U)
     {
-        retVal = -1; /* Return an error status if the string to be converted is invalid */
-    }
+        n0 = g_srecHexTable[p_char[0U]];
+        n1 = g_srecHexTable[p_char[1U]];
+        n2 = g_srecHexTable[p_char[2U]];
+        n3 = g_srecHexTable[p_char[3U]];
 
-    return retVal;
-}
+        flags |= (uint8_t)(n0 | n1 | n2 | n3);
 
+        bytes[index]      = (uint8_t)((n0 << 4U) | n1);
+        bytes[index + 1U] = (uint8_t)((n2 << 4U) | n3);
+        sum              += (uint8_t)(bytes[index] + bytes[index + 1U]);
+        p_char           += 4U;
+    }
 
-/*
- * @name:  SREC_lengthLineSrec
- * ----------------------------
- * @brief: Calculate the length of a line in SREC format
- */
-size_t SREC_lengthLineSrec(const uint8_t *str)
-{
-    size_t length = 0U;
+    /* Odd number of bytes: convert the last one */
+    if (index < count)
+    {
+        n0 = g_srecHexTable[p_char[0U]];
+        n1 = g_srecHexTable[p_char[1U]];
 
-    while (*str != '\n')
+        flags       |= (uint8_t)(n0 | n1);
+        bytes[index] = (uint8_t)((n0 << 4U) | n1);
+        sum         += bytes[index];
+    }
+    else
     {
-        length++;
-        str++;
+        /* Do Nothing */
     }
 
-    return (++length);
+    *error = (0U != (flags & SREC_HEX_INVALID)) ? TRUE : FALSE;
+
+    return sum;
 }
 
 /*******************************************************************************
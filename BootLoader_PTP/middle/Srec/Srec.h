@@ -13,9 +13,14 @@
  * Includes
  ******************************************************************************/
 #include <stdint.h>
-#include <math.h>
 #include <string.h>
-#include "Queue.h"
+#include "dri_def.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define SREC_MAX_DATA_LENGTH   252U  /* Maximum number of data bytes in one record (S1, byteCount 0xFF) */
+#define SREC_HEX_INVALID       0x10U /* Flag bit set in g_srecHexTable for a non-hexadecimal character */
 
 /*******************************************************************************
  * Typedef enums
@@ -28,94 +33,157 @@ typedef enum
 {
     SREC_ERROR = 0U,
     SREC_OK,
+    SREC_ERROR_START,         /* The record does not begin with 'S' */
+    SREC_ERROR_TYPE,          /* Unknown record type */
+    SREC_ERROR_SYNTAX,        /* A character in the record is not a hexadecimal digit */
+    SREC_ERROR_BYTE_COUNT,    /* The byteCount field does not match the record length or its address field */
+    SREC_ERROR_CHECKSUM,      /* The checksum field does not match the content of the record */
+    SREC_ERROR_COUNT,         /* The S5/S6 record count does not match the number of data records */
+    SREC_ERROR_LINE,          /* Characters of the record were lost or corrupted on the line */
+    SREC_PENDING,             /* The record is still being received */
+    SREC_CONSUMED,            /* The record was valid and kept by the decoder, nothing is handed over */
 } Srec_Status_t;
 
+
+/*
+ * @brief: States of the byte-at-a-time SREC decoder
+ */
+typedef enum
+{
+    SREC_DECODE_START = 0U,   /* Waiting for the 'S' of the next record */
+    SREC_DECODE_TYPE,         /* Waiting for the record type digit */
+    SREC_DECODE_HIGH,         /* Waiting for the high nibble of a byte */
+    SREC_DECODE_LOW,          /* Waiting for the low nibble of a byte */
+    SREC_DECODE_SKIP,         /* Dropping the rest of a bad line until its newline */
+} Srec_Decode_State_t;
+
 /*******************************************************************************
- * APIs
+ * Typedef structs
  ******************************************************************************/
 
 /*
- * @name:  SREC_checkSyntax
- * ----------------------------
- * @brief: Check the syntax of an SREC record line.
- *         This function verifies if the provided SREC record line contains valid characters.
- *         It checks whether each character in the line is either a digit ('0' to '9') or a hexadecimal digit ('A' to 'F').
- * @param[in] srecLine: Pointer to the SREC record line to be checked.
- * @return: SREC_OK if the syntax is correct, otherwise SREC_ERROR.
+ * @brief: Binary form of an SREC record, decoded once from its ASCII characters
  */
-Srec_Status_t SREC_checkSyntax(const uint8_t *const srecLine);
+typedef struct
+{
+    Srec_Status_t status;                   /* Result of decoding the record */
+    uint8_t       type;                     /* Record type (0..9) */
+    uint8_t       length;                   /* Number of valid bytes in data */
+    uint32_t      address;                  /* Address field of the record */
+    uint8_t       *data;                    /* Data field of the record, stored outside of the record */
+} Srec_Record_t;
 
 
 /*
- * @name:      SREC_Checksum
- * ----------------------------
- * @brief:     Calculate and verify the checksum of an SREC record
- * @param[in]: srecLine: Pointer to the SREC record whose checksum needs to be verified
- * @return:    SREC_OK if the checksum is valid, SREC_ERROR otherwise
- * @note:      None
+ * @brief: Context of the byte-at-a-time SREC decoder
  */
-Srec_Status_t SREC_Checksum(const uint8_t *const srecLine);
+typedef struct
+{
+    Srec_Decode_State_t state;
+    uint8_t             high;           /* High nibble of the byte being received */
+    uint8_t             sum;            /* Running sum of the bytes received so far */
+    uint8_t             byteCount;      /* byteCount field of the record being received */
+    uint8_t             addressLength;  /* Number of address bytes of the record type */
+    uint16_t            numBytes;       /* Number of bytes received so far, byteCount included */
+} Srec_Decoder_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
 
+/* Value of every character as a hexadecimal digit, SREC_HEX_INVALID for any other character */
+extern const uint8_t g_srecHexTable[256U];
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
 
 /*
- * @name:      SREC_CheckByteCount
+ * @name:       SREC_DecoderInit
  * ----------------------------
- * @brief:     Check the byteCount field of an SREC record
- * @param[in]: srecLine: Pointer to the SREC record whose checksum needs to be verified
- * @return:    SREC_OK if the byteCount is valid, SREC_ERROR otherwise
- * @note:      None
+ * @brief:      Reset the decoder so that it waits for the start of a new record
+ * @param[out]: decoder: Pointer to the decoder context
+ * @return:     None
  */
-Srec_Status_t SREC_CheckByteCount(const uint8_t *const srecLine);
+void SREC_DecoderInit(Srec_Decoder_t *const decoder);
 
 
 /*
- * @name:      SREC_CheckRecordStart
+ * @name:       SREC_DecoderIsIdle
  * ----------------------------
- * @brief:     Check the start field of an SREC record
- * @param[in]: srecLine: Pointer to the SREC record whose checksum needs to be verified
- * @return:    SREC_OK if the start field is valid, SREC_ERROR otherwise
- * @note:      None
+ * @brief:      Check if the decoder is between two records
+ * @param[in]:  decoder: Pointer to the decoder context
+ * @return:     TRUE if no record is being received, FALSE otherwise
  */
-Srec_Status_t SREC_CheckRecordStart(const uint8_t *const srecLine);
+uint8_t SREC_DecoderIsIdle(const Srec_Decoder_t *const decoder);
 
 
 /*
- * @name:      SREC_CheckRecordType
+ * @name:       SREC_DecodeChar
  * ----------------------------
- * @brief:     Check the recordType field of an SREC record
- * @param[in]: srecLine: Pointer to the SREC record whose checksum needs to be verified
- * @return:    SREC_OK if the record type is valid, SREC_ERROR otherwise
- * @note:      None
+ * @brief:      Feed one received character into the SREC decoder.
+ *              Nibbles are folded into bytes and the checksum is accumulated as the
+ *              characters arrive, and the address and data bytes are written straight
+ *              into the binary record. Start field, record type, hexadecimal syntax,
+ *              byteCount and checksum are all checked on the way.
+ * @param[out]: decoder: Pointer to the decoder context
+ * @param[in]:  character: The received character
+ * @param[out]: record: The record being filled in
+ * @return:     SREC_PENDING while the record is incomplete,
+ *              SREC_OK as soon as the checksum byte of a valid record is received,
+ *              otherwise the status code of the failed check
+ * @note:       Newlines between records are ignored. After an error, the rest of the
+ *              line is dropped and decoding resumes with the next record
  */
-Srec_Status_t SREC_CheckRecordType(const uint8_t *const srecLine);
+Srec_Status_t SREC_DecodeChar(Srec_Decoder_t *const decoder, const uint8_t character,
+                              Srec_Record_t *const record);
 
 
 /*
- * @brief: Check if an Termination record exists.
- * @return: 1 if an Termination record exists, otherwise 0.
+ * @name:      SREC_IsTermination
+ * ----------------------------
+ * @brief:     Check if a record is a Start Address (Termination) record (S7, S8 or S9)
+ * @param[in]  record: Pointer to the decoded record
+ * @return:    TRUE if the record is a Termination record, otherwise FALSE
  */
-uint8_t SREC_TerminationIsExist(void);
+uint8_t SREC_IsTermination(const Srec_Record_t *const record);
 
 
 /*
- * @name:      SREC_lengthLineSrec
+ * @name:       SREC_DecodeChars
  * ----------------------------
- * @brief:     Calculate the length of a line in SREC format
- * @param[in]  str: Pointer to the line in SREC format whose length needs to be calculated
- * @return:    The length of the line (number of characters), excluding the newline character
- * @note:      None
+ * @brief:      Feed a burst of received characters into the SREC decoder.
+ *              Runs of data characters are converted by SREC_HexToBytes, every other
+ *              character goes through SREC_DecodeChar. A run holding a bad character is
+ *              walked again by SREC_DecodeChar only, so each character is converted at most twice
+ * @param[out]: decoder: Pointer to the decoder context
+ * @param[in]:  chars: Pointer to the received characters
+ * @param[in]:  count: Number of received characters
+ * @param[out]: consumed: Number of characters used before returning
+ * @param[out]: record: The record being filled in
+ * @return:     Same as SREC_DecodeChar.
+ * @note:       Decoding stops right after a record is completed or rejected, so that the
+ *              caller can hand the record over and feed the remaining characters again
  */
-size_t SREC_lengthLineSrec(const uint8_t *str);
+Srec_Status_t SREC_DecodeChars(Srec_Decoder_t *const decoder, const uint8_t *const chars,
+                               const uint16_t count, uint16_t *const consumed,
+                               Srec_Record_t *const record);
+
 
 /*
- * @name:      SREC_convertStrToDec
+ * @name:       SREC_HexToBytes
  * ----------------------------
- * @brief:     Convert the first two characters of a string to an integer in decimal format
- * @param[in]  Str: Pointer to the string containing the characters to be converted
- * @return:    The converted integer value if successful, -1 if the input string is invalid
- * @note:      None
+ * @brief:      Convert and validate a string of hexadecimal characters ('0'..'9', 'A'..'F'),
+ *              four characters per step through a lookup table
+ * @param[in]:  str: Pointer to the characters to be converted (2 * count characters)
+ * @param[out]: bytes: Pointer to the buffer receiving the converted bytes
+ * @param[in]:  count: Number of bytes to be converted
+ * @param[out]: error: TRUE if any of the characters is not a hexadecimal digit, FALSE otherwise
+ * @return:     The 8-bit sum of the converted bytes
+ * @note:       The content of bytes is only meaningful when error is FALSE
  */
-int32_t SREC_convertStrToDec(const uint8_t* Str);
+uint8_t SREC_HexToBytes(const uint8_t *const str, uint8_t *const bytes,
+                        const uint16_t count, uint8_t *const error);
 
 #endif /* _INC_SREC_H_ */
 /*******************************************************************************
@@ -12,17 +12,89 @@
 #include "middle.h"
 
 /*******************************************************************************
- * Variables
+ * Typedef structs
  ******************************************************************************/
-static CircularQueue_t g_srecQueue;
+
+typedef struct MID_Port MID_Port_t;
+
+/*
+ * @brief: Decoder of one of the accepted file formats
+ */
+typedef struct
+{
+    Srec_Status_t (*decodeChar)(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+    uint8_t       (*isIdle)(const MID_Port_t *const p_Port);
+} MID_Format_t;
+
+
+/*
+ * @brief: Decoding context of one port, every port decodes on its own until one is locked
+ */
+struct MID_Port
+{
+    const MID_Format_t *format;         /* Format of the image being received */
+    Srec_Decoder_t     srecDecoder;
+    Ihex_Decoder_t     ihexDecoder;
+    Bin_Decoder_t      binDecoder;
+    uint32_t           commandValue;    /* Value of the command being received */
+    uint8_t            commandDigits;   /* Number of digits of the command received so far */
+    uint8_t            skipRecord;      /* TRUE while the rest of a record broken on the line is dropped */
+    uint8_t            nakPending;      /* TRUE until it is known whether a record was dropped */
+    uint32_t           recordIndex;     /* Lines of the image received so far, the index of the next one */
+};
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
+static Srec_Status_t MID_detectDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+static uint8_t       MID_detectIsIdle(const MID_Port_t *const p_Port);
+static Srec_Status_t MID_srecDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+static uint8_t       MID_srecIsIdle(const MID_Port_t *const p_Port);
+static Srec_Status_t MID_ihexDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+static uint8_t       MID_ihexIsIdle(const MID_Port_t *const p_Port);
+static Srec_Status_t MID_binDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+static uint8_t       MID_binIsIdle(const MID_Port_t *const p_Port);
+static Srec_Status_t MID_commandDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record);
+static uint8_t       MID_commandIsIdle(const MID_Port_t *const p_Port);
+static int8_t        MID_handOver(MID_Port_t *const p_Port, Srec_Record_t *const p_Record, const Srec_Status_t status);
+static void          MID_resetPort(MID_Port_t *const p_Port);
+static void          MID_resyncPort(MID_Port_t *const p_Port);
+static int8_t        MID_lockPort(const uint8_t port, const Srec_Record_t *const p_Record);
+static void          MID_countRecord(MID_Port_t *const p_Port, const Srec_Status_t status, const uint8_t type);
+static void          MID_sendNak(const MID_Port_t *const p_Port);
+static void          MID_changeBaudrate(const uint32_t baudrate);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
 
-static uint32_t calculateAddress(const uint8_t *const p_LineSrec);
-static void tempBuff(uint8_t *p_inBuff, uint8_t *p_outBuff);
+/* Format in use until the first record tells which one the image is written in */
+static const MID_Format_t s_detectFormat = { MID_detectDecodeChar, MID_detectIsIdle };
+/* Motorola SREC, records begin with 'S' */
+static const MID_Format_t s_srecFormat   = { MID_srecDecodeChar, MID_srecIsIdle };
+/* Intel HEX, records begin with ':' */
+static const MID_Format_t s_ihexFormat   = { MID_ihexDecodeChar, MID_ihexIsIdle };
+/* Raw binary image, begins with BIN_MAGIC */
+static const MID_Format_t s_binFormat    = { MID_binDecodeChar, MID_binIsIdle };
+/* Command sent ahead of the image, begins with MID_BAUDRATE_COMMAND */
+static const MID_Format_t s_commandFormat = { MID_commandDecodeChar, MID_commandIsIdle };
 
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static CircularQueue_t    g_srecQueue;
+static Planner_t          g_planner;                           /* Writes of the image into the application space */
+static MID_Port_t         g_ports[HAL_PORT_COUNT];             /* Decoding context of every port */
+static Srec_Record_t      g_lockRecord[HAL_PORT_COUNT];        /* Record of each port until one is locked */
+static uint8_t            g_lockData[HAL_PORT_COUNT][SREC_MAX_DATA_LENGTH];
+static uint32_t           g_dataRecordCount;                   /* Number of data records programmed */
+static uint32_t           g_entryPoint;                        /* Start address of the S7/S8/S9 record */
+static uint8_t            g_imageHeader[MID_IMAGE_HEADER_MAX_LENGTH];  /* Content of the S0 record */
+static uint8_t            g_imageHeaderLength;
+static MID_Profile_t      g_profile;                           /* Counters of the record path */
+static volatile uint8_t   g_flowPaused;                        /* TRUE once XOFF has been sent */
+static volatile uint8_t   g_baudSwitching;                     /* TRUE while waiting for the sync at a new baud rate */
+static volatile uint8_t   g_baudConfirmed;                     /* TRUE once the sync has been received at the new rate */
 
 /*
  * @name:  MID_Init
@@ -31,9 +103,32 @@ static void tempBuff(uint8_t *p_inBuff, uint8_t *p_outBuff);
  */
 void MID_Init(void)
 {
+    uint8_t port = 0U;
+
     Queue_Init(&g_srecQueue);          /* Initialize the circular queue */
-    HAL_Init();                        /* Initialize the LPUART layer */
+    for (port = 0U; port < HAL_PORT_COUNT; ++port)
+    {
+        MID_resetPort(&g_ports[port]);  /* Wait for the first record */
+        g_lockRecord[port].data = g_lockData[port];
+    }
+    (void)PLANNER_Init(&g_planner, 0U, 0U);  /* Refuse every write until the application space is known */
+    g_dataRecordCount   = 0U;
+    g_entryPoint        = 0U;
+    g_imageHeaderLength = 0U;
+    (void)memset(&g_profile, 0, sizeof(g_profile));
+    g_flowPaused        = FALSE;
+    g_baudSwitching     = FALSE;
+#if (1U == MID_PROFILE)
+    /* Free-running SysTick on the core clock, without interrupt */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL  = 0U;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+    /* The callbacks are set before HAL_Init enables the receive and error interrupts */
     HAL_getFuncAddress(MID_PushData);  /* Pass the address of the function "MID_PushData" down to the HAL layer */
+    HAL_getErrorFuncAddress(MID_ReceiveError);
+    HAL_getBurstFuncAddress(MID_PushBurst);
+    HAL_Init();                        /* Initialize the transport layer */
 }
 
 
@@ -52,11 +147,244 @@ void MID_DeInit(void)
 /*
  * @name:  MID_PushData
  * ------------------------------------
- * @brief: Push data into the circular queue
+ * @brief: Decode a received byte straight into the free slot of the circular queue
+ */
+int8_t MID_PushData(const uint8_t port, const uint8_t data)
+{
+    int8_t        retVal   = 0U;
+    Srec_Status_t status   = SREC_PENDING;
+    MID_Port_t    *p_Port  = &g_ports[port];
+    uint8_t       locked   = HAL_getLockedPort();
+    Srec_Record_t *p_Record = (HAL_PORT_NONE == locked) ? &g_lockRecord[port]
+                                                        : Queue_getRearSlot(&g_srecQueue);
+#if (1U == MID_PROFILE)
+    uint32_t      start    = SysTick->VAL;
+#endif
+
+    /* Records are made of hexadecimal digits and end with a newline, anything else starts the next one */
+    if ((TRUE == p_Port->skipRecord) && (SREC_HEX_INVALID == g_srecHexTable[data])
+            && ('\r' != data) && ('\n' != data))
+    {
+        p_Port->skipRecord = FALSE;
+        p_Port->nakPending = FALSE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if (TRUE == g_baudSwitching)
+    {
+        /* Only the sync tells that both sides run at the new rate, the rest is noise */
+        if (MID_AUTOBAUD_SYNC == data)
+        {
+            g_baudConfirmed = TRUE;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else if ((HAL_PORT_NONE != locked) && (port != locked))
+    {
+        /* The last characters received on another port before the lock */
+    }
+    else if (TRUE == p_Port->skipRecord)
+    {
+        /* Drop the rest of the record the receive error happened in. After an error between
+         * two records, the next one is only known to be broken once its digits come without its start */
+        if ((TRUE == p_Port->nakPending) && ('\r' != data) && ('\n' != data))
+        {
+            p_Port->nakPending = FALSE;
+            MID_sendNak(p_Port);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else if (NULL != p_Record)
+    {
+        status = p_Port->format->decodeChar(p_Port, data, p_Record);
+#if (1U == MID_PROFILE)
+        g_profile.decodeCycles += (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+        g_profile.numBytes++;
+        g_profile.numRecords += ((SREC_PENDING != status) && (SREC_CONSUMED != status)) ? 1U : 0U;
+#endif
+        if (SREC_PENDING == status)
+        {
+            /* Do Nothing */
+        }
+        else if (SREC_CONSUMED == status)
+        {
+            /* An Intel HEX address record, a line of the image all the same */
+            p_Port->recordIndex++;
+        }
+        else if (HAL_PORT_NONE == locked)
+        {
+            if (SREC_OK == status)
+            {
+                /* The first valid record tells which port the host is on */
+                retVal = MID_lockPort(port, p_Record);
+            }
+            else
+            {
+                /* Noise on a port the host is not on, start over */
+                MID_resetPort(p_Port);
+            }
+        }
+        else
+        {
+            retVal = MID_handOver(p_Port, p_Record, status);
+        }
+    }
+    else if ((TRUE == p_Port->format->isIdle(p_Port)) && (('\r' == data) || ('\n' == data)))
+    {
+        /* The newline of the last record needs no room in the queue */
+    }
+    else
+    {
+        retVal = 1U;
+    }
+
+    return retVal;
+}
+
+
+/*
+ * @name:  MID_PushBurst
+ * ------------------------------------
+ * @brief: Decode a burst of received bytes, the SREC records of the locked port a run at a time
+ */
+int8_t MID_PushBurst(const uint8_t port, const uint8_t *const data, const uint32_t count)
+{
+    int8_t        retVal   = 0U;
+    int8_t        pushed   = 0U;
+    uint32_t      index    = 0U;
+    uint16_t      used     = 0U;
+    uint16_t      length   = 0U;
+    Srec_Status_t status   = SREC_PENDING;
+    MID_Port_t    *p_Port  = &g_ports[port];
+    Srec_Record_t *p_Record = NULL;
+#if (1U == MID_PROFILE)
+    uint32_t      start    = 0U;
+#endif
+
+    while (index < count)
+    {
+        p_Record = Queue_getRearSlot(&g_srecQueue);
+        if ((port == HAL_getLockedPort()) && (&s_srecFormat == p_Port->format) && (NULL != p_Record)
+                && (FALSE == p_Port->skipRecord) && (FALSE == g_baudSwitching))
+        {
+#if (1U == MID_PROFILE)
+            start  = SysTick->VAL;
+#endif
+            length = ((count - index) < 0xFFFFU) ? (uint16_t)(count - index) : 0xFFFFU;
+            status = SREC_DecodeChars(&p_Port->srecDecoder, &data[index], length, &used, p_Record);
+            index += used;
+#if (1U == MID_PROFILE)
+            g_profile.decodeCycles += (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+            g_profile.numBytes     += used;
+            g_profile.numRecords   += (SREC_PENDING != status) ? 1U : 0U;
+#endif
+            if (SREC_PENDING != status)
+            {
+                pushed = MID_handOver(p_Port, p_Record, status);
+            }
+            else
+            {
+                pushed = 0U;
+            }
+        }
+        else
+        {
+            /* Before the lock, in another format, or with no room left */
+            pushed = MID_PushData(port, data[index]);
+            index++;
+        }
+
+        if (0U != pushed)
+        {
+            retVal = pushed;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return retVal;
+}
+
+
+/*
+ * @name:  MID_ReceiveError
+ * ------------------------------------
+ * @brief: Give up the record whose characters were lost or dropped on the line
+ */
+int8_t MID_ReceiveError(const uint8_t port)
+{
+    int8_t        retVal   = 0U;
+    MID_Port_t    *p_Port  = &g_ports[port];
+    uint8_t       locked   = HAL_getLockedPort();
+    uint8_t       isBinary = (&s_binFormat == p_Port->format) ? TRUE : FALSE;
+    uint8_t       isIdle   = p_Port->format->isIdle(p_Port);
+    Srec_Record_t *p_Record = NULL;
+
+    if ((TRUE == g_baudSwitching) || ((HAL_PORT_NONE != locked) && (port != locked)))
+    {
+        /* Garbage is expected while both sides change their rate */
+    }
+    else if (HAL_PORT_NONE == locked)
+    {
+        /* Noise on a port the host may not be on, start over */
+        MID_resetPort(p_Port);
+    }
+    else
+    {
+        MID_resyncPort(p_Port);
+        p_Port->skipRecord = TRUE;
+
+        if (TRUE == isBinary)
+        {
+            /* A binary image has no line to resynchronize on: hand a broken record to the main loop */
+            p_Record = Queue_getRearSlot(&g_srecQueue);
+            if (NULL != p_Record)
+            {
+                p_Record->status = SREC_ERROR_LINE;
+                p_Record->type   = 0U;
+                p_Record->length = 0U;
+                retVal = Queue_enQueue(&g_srecQueue);
+            }
+            else
+            {
+                retVal = 1U;
+            }
+        }
+        else if (FALSE == isIdle)
+        {
+            /* The record being received is dropped: tell the host to send it again */
+            MID_sendNak(p_Port);
+        }
+        else
+        {
+            /* Only the newline of the last record may have been lost, or the start of the next one */
+            p_Port->nakPending = TRUE;
+        }
+    }
+
+    return retVal;
+}
+
+
+/*
+ * @name:  MID_getRxErrors
+ * ------------------------------------
+ * @brief: Get the receive error counters of a port
  */
-int8_t MID_PushData(const uint8_t data)
+const HAL_RxErrors_t* MID_getRxErrors(const uint8_t port)
 {
-    return Queue_enQueue(&g_srecQueue, data);
+    return HAL_getRxErrors(port);
 }
 
 
@@ -74,11 +402,24 @@ uint8_t MID_QueueIsEmpty(void)
 /*
  * @name:  MID_deQueue
  * ------------------------------------
- * @brief: Remove a line from the circular queue
+ * @brief: Remove a record from the circular queue
  */
 void MID_deQueue(void)
 {
     (void)Queue_deQueue(&g_srecQueue);
+
+    /* Resume the host once the queue has drained */
+    if ((TRUE == g_flowPaused)
+            && (Queue_getCount(&g_srecQueue) <= MID_XON_RECORDS)
+            && (Queue_getFreeBytes(&g_srecQueue) >= MID_XON_FREE_BYTES))
+    {
+        g_flowPaused = FALSE;
+        HAL_requestFlowControl(FALSE);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
 }
 
 
@@ -87,9 +428,9 @@ void MID_deQueue(void)
  * ------------------------------------
  * @brief: Retrieve the front element in the queue, without deleting it
  */
-void* MID_peekQueue(void)
+const Srec_Record_t* MID_peekQueue(void)
 {
-    return Queue_peekQueue(&g_srecQueue);
+    return (const Srec_Record_t*)Queue_peekQueue(&g_srecQueue);
 }
 
 
@@ -98,36 +439,58 @@ void* MID_peekQueue(void)
  * ------------------------------------
  * @brief: Parse and validate an SREC record
  */
-Srec_Status_t MID_Parse_Record(const uint8_t *const p_LineSrec)
+Srec_Status_t MID_Parse_Record(const Srec_Record_t *const p_Record)
 {
     Srec_Status_t statusRecord = SREC_ERROR;
 
-    if (p_LineSrec != NULL)
+    if (NULL != p_Record)
     {
-        /* Start checking fields in the record */
-        statusRecord = SREC_checkSyntax(p_LineSrec);
-        if (statusRecord == SREC_OK)
+        /* The record has already been validated and decoded on reception */
+        statusRecord = p_Record->status;
+
+        if (SREC_OK == statusRecord)
         {
-            statusRecord = SREC_CheckRecordStart(p_LineSrec);
-            if (statusRecord == SREC_OK)
+            switch (p_Record->type)
             {
-                statusRecord = SREC_Checksum(p_LineSrec);
-                if (statusRecord == SREC_OK)
-                {
-                    statusRecord = SREC_CheckByteCount(p_LineSrec);
-                    if (statusRecord == SREC_OK)
+                case 0U:  /* Header: keep it as the metadata of the image */
+                    g_imageHeaderLength = (p_Record->length < MID_IMAGE_HEADER_MAX_LENGTH) ?
+                                          p_Record->length : MID_IMAGE_HEADER_MAX_LENGTH;
+                    (void)memcpy(g_imageHeader, p_Record->data, g_imageHeaderLength);
+                    break;
+
+                case 5U:  /* Count: every data record sent so far must have been programmed */
+                case 6U:
+                    if (p_Record->address != g_dataRecordCount)
+                    {
+                        statusRecord = SREC_ERROR_COUNT;
+                    }
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+                    break;
+
+                case 7U:  /* Start Address (Termination): entry point of the image */
+                case 8U:
+                case 9U:
+                    g_entryPoint = p_Record->address;
+                    if (PLANNER_OK != PLANNER_Flush(&g_planner))
                     {
-                    	statusRecord = SREC_CheckRecordType(p_LineSrec);
+                        statusRecord = SREC_ERROR;
                     }
-                }
-                else
-                {
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+                    break;
+
+                case MID_RECORD_BAUDRATE:  /* Command: switch to the requested baud rate */
+                    MID_changeBaudrate(p_Record->address);
+                    break;
+
+                default:
                     /* Do Nothing */
-                }
-            }
-            else
-            {
-                /* Do Nothing */
+                    break;
             }
         }
         else
@@ -149,50 +512,40 @@ Srec_Status_t MID_Parse_Record(const uint8_t *const p_LineSrec)
  * ------------------------------------
  * @brief: Write content of record into specific address in flash memory
  */
-void MID_Write_dataRecord(uint8_t *const p_LineSrec)
+uint8_t MID_Write_dataRecord(const Srec_Record_t *const p_Record)
 {
-    uint8_t  length      = 0U;
-    uint32_t address     = 0U;
-    uint8_t  index       = 0U;
-    uint8_t  numberWords = 0U;
-    uint8_t  tmpBuff[4U];
-
-    length  = SREC_lengthLineSrec(p_LineSrec);
-    address = calculateAddress(p_LineSrec);
+    uint8_t  retVal = 0U;
+#if (1U == MID_PROFILE)
+    uint32_t start  = SysTick->VAL;
+#endif
 
-    switch(p_LineSrec[1U])
+    switch (p_Record->type)
     {
-        case '1':
-            numberWords = (length - 12U) / 8U;
-            for (index = 0U; index < numberWords; ++index)
-            {
-                tempBuff(&p_LineSrec[8U + index * 8U], tmpBuff);
-                Program_LongWord(address + index * 4U, tmpBuff);
-            }
-            break;
-
-        case '2':
-            numberWords = (length - 14U) / 8U;
-            for (index = 0U; index < numberWords; ++index)
+        case 1U:
+        case 2U:
+        case 3U:
+            if (PLANNER_OK != PLANNER_Write(&g_planner, p_Record->address, p_Record->data, p_Record->length))
             {
-                tempBuff(&p_LineSrec[10U + index * 8U], tmpBuff);
-                Program_LongWord(address + index * 4U, tmpBuff);
+                retVal = 1U;
             }
-            break;
-
-        case '3':
-            numberWords = (length - 16U) / 8U;
-            for (index = 0U; index < numberWords; ++index)
+            else
             {
-                tempBuff(&p_LineSrec[12U + index * 8U], tmpBuff);
-                Program_LongWord(address + index * 4U, tmpBuff);
+                /* Do Nothing */
             }
+            g_dataRecordCount++;
+#if (1U == MID_PROFILE)
+            g_profile.writeCycles += (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+            g_profile.writeBytes  += p_Record->length;
+            g_profile.numWrites++;
+#endif
             break;
 
         default:
             /* Do Nothing */
             break;
     }
+
+    return retVal;
 }
 
 
@@ -207,14 +560,25 @@ void MID_SetDataTransferRate(const uint32_t baudrate)
 }
 
 
+/*
+ * @name:  MID_DetectDataTransferRate
+ * -----------------------------------
+ * @brief: Measure the baud rate of the host when MID_BAUDRATE_AUTO was set
+ */
+uint32_t MID_DetectDataTransferRate(void)
+{
+    return HAL_detectBaudrate();
+}
+
+
 /*
  * @name:  MID_InitUserApplicationSpace
  * ------------------------------------
- * @brief: Initializes the user application space by erasing a specified region of flash memory
+ * @brief: Initializes the user application space that the image is written into
  */
 uint8_t MID_InitUserApplicationSpace(const uint32_t startAddress, const uint32_t size)
 {
-    return HAL_eraseFlash(startAddress, size);
+    return (PLANNER_OK == PLANNER_Init(&g_planner, startAddress, size)) ? 0U : 1U;
 }
 
 
@@ -225,7 +589,7 @@ uint8_t MID_InitUserApplicationSpace(const uint32_t startAddress, const uint32_t
  */
 void MID_TransmitData(const uint8_t *const data, const uint32_t size)
 {
-    HAL_TransmitData(data, size);
+    (void)HAL_TransmitData(data, size);
 }
 
 
@@ -240,6 +604,28 @@ uint8_t MID_switchIsPressed(void)
 }
 
 
+/*
+ * @name:  MID_jumpRequested
+ * ----------------------------
+ * @brief: Checks if the host has asked to start the application
+ */
+uint8_t MID_jumpRequested(void)
+{
+    return HAL_jumpRequested();
+}
+
+
+/*
+ * @name:  MID_PollData
+ * ----------------------------
+ * @brief: Moves the characters received by a polled transport into the queue
+ */
+void MID_PollData(void)
+{
+    HAL_poll();
+}
+
+
 /*
  * @name:  MID_isQueueOverLoad
  * ----------------------------
@@ -254,9 +640,44 @@ uint8_t MID_isQueueOverLoad(void)
 /*
  * @brief: Jumps to the application code located at the specified address
  */
-void MID_jumpApplication(const uint32_t appAddress)
+void MID_jumpApplication(const uint32_t appAddress, const uint32_t entryPoint)
 {
-    HAL_jumpApplication(appAddress);
+    HAL_jumpApplication(appAddress, entryPoint);
+}
+
+
+/*
+ * @name:  MID_getEntryPoint
+ * ------------------------------------
+ * @brief: Get the start address given by the Termination record of the image
+ */
+uint32_t MID_getEntryPoint(void)
+{
+    return g_entryPoint;
+}
+
+
+/*
+ * @name:  MID_getImageHeader
+ * ------------------------------------
+ * @brief: Get the content of the header record of the image
+ */
+const uint8_t* MID_getImageHeader(uint8_t *const length)
+{
+    *length = g_imageHeaderLength;
+
+    return g_imageHeader;
+}
+
+
+/*
+ * @name:  MID_getProfile
+ * ------------------------------------
+ * @brief: Get the counters of the record path
+ */
+const MID_Profile_t* MID_getProfile(void)
+{
+    return &g_profile;
 }
 
 
@@ -273,60 +694,337 @@ void MID_restoreApplication(const uint32_t restoreAddress,
                             const uint32_t backupAddress,
                             const uint32_t appSize)
 {
+    /* The whole application space is erased, whichever sectors the failed image reached,
+     * so that every longword of the backup can be programmed back */
+    HAL_eraseFlash(restoreAddress, appSize);
     HAL_restoreApplication(restoreAddress, backupAddress, appSize);
-    HAL_jumpApplication(restoreAddress);
+    HAL_jumpApplication(restoreAddress, 0U);
 }
 
 
-static uint32_t calculateAddress(const uint8_t *const p_LineSrec)
+
+
+/*
+ * @brief: Pick the decoder of the image from its first character,
+ *         then hand the character over to it. Newlines and sync characters are skipped
+ */
+static Srec_Status_t MID_detectDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record)
 {
-    uint8_t  index  = 0U;
-    uint32_t retVal = 0U;
-    uint8_t  tmp    = 0U;
+    Srec_Status_t status = SREC_PENDING;
 
-    if (NULL != p_LineSrec)
+    if ('S' == character)
     {
-        switch (p_LineSrec[1U])
-        {
-            case '1':
-                tmp = 4U;
-                break;
-
-            case '2':
-                tmp = 6U;
-                break;
-
-            case '3':
-                tmp = 8U;
-                break;
-            default:
-                /* Do Nothing */
-                break;
-        }
+        p_Port->format = &s_srecFormat;
+        status         = p_Port->format->decodeChar(p_Port, character, record);
+    }
+    else if (':' == character)
+    {
+        p_Port->format = &s_ihexFormat;
+        status         = p_Port->format->decodeChar(p_Port, character, record);
+    }
+    else if (BIN_MAGIC == character)
+    {
+        p_Port->format = &s_binFormat;
+        status         = p_Port->format->decodeChar(p_Port, character, record);
+    }
+    else if (MID_BAUDRATE_COMMAND == character)
+    {
+        p_Port->format        = &s_commandFormat;
+        p_Port->commandValue  = 0U;
+        p_Port->commandDigits = 0U;
+    }
+    else if (('\r' != character) && ('\n' != character) && (MID_AUTOBAUD_SYNC != character))
+    {
+        status = SREC_ERROR_START;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
 
-        for (index = 0U; index < tmp; ++index)
-        {
-            /* Convert the character-form numbers to corresponding integer-form numbers */
-            retVal += ((p_LineSrec[index + 4U] >= 'A') ?
-                            (p_LineSrec[index + 4U] - 'A' + 10U) :
-                            (p_LineSrec[index + 4U] - '0')) << (4U * (tmp - index - 1U));
-        }
+    return status;
+}
+
+
+/*
+ * @brief: No record is being received until the format is known
+ */
+static uint8_t MID_detectIsIdle(const MID_Port_t *const p_Port)
+{
+    (void)p_Port;
+
+    return TRUE;
+}
+
+
+/*
+ * @brief: Feed one received character into the SREC decoder
+ */
+static Srec_Status_t MID_srecDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record)
+{
+    return SREC_DecodeChar(&p_Port->srecDecoder, character, record);
+}
+
+
+/*
+ * @brief: Check if the SREC decoder is between two records
+ */
+static uint8_t MID_srecIsIdle(const MID_Port_t *const p_Port)
+{
+    return SREC_DecoderIsIdle(&p_Port->srecDecoder);
+}
+
+
+/*
+ * @brief: Feed one received character into the Intel HEX decoder
+ */
+static Srec_Status_t MID_ihexDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record)
+{
+    return IHEX_DecodeChar(&p_Port->ihexDecoder, character, record);
+}
+
+
+/*
+ * @brief: Check if the Intel HEX decoder is between two records
+ */
+static uint8_t MID_ihexIsIdle(const MID_Port_t *const p_Port)
+{
+    return IHEX_DecoderIsIdle(&p_Port->ihexDecoder);
+}
+
+
+/*
+ * @brief: Feed one received byte into the binary image decoder
+ */
+static Srec_Status_t MID_binDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record)
+{
+    return BIN_DecodeChar(&p_Port->binDecoder, character, record);
+}
+
+
+/*
+ * @brief: Check if the binary image decoder is outside of an image
+ */
+static uint8_t MID_binIsIdle(const MID_Port_t *const p_Port)
+{
+    return BIN_DecoderIsIdle(&p_Port->binDecoder);
+}
+
+
+
+/*
+ * @brief: Feed one received character into the baud rate command.
+ *         The hexadecimal digits are accumulated until the newline, which completes
+ *         the command and goes back to detecting the format of the image
+ */
+static Srec_Status_t MID_commandDecodeChar(MID_Port_t *const p_Port, const uint8_t character, Srec_Record_t *const record)
+{
+    Srec_Status_t status = SREC_PENDING;
+    uint8_t       value  = g_srecHexTable[character];
+
+    if ((SREC_HEX_INVALID != value) && (p_Port->commandDigits < MID_BAUDRATE_DIGITS))
+    {
+        p_Port->commandValue = (p_Port->commandValue << 4U) | value;
+        p_Port->commandDigits++;
+    }
+    else if ((('\r' == character) || ('\n' == character)) && (0U != p_Port->commandDigits))
+    {
+        record->type    = MID_RECORD_BAUDRATE;
+        record->length  = 0U;
+        record->address = p_Port->commandValue;
+        status          = SREC_OK;
+        p_Port->format  = &s_detectFormat;
     }
     else
     {
-        retVal = 1U; /* Return an error status if the string to be converted is invalid */
+        status         = SREC_ERROR_SYNTAX;
+        p_Port->format = &s_detectFormat;
+    }
+
+    return status;
+}
+
+
+/*
+ * @brief: A command is being received
+ */
+static uint8_t MID_commandIsIdle(const MID_Port_t *const p_Port)
+{
+    (void)p_Port;
+
+    return FALSE;
+}
+
+
+/*
+ * @brief: Hand a record of the locked port, complete or broken, over to the main loop,
+ *         and pause the host while the record in flight still has room
+ */
+static int8_t MID_handOver(MID_Port_t *const p_Port, Srec_Record_t *const p_Record, const Srec_Status_t status)
+{
+    int8_t retVal = 0U;
+
+    p_Record->status = status;
+    MID_countRecord(p_Port, status, p_Record->type);
+    retVal = Queue_enQueue(&g_srecQueue);
+
+    if ((FALSE == g_flowPaused)
+            && (((QUEUE_MAX_SIZE - Queue_getCount(&g_srecQueue)) <= MID_XOFF_FREE_RECORDS)
+                || (Queue_getFreeBytes(&g_srecQueue) < MID_XOFF_FREE_BYTES)))
+    {
+        g_flowPaused = TRUE;
+        HAL_requestFlowControl(TRUE);
+    }
+    else
+    {
+        /* Do Nothing */
     }
 
     return retVal;
 }
 
 
-static void tempBuff(uint8_t *p_inBuff, uint8_t *p_outBuff)
+/*
+ * @brief: Make a port wait for the first record of an image, in any format
+ */
+static void MID_resetPort(MID_Port_t *const p_Port)
+{
+    SREC_DecoderInit(&p_Port->srecDecoder);
+    IHEX_DecoderInit(&p_Port->ihexDecoder);
+    BIN_DecoderInit(&p_Port->binDecoder);
+    p_Port->format      = &s_detectFormat;
+    p_Port->skipRecord  = FALSE;
+    p_Port->nakPending  = FALSE;
+    p_Port->recordIndex = 0U;
+}
+
+
+/*
+ * @brief: Drop the record being received on the locked port. The format of the image and
+ *         the Intel HEX base address and entry point are kept, a binary image or a command
+ *         has nothing to resume from and starts over
+ */
+static void MID_resyncPort(MID_Port_t *const p_Port)
+{
+    SREC_DecoderInit(&p_Port->srecDecoder);
+    IHEX_DecoderResync(&p_Port->ihexDecoder);
+    if ((&s_srecFormat != p_Port->format) && (&s_ihexFormat != p_Port->format))
+    {
+        BIN_DecoderInit(&p_Port->binDecoder);
+        p_Port->format = &s_detectFormat;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+    p_Port->skipRecord = FALSE;
+    p_Port->nakPending = FALSE;
+}
+
+
+/*
+ * @brief: Keep listening on the port that delivered the first valid record,
+ *         and move the record into the queue, still empty at this point
+ */
+static int8_t MID_lockPort(const uint8_t port, const Srec_Record_t *const p_Record)
 {
-    p_outBuff[0U] = SREC_convertStrToDec(&p_inBuff[0U]);
-    p_outBuff[1U] = SREC_convertStrToDec(&p_inBuff[2U]);
-    p_outBuff[2U] = SREC_convertStrToDec(&p_inBuff[4U]);
-    p_outBuff[3U] = SREC_convertStrToDec(&p_inBuff[6U]);
+    int8_t        retVal = 1U;
+    Srec_Record_t *p_Slot = Queue_getRearSlot(&g_srecQueue);
+
+    if (NULL != p_Slot)
+    {
+        p_Slot->status  = SREC_OK;
+        p_Slot->type    = p_Record->type;
+        p_Slot->length  = p_Record->length;
+        p_Slot->address = p_Record->address;
+        (void)memcpy(p_Slot->data, p_Record->data, p_Record->length);
+        retVal = Queue_enQueue(&g_srecQueue);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    MID_countRecord(&g_ports[port], SREC_OK, p_Record->type);
+    HAL_lockPort(port);
+
+    return retVal;
+}
+
+
+/*
+ * @brief: Count a record handed over by the decoder as a line of the image, unless it is a command
+ */
+static void MID_countRecord(MID_Port_t *const p_Port, const Srec_Status_t status, const uint8_t type)
+{
+    if ((SREC_OK != status) || (MID_RECORD_BAUDRATE != type))
+    {
+        p_Port->recordIndex++;
+    }
+    else
+    {
+        /* Do Nothing: the command is not part of the image */
+    }
+}
+
+
+/*
+ * @brief: Tell the host which record was dropped on the line, the next one to be received
+ */
+static void MID_sendNak(const MID_Port_t *const p_Port)
+{
+    uint8_t nak[5U];
+
+    nak[0U] = MID_NAK;
+    nak[1U] = (uint8_t)(p_Port->recordIndex >> 24U);
+    nak[2U] = (uint8_t)(p_Port->recordIndex >> 16U);
+    nak[3U] = (uint8_t)(p_Port->recordIndex >> 8U);
+    nak[4U] = (uint8_t)(p_Port->recordIndex);
+
+    /* Sent from the interrupt, a full transmit ring drops it rather than wait */
+    (void)HAL_TransmitDataAsync(nak, sizeof(nak));
+}
+
+
+/*
+ * @brief: Switch to the baud rate requested by the host, or stay at the current one
+ */
+static void MID_changeBaudrate(const uint32_t baudrate)
+{
+    const uint8_t ack      = MID_ACK;
+    const uint8_t nak      = MID_NAK;
+    uint32_t      previous = HAL_getBaudrate();
+
+    if (TRUE == HAL_isBaudrateSupported(baudrate))
+    {
+        (void)HAL_TransmitData(&ack, 1U);
+
+        g_baudConfirmed = FALSE;
+        g_baudSwitching = TRUE;
+        HAL_changeBaudrate(baudrate);
+
+        HAL_timeoutStart(MID_BAUDRATE_TIMEOUT);
+        while ((FALSE == g_baudConfirmed) && (FALSE == HAL_timeoutExpired()))
+        {
+            /* Wait for the sync of the host at the new rate */
+        }
+
+        if (FALSE == g_baudConfirmed)
+        {
+            HAL_changeBaudrate(previous);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+        g_baudSwitching = FALSE;
+
+        (void)HAL_TransmitData((TRUE == g_baudConfirmed) ? &ack : &nak, 1U);
+    }
+    else
+    {
+        (void)HAL_TransmitData(&nak, 1U);
+    }
 }
 
 /*******************************************************************************
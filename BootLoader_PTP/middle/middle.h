@@ -14,7 +14,53 @@
  ******************************************************************************/
 #include "Queue.h"
 #include "Srec.h"
-#include "hal.h"
+#include "Ihex.h"
+#include "Bin.h"
+#include "Planner.h"
+#include "hal_def.h"
+
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define MID_IMAGE_HEADER_MAX_LENGTH    64U  /* Number of bytes of the S0 record kept as image metadata */
+
+#define MID_BAUDRATE_AUTO              HAL_BAUDRATE_AUTO  /* Baud rate measured on the sync character sent by the host */
+#define MID_AUTOBAUD_SYNC              HAL_AUTOBAUD_SYNC  /* Sync character, ignored ahead of the image */
+
+/* Baud rate escalation: "B<baud rate in hexadecimal>\n" ahead of the image */
+#define MID_BAUDRATE_COMMAND           'B'  /* First character of the command */
+#define MID_BAUDRATE_DIGITS            8U   /* Most hexadecimal digits of the requested baud rate */
+#define MID_RECORD_BAUDRATE            'B'  /* Type of the record carrying the command, address is the baud rate */
+#define MID_BAUDRATE_TIMEOUT           100000U  /* Microseconds the host has to send MID_AUTOBAUD_SYNC at the new rate */
+#define MID_ACK                        0x06U
+#define MID_NAK                        0x15U  /* Followed by the index of the line to send again, see MID_ReceiveError */
+
+/* Receive watermarks of the flow control */
+#define MID_XOFF_FREE_RECORDS          2U   /* XOFF when no more records than this can still be queued, */
+#define MID_XOFF_FREE_BYTES            (2U * SREC_MAX_DATA_LENGTH)  /* or fewer data bytes than this are free */
+#define MID_XON_RECORDS                (QUEUE_MAX_SIZE / 4U)  /* XON when no more records than this are queued */
+#define MID_XON_FREE_BYTES             (QUEUE_DATA_SIZE - SREC_MAX_DATA_LENGTH)  /* and this many bytes are free */
+
+#ifndef MID_PROFILE
+#define MID_PROFILE                    0U   /* Set to 1U to count the core clock cycles spent in the record path */
+#endif
+
+/*******************************************************************************
+ * Typedef structs
+ ******************************************************************************/
+
+/*
+ * @brief: Counters of the record path, measured with SysTick on the core clock
+ */
+typedef struct
+{
+    uint32_t numBytes;        /* Characters fed into the decoder */
+    uint32_t numRecords;      /* Records handed over by the decoder, broken ones included */
+    uint32_t decodeCycles;    /* Cycles spent decoding the characters */
+    uint32_t numWrites;       /* Data records written into flash */
+    uint32_t writeBytes;      /* Data bytes written into flash */
+    uint32_t writeCycles;     /* Cycles spent writing the data records, flash commands included */
+} MID_Profile_t;
 
 /*******************************************************************************
  * APIs
@@ -43,21 +89,77 @@ void MID_DeInit(void);
 /*
  * @name: MID_PushData
  * ----------------------------
- * @brief:     Push data into the circular queue
- * @param[in]: The byte of data to be added to the circular queue
+ * @brief:     Decode a received byte straight into the free slot of the circular queue.
+ *             The record is enqueued as soon as its checksum byte is received.
+ *             The first character tells the format of the image: Motorola SREC ('S'),
+ *             Intel HEX (':') or raw binary (BIN_MAGIC), all are decoded into the same
+ *             binary record.
+ *             Until a port is locked, every port decodes into a record of its own, and the
+ *             first one to complete a valid record is locked onto and has the record queued.
+ *             Broken records are dropped meanwhile, and characters of the other ports after
+ *             the lock are ignored
+ * @param[in]: port: Index of the port the byte was received on
+ * @param[in]: data: The received byte of data
+ * @note:      The host is paused (XOFF or RTS) when the queue passes its high watermark
  * @return:    0 if the data is successfully pushed into the queue, 1 if the queue is full
  */
-int8_t MID_PushData(const uint8_t data);
+int8_t MID_PushData(const uint8_t port, const uint8_t data);
+
+
+/*
+ * @name: MID_PushBurst
+ * ----------------------------
+ * @brief:     Decode bytes received together, same as MID_PushData on each of them.
+ *             Once the port is locked onto an SREC image, the data fields are converted
+ *             by SREC_DecodeChars a run at a time, straight into the free slot of the queue
+ * @param[in]: port: Index of the port the bytes were received on
+ * @param[in]: data: Pointer to the received bytes
+ * @param[in]: count: Number of received bytes
+ * @return:    0 if every byte is successfully pushed into the queue, 1 if the queue got full
+ */
+int8_t MID_PushBurst(const uint8_t port, const uint8_t *const data, const uint32_t count);
+
+
+/*
+ * @name: MID_ReceiveError
+ * ----------------------------
+ * @brief:     Give up the record whose characters were lost (overrun) or dropped (framing or
+ *             parity error) on the line. The rest of the record is dropped, while the format
+ *             of the image and the Intel HEX base address and entry point are kept, and the host gets
+ *             MID_NAK followed by the index of the dropped record (4 bytes, big-endian), so
+ *             that it sends that record again. Records are the lines of the image, counted
+ *             from 0 at its first line: every SREC or Intel HEX line, the Intel HEX 02, 04 and
+ *             05 lines included. Baud rate commands are not counted.
+ *             After an error between two records, MID_NAK is only sent if the next record
+ *             turns out to have lost its start.
+ *             A binary image cannot be resynchronized: a record with SREC_ERROR_LINE is
+ *             queued instead. Errors before a port is locked, on other ports or during a
+ *             baud rate change only reset the decoding
+ * @param[in]: port: Index of the port the error happened on
+ * @return:    0 on success, 1 if the queue is full
+ */
+int8_t MID_ReceiveError(const uint8_t port);
 
 
 /*
  * @name: MID_Parse_Record
  * ----------------------------
- * @brief:  Parse and validate an SREC record
- * @param:  None
- * @return: SREC_OK if the SREC record is valid, an appropriate error status code otherwise
+ * @brief:     Get the result of validating a decoded SREC record and apply its meaning:
+ *             the S0 header is kept as image metadata, the S5/S6 record count is checked
+ *             against the number of data records programmed so far, and the S7/S8/S9
+ *             start address is kept as the entry point of the image, once the words still
+ *             partly written are programmed.
+ *             A baud rate command (MID_RECORD_BAUDRATE) is answered with MID_ACK at the
+ *             current rate, then the LPUART switches and waits up to MID_BAUDRATE_TIMEOUT
+ *             for MID_AUTOBAUD_SYNC at the new rate, answered with MID_ACK. Otherwise the
+ *             LPUART goes back to the previous rate and answers MID_NAK there. An unsupported
+ *             baud rate is answered with MID_NAK straight away
+ * @param[in]  p_Record: Pointer to the decoded record
+ * @return:    SREC_OK if the SREC record is valid, an appropriate error status code otherwise
+ * @note:      The host stops sending the sync characters before MID_BAUDRATE_TIMEOUT, then
+ *             goes back to the previous rate and waits for the answer
  */
-Srec_Status_t MID_Parse_Record(const uint8_t *const p_LineSrec);
+Srec_Status_t MID_Parse_Record(const Srec_Record_t *const p_Record);
 
 
 /*
@@ -73,7 +175,8 @@ uint8_t MID_QueueIsEmpty(void);
 /*
  * @name: MID_deQueue
  * ------------------------------------
- * @brief:  Remove a line from the circular queue
+ * @brief:  Remove a record from the circular queue, and let the host resume (XON or RTS) if it
+ *          has been paused and the queue is back under its low watermark
  * @param:  None
  * @return: None
  */
@@ -87,17 +190,20 @@ void MID_deQueue(void);
  * @param:  None
  * @return: A pointer to the front element of the queue, or NULL if the queue is empty
  */
-void* MID_peekQueue(void);
+const Srec_Record_t* MID_peekQueue(void);
 
 
 /*
  * @name: MID_Write_Record
  * ----------------------------
- * @brief: Write content of record into specific address in flash memory
- * @param[in] p_LineSrec: Pointer to the S-record line to be processed
- * @return:   None
+ * @brief: Write content of record into specific address in flash memory.
+ *         Records may come in any order and leave gaps: the sectors of the application
+ *         space are erased as they are first written, and no word is programmed twice
+ * @param[in] p_Record: Pointer to the decoded record to be processed
+ * @return:   0 for success, 1 if the record lies outside of the application space
+ *            or overlaps data that has already been written
  */
-void MID_Write_dataRecord(uint8_t *const p_LineSrec);
+uint8_t MID_Write_dataRecord(const Srec_Record_t *const p_Record);
 
 
 /*
@@ -110,6 +216,27 @@ void MID_Write_dataRecord(uint8_t *const p_LineSrec);
 uint8_t MID_switchIsPressed(void);
 
 
+/*
+ * @name: MID_jumpRequested
+ * ----------------------------
+ * @brief:  Checks if the host has asked to start the application, instead of the switch
+ * @param:  None
+ * @return: TRUE once the host has sent the jump command, FALSE otherwise
+ */
+uint8_t MID_jumpRequested(void);
+
+
+/*
+ * @name: MID_PollData
+ * ----------------------------
+ * @brief:  Moves the characters received by a polled transport into the queue
+ * @param:  None
+ * @return: None
+ * @note:   Nothing to do with the transports that push their characters from an interrupt
+ */
+void MID_PollData(void);
+
+
 /*
  * @name: MID_isQueueOverLoad
  * ----------------------------
@@ -128,6 +255,7 @@ uint8_t MID_isQueueOverLoad(void);
  * @param[in] data: Pointer to the data buffer to be transmitted
  * @param[in] size: Size of the data buffer to be transmitted
  * @return:   None
+ * @note:     The data is sent in the background by the transport, MID_DeInit waits for it
  */
 void MID_TransmitData(const uint8_t *const data, const uint32_t size);
 
@@ -136,18 +264,30 @@ void MID_TransmitData(const uint8_t *const data, const uint32_t size);
  * @name: MID_SetDataTransferRate
  * ----------------------------
  * @brief:    Set the baud rate for communication in the SREC parser
- * @param[in] baudrate: The baud rate to be set
+ * @param[in] baudrate: The baud rate to be set, MID_BAUDRATE_AUTO to measure it on the host's sync character
  * @return:   None
  */
 void MID_SetDataTransferRate(const uint32_t baudrate);
 
 
+/*
+ * @name: MID_DetectDataTransferRate
+ * ----------------------------
+ * @brief:  Measure the baud rate of the host when MID_BAUDRATE_AUTO was set.
+ *          The host sends MID_AUTOBAUD_SYNC, with a pause, until the bootloader answers at its rate.
+ *          Without a sync within HAL_AUTOBAUD_TIMEOUT, the bootloader stays at HAL_AUTOBAUD_DEFAULT
+ * @return: The baud rate in use
+ */
+uint32_t MID_DetectDataTransferRate(void);
+
+
 /*
  * @name:  MID_InitUserApplicationSpace
  * ------------------------------------
- * @brief: Initializes the user application space by erasing a specified region of flash memory
- * @param[in] startAddress: The starting address in flash memory where the erase operation will begin
- * @param[in] size: The number of sector to be erased
+ * @brief: Initializes the user application space that the image is written into.
+ *         Nothing is erased here, each sector is erased when the image first writes into it
+ * @param[in] startAddress: The starting address of the user application space
+ * @param[in] size: The number of sectors in the user application space
  * @return: 0 for success, non-zero for error
  */
 uint8_t MID_InitUserApplicationSpace(const uint32_t startAddress, const uint32_t size);
@@ -156,9 +296,31 @@ uint8_t MID_InitUserApplicationSpace(const uint32_t startAddress, const uint32_t
 /*
  * @brief: Jumps to the application code located at the specified address
  * @param[in] appAddress: The starting address of the application code
+ * @param[in] entryPoint: The address to branch to, 0 to use the reset vector of the application
  * @return:   None
  */
-void MID_jumpApplication(const uint32_t appAddress);
+void MID_jumpApplication(const uint32_t appAddress, const uint32_t entryPoint);
+
+
+/*
+ * @name:  MID_getEntryPoint
+ * ------------------------------------
+ * @brief:  Get the start address given by the Termination record (S7/S8/S9) of the image
+ * @param:  None
+ * @return: The start address, 0 if no Termination record has been processed
+ */
+uint32_t MID_getEntryPoint(void);
+
+
+/*
+ * @name:  MID_getImageHeader
+ * ------------------------------------
+ * @brief:      Get the content of the header record (S0) of the image
+ * @param[out]: length: Number of bytes in the header, 0 if no header record has been processed
+ * @note:       Only the first MID_IMAGE_HEADER_MAX_LENGTH bytes of the header are kept
+ * @return:     Pointer to the content of the header
+ */
+const uint8_t* MID_getImageHeader(uint8_t *const length);
 
 
 void MID_backupApplication(const uint32_t appAddress,
@@ -170,6 +332,27 @@ void MID_restoreApplication(const uint32_t restoreAddress,
                            const uint32_t backupAddress,
                            const uint32_t appSize);
 
+
+/*
+ * @name:  MID_getRxErrors
+ * ------------------------------------
+ * @brief:     Get the receive error counters of a port, to tune the baud rate
+ * @param[in]: port: Index of the port
+ * @return:    Pointer to the counters, NULL if the port does not exist
+ */
+const HAL_RxErrors_t* MID_getRxErrors(const uint8_t port);
+
+
+/*
+ * @name:  MID_getProfile
+ * ------------------------------------
+ * @brief:  Get the counters of the record path. Bytes or records per second are
+ *          numBytes * SystemCoreClock / decodeCycles and so on
+ * @param:  None
+ * @return: Pointer to the counters, all 0 unless MID_PROFILE is set to 1U
+ */
+const MID_Profile_t* MID_getProfile(void);
+
 #endif /* _INC_MIDDLE_H_ */
 /*******************************************************************************
  * EOF